@@ -0,0 +1,149 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 3.25
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "/root/repo/CMakeLists.txt"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXCompiler.cmake.in"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXCompilerABI.cpp"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCommonLanguageInclude.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCompilerIdDetection.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeDetermineCXXCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeDetermineCompileFeatures.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeDetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeDetermineCompilerABI.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeDetermineCompilerId.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeDetermineSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeFindBinUtils.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeGenericSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeInitializeConfigs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeLanguageInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeParseImplicitIncludeInfo.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeParseImplicitLinkInfo.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeParseLibraryArchitecture.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystem.cmake.in"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeTestCXXCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeTestCompilerCommon.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeUnixFindMake.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/ADSP-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/ARMCC-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/ARMClang-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/AppleClang-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/Borland-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/CMakeCommonCompilerMacros.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/Clang-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/Clang-DetermineCompilerInternal.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/Comeau-CXX-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/Compaq-CXX-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/Cray-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/Embarcadero-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/Fujitsu-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/FujitsuClang-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GHS-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-CXX-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-FindBinUtils.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/HP-CXX-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/IAR-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/IBMCPP-CXX-DetermineVersionInternal.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/IBMClang-CXX-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/Intel-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/IntelLLVM-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/LCC-CXX-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/MSVC-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/NVHPC-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/NVIDIA-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/OpenWatcom-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/PGI-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/PathScale-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/SCO-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/SunPro-CXX-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/TI-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/Tasking-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/VisualAge-CXX-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/Watcom-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/XL-CXX-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/XLClang-CXX-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/zOS-CXX-DetermineCompiler.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/FeatureTesting.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-Determine-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/UnixPaths.cmake"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "CMakeFiles/encrypt_core.dir/DependInfo.cmake"
+  "CMakeFiles/encrypt_tool.dir/DependInfo.cmake"
+  "CMakeFiles/run_test.dir/DependInfo.cmake"
+  "CMakeFiles/xor_bench.dir/DependInfo.cmake"
+  "CMakeFiles/cipher_bench.dir/DependInfo.cmake"
+  "CMakeFiles/crc_bench.dir/DependInfo.cmake"
+  "CMakeFiles/cache_bench.dir/DependInfo.cmake"
+  "CMakeFiles/async_bench_payload.dir/DependInfo.cmake"
+  "CMakeFiles/async_bench.dir/DependInfo.cmake"
+  "CMakeFiles/parallel_bench.dir/DependInfo.cmake"
+  "CMakeFiles/base_bench.dir/DependInfo.cmake"
+  "CMakeFiles/registry_bench_plugin_obj.dir/DependInfo.cmake"
+  "CMakeFiles/registry_bench_plugin.dir/DependInfo.cmake"
+  "CMakeFiles/registry_bench.dir/DependInfo.cmake"
+  "CMakeFiles/encrypt_audit.dir/DependInfo.cmake"
+  "CMakeFiles/audit_bench_plugin_obj.dir/DependInfo.cmake"
+  "CMakeFiles/audit_bench_plugin.dir/DependInfo.cmake"
+  "CMakeFiles/audit_bench_plugin_plain.dir/DependInfo.cmake"
+  "CMakeFiles/audit_bench.dir/DependInfo.cmake"
+  "CMakeFiles/decrypt_stress_payload.dir/DependInfo.cmake"
+  "CMakeFiles/decrypt_stress.dir/DependInfo.cmake"
+  "CMakeFiles/batch_bench.dir/DependInfo.cmake"
+  "CMakeFiles/io_bench_payload.dir/DependInfo.cmake"
+  "CMakeFiles/io_bench.dir/DependInfo.cmake"
+  "CMakeFiles/decrypt_bench_payload_4096.dir/DependInfo.cmake"
+  "CMakeFiles/decrypt_bench_image_4096.dir/DependInfo.cmake"
+  "CMakeFiles/decrypt_bench_payload_65536.dir/DependInfo.cmake"
+  "CMakeFiles/decrypt_bench_image_65536.dir/DependInfo.cmake"
+  "CMakeFiles/decrypt_bench_payload_1048576.dir/DependInfo.cmake"
+  "CMakeFiles/decrypt_bench_image_1048576.dir/DependInfo.cmake"
+  "CMakeFiles/decrypt_bench_payload_16777216.dir/DependInfo.cmake"
+  "CMakeFiles/decrypt_bench_image_16777216.dir/DependInfo.cmake"
+  "CMakeFiles/decrypt_bench_payload_268435456.dir/DependInfo.cmake"
+  "CMakeFiles/decrypt_bench_image_268435456.dir/DependInfo.cmake"
+  "CMakeFiles/decrypt_bench.dir/DependInfo.cmake"
+  "CMakeFiles/memfd_bench.dir/DependInfo.cmake"
+  "CMakeFiles/syscall_bench.dir/DependInfo.cmake"
+  "CMakeFiles/corpus_gen.dir/DependInfo.cmake"
+  "CMakeFiles/corpus_bench.dir/DependInfo.cmake"
+  "CMakeFiles/hugetext_bench_payload.dir/DependInfo.cmake"
+  "CMakeFiles/hugetext_bench_payload_enc.dir/DependInfo.cmake"
+  "CMakeFiles/hugetext_bench_image_default.dir/DependInfo.cmake"
+  "CMakeFiles/hugetext_bench_image_segment.dir/DependInfo.cmake"
+  "CMakeFiles/hugetext_bench.dir/DependInfo.cmake"
+  "CMakeFiles/sharedcache_bench_payload.dir/DependInfo.cmake"
+  "CMakeFiles/sharedcache_bench_image.dir/DependInfo.cmake"
+  "CMakeFiles/sharedcache_bench.dir/DependInfo.cmake"
+  )
@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/async_bench.dir/src/async_bench.cpp.o"
+  "CMakeFiles/async_bench.dir/src/async_bench.cpp.o.d"
+  "async_bench_payload_enc/async_bench_payload.o"
+  "bin/async_bench"
+  "bin/async_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/async_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
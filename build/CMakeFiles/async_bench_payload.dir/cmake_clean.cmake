@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/async_bench_payload.dir/src/async_bench_payload.cpp.o"
+  "CMakeFiles/async_bench_payload.dir/src/async_bench_payload.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/async_bench_payload.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/audit_bench.dir/src/audit_bench.cpp.o"
+  "CMakeFiles/audit_bench.dir/src/audit_bench.cpp.o.d"
+  "bin/audit_bench"
+  "bin/audit_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/audit_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
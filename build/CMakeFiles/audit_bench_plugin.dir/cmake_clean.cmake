@@ -0,0 +1,10 @@
+file(REMOVE_RECURSE
+  "audit_bench_plugin_obj_enc/audit_bench_plugin_obj.o"
+  "bin/libaudit_bench_plugin.pdb"
+  "bin/libaudit_bench_plugin.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang )
+  include(CMakeFiles/audit_bench_plugin.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/audit_bench_plugin_obj.dir/src/audit_bench_plugin.cpp.o"
+  "CMakeFiles/audit_bench_plugin_obj.dir/src/audit_bench_plugin.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/audit_bench_plugin_obj.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
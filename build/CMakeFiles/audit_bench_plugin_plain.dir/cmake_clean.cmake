@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "bin/libaudit_bench_plugin_plain.pdb"
+  "bin/libaudit_bench_plugin_plain.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/audit_bench_plugin_plain.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/base_bench.dir/src/base_bench.cpp.o"
+  "CMakeFiles/base_bench.dir/src/base_bench.cpp.o.d"
+  "CMakeFiles/base_bench.dir/src/image_locator.cpp.o"
+  "CMakeFiles/base_bench.dir/src/image_locator.cpp.o.d"
+  "bin/base_bench"
+  "bin/base_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/base_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/batch_bench.dir/src/batch_bench.cpp.o"
+  "CMakeFiles/batch_bench.dir/src/batch_bench.cpp.o.d"
+  "bin/batch_bench"
+  "bin/batch_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/batch_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/cache_bench.dir/src/cache_bench.cpp.o"
+  "CMakeFiles/cache_bench.dir/src/cache_bench.cpp.o.d"
+  "CMakeFiles/cache_bench.dir/src/cache_sync.cpp.o"
+  "CMakeFiles/cache_bench.dir/src/cache_sync.cpp.o.d"
+  "CMakeFiles/cache_bench.dir/src/xor_kernel.cpp.o"
+  "CMakeFiles/cache_bench.dir/src/xor_kernel.cpp.o.d"
+  "bin/cache_bench"
+  "bin/cache_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/cache_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/cipher_bench.dir/src/cipher_bench.cpp.o"
+  "CMakeFiles/cipher_bench.dir/src/cipher_bench.cpp.o.d"
+  "CMakeFiles/cipher_bench.dir/src/xor_kernel.cpp.o"
+  "CMakeFiles/cipher_bench.dir/src/xor_kernel.cpp.o.d"
+  "bin/cipher_bench"
+  "bin/cipher_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/cipher_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
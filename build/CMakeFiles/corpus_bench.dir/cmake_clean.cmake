@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/corpus_bench.dir/src/corpus_bench.cpp.o"
+  "CMakeFiles/corpus_bench.dir/src/corpus_bench.cpp.o.d"
+  "bin/corpus_bench"
+  "bin/corpus_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/corpus_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/crc_bench.dir/src/crc32c.cpp.o"
+  "CMakeFiles/crc_bench.dir/src/crc32c.cpp.o.d"
+  "CMakeFiles/crc_bench.dir/src/crc_bench.cpp.o"
+  "CMakeFiles/crc_bench.dir/src/crc_bench.cpp.o.d"
+  "CMakeFiles/crc_bench.dir/src/xor_kernel.cpp.o"
+  "CMakeFiles/crc_bench.dir/src/xor_kernel.cpp.o.d"
+  "bin/crc_bench"
+  "bin/crc_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/crc_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
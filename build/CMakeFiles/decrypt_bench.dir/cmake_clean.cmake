@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/decrypt_bench.dir/src/decrypt_bench.cpp.o"
+  "CMakeFiles/decrypt_bench.dir/src/decrypt_bench.cpp.o.d"
+  "bin/decrypt_bench"
+  "bin/decrypt_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/decrypt_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
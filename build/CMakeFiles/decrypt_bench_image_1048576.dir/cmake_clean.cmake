@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/decrypt_bench_image_1048576.dir/src/decrypt_bench_image.cpp.o"
+  "CMakeFiles/decrypt_bench_image_1048576.dir/src/decrypt_bench_image.cpp.o.d"
+  "bin/decrypt_bench_images/decrypt_bench_image_1048576"
+  "bin/decrypt_bench_images/decrypt_bench_image_1048576.pdb"
+  "decrypt_bench_payload_1048576_enc/decrypt_bench_payload_1048576.o"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/decrypt_bench_image_1048576.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
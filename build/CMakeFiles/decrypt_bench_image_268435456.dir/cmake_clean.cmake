@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/decrypt_bench_image_268435456.dir/src/decrypt_bench_image.cpp.o"
+  "CMakeFiles/decrypt_bench_image_268435456.dir/src/decrypt_bench_image.cpp.o.d"
+  "bin/decrypt_bench_images/decrypt_bench_image_268435456"
+  "bin/decrypt_bench_images/decrypt_bench_image_268435456.pdb"
+  "decrypt_bench_payload_268435456_enc/decrypt_bench_payload_268435456.o"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/decrypt_bench_image_268435456.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/decrypt_bench_image_65536.dir/src/decrypt_bench_image.cpp.o"
+  "CMakeFiles/decrypt_bench_image_65536.dir/src/decrypt_bench_image.cpp.o.d"
+  "bin/decrypt_bench_images/decrypt_bench_image_65536"
+  "bin/decrypt_bench_images/decrypt_bench_image_65536.pdb"
+  "decrypt_bench_payload_65536_enc/decrypt_bench_payload_65536.o"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/decrypt_bench_image_65536.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
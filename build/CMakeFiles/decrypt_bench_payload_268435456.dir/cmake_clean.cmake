@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/decrypt_bench_payload_268435456.dir/src/decrypt_bench_payload.cpp.o"
+  "CMakeFiles/decrypt_bench_payload_268435456.dir/src/decrypt_bench_payload.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/decrypt_bench_payload_268435456.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
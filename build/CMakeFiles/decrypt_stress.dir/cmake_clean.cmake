@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/decrypt_stress.dir/src/decrypt_stress.cpp.o"
+  "CMakeFiles/decrypt_stress.dir/src/decrypt_stress.cpp.o.d"
+  "bin/decrypt_stress"
+  "bin/decrypt_stress.pdb"
+  "decrypt_stress_payload_enc/decrypt_stress_payload.o"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/decrypt_stress.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
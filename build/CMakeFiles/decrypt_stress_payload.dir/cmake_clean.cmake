@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/decrypt_stress_payload.dir/src/decrypt_stress_payload.cpp.o"
+  "CMakeFiles/decrypt_stress_payload.dir/src/decrypt_stress_payload.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/decrypt_stress_payload.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
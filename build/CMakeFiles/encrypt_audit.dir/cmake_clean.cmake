@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/encrypt_audit.dir/src/encrypt_audit.cpp.o"
+  "CMakeFiles/encrypt_audit.dir/src/encrypt_audit.cpp.o.d"
+  "lib/libencrypt_audit.pdb"
+  "lib/libencrypt_audit.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/encrypt_audit.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
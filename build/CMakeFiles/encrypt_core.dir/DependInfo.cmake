@@ -0,0 +1,32 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/auto_decrypt.cpp" "CMakeFiles/encrypt_core.dir/src/auto_decrypt.cpp.o" "gcc" "CMakeFiles/encrypt_core.dir/src/auto_decrypt.cpp.o.d"
+  "/root/repo/src/cache_sync.cpp" "CMakeFiles/encrypt_core.dir/src/cache_sync.cpp.o" "gcc" "CMakeFiles/encrypt_core.dir/src/cache_sync.cpp.o.d"
+  "/root/repo/src/crc32c.cpp" "CMakeFiles/encrypt_core.dir/src/crc32c.cpp.o" "gcc" "CMakeFiles/encrypt_core.dir/src/crc32c.cpp.o.d"
+  "/root/repo/src/decrypt_registry.cpp" "CMakeFiles/encrypt_core.dir/src/decrypt_registry.cpp.o" "gcc" "CMakeFiles/encrypt_core.dir/src/decrypt_registry.cpp.o.d"
+  "/root/repo/src/decryptor_linux.cpp" "CMakeFiles/encrypt_core.dir/src/decryptor_linux.cpp.o" "gcc" "CMakeFiles/encrypt_core.dir/src/decryptor_linux.cpp.o.d"
+  "/root/repo/src/encrypt_table.cpp" "CMakeFiles/encrypt_core.dir/src/encrypt_table.cpp.o" "gcc" "CMakeFiles/encrypt_core.dir/src/encrypt_table.cpp.o.d"
+  "/root/repo/src/huge_text.cpp" "CMakeFiles/encrypt_core.dir/src/huge_text.cpp.o" "gcc" "CMakeFiles/encrypt_core.dir/src/huge_text.cpp.o.d"
+  "/root/repo/src/image_locator.cpp" "CMakeFiles/encrypt_core.dir/src/image_locator.cpp.o" "gcc" "CMakeFiles/encrypt_core.dir/src/image_locator.cpp.o.d"
+  "/root/repo/src/lazy_decrypt.cpp" "CMakeFiles/encrypt_core.dir/src/lazy_decrypt.cpp.o" "gcc" "CMakeFiles/encrypt_core.dir/src/lazy_decrypt.cpp.o.d"
+  "/root/repo/src/memfd_text.cpp" "CMakeFiles/encrypt_core.dir/src/memfd_text.cpp.o" "gcc" "CMakeFiles/encrypt_core.dir/src/memfd_text.cpp.o.d"
+  "/root/repo/src/parallel_decrypt.cpp" "CMakeFiles/encrypt_core.dir/src/parallel_decrypt.cpp.o" "gcc" "CMakeFiles/encrypt_core.dir/src/parallel_decrypt.cpp.o.d"
+  "/root/repo/src/shared_text_cache.cpp" "CMakeFiles/encrypt_core.dir/src/shared_text_cache.cpp.o" "gcc" "CMakeFiles/encrypt_core.dir/src/shared_text_cache.cpp.o.d"
+  "/root/repo/src/test_class.cpp" "CMakeFiles/encrypt_core.dir/src/test_class.cpp.o" "gcc" "CMakeFiles/encrypt_core.dir/src/test_class.cpp.o.d"
+  "/root/repo/src/xor_kernel.cpp" "CMakeFiles/encrypt_core.dir/src/xor_kernel.cpp.o" "gcc" "CMakeFiles/encrypt_core.dir/src/xor_kernel.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
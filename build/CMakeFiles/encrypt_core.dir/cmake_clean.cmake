@@ -0,0 +1,37 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/encrypt_core.dir/src/auto_decrypt.cpp.o"
+  "CMakeFiles/encrypt_core.dir/src/auto_decrypt.cpp.o.d"
+  "CMakeFiles/encrypt_core.dir/src/cache_sync.cpp.o"
+  "CMakeFiles/encrypt_core.dir/src/cache_sync.cpp.o.d"
+  "CMakeFiles/encrypt_core.dir/src/crc32c.cpp.o"
+  "CMakeFiles/encrypt_core.dir/src/crc32c.cpp.o.d"
+  "CMakeFiles/encrypt_core.dir/src/decrypt_registry.cpp.o"
+  "CMakeFiles/encrypt_core.dir/src/decrypt_registry.cpp.o.d"
+  "CMakeFiles/encrypt_core.dir/src/decryptor_linux.cpp.o"
+  "CMakeFiles/encrypt_core.dir/src/decryptor_linux.cpp.o.d"
+  "CMakeFiles/encrypt_core.dir/src/encrypt_table.cpp.o"
+  "CMakeFiles/encrypt_core.dir/src/encrypt_table.cpp.o.d"
+  "CMakeFiles/encrypt_core.dir/src/huge_text.cpp.o"
+  "CMakeFiles/encrypt_core.dir/src/huge_text.cpp.o.d"
+  "CMakeFiles/encrypt_core.dir/src/image_locator.cpp.o"
+  "CMakeFiles/encrypt_core.dir/src/image_locator.cpp.o.d"
+  "CMakeFiles/encrypt_core.dir/src/lazy_decrypt.cpp.o"
+  "CMakeFiles/encrypt_core.dir/src/lazy_decrypt.cpp.o.d"
+  "CMakeFiles/encrypt_core.dir/src/memfd_text.cpp.o"
+  "CMakeFiles/encrypt_core.dir/src/memfd_text.cpp.o.d"
+  "CMakeFiles/encrypt_core.dir/src/parallel_decrypt.cpp.o"
+  "CMakeFiles/encrypt_core.dir/src/parallel_decrypt.cpp.o.d"
+  "CMakeFiles/encrypt_core.dir/src/shared_text_cache.cpp.o"
+  "CMakeFiles/encrypt_core.dir/src/shared_text_cache.cpp.o.d"
+  "CMakeFiles/encrypt_core.dir/src/test_class.cpp.o"
+  "CMakeFiles/encrypt_core.dir/src/test_class.cpp.o.d"
+  "CMakeFiles/encrypt_core.dir/src/xor_kernel.cpp.o"
+  "CMakeFiles/encrypt_core.dir/src/xor_kernel.cpp.o.d"
+  "lib/libencrypt_core.a"
+  "lib/libencrypt_core.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/encrypt_core.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/encrypt_tool.dir/src/crc32c.cpp.o"
+  "CMakeFiles/encrypt_tool.dir/src/crc32c.cpp.o.d"
+  "CMakeFiles/encrypt_tool.dir/src/encrypt_linux.cpp.o"
+  "CMakeFiles/encrypt_tool.dir/src/encrypt_linux.cpp.o.d"
+  "CMakeFiles/encrypt_tool.dir/src/xor_kernel.cpp.o"
+  "CMakeFiles/encrypt_tool.dir/src/xor_kernel.cpp.o.d"
+  "bin/encrypt_tool"
+  "bin/encrypt_tool.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/encrypt_tool.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
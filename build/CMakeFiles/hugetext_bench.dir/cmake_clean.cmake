@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/hugetext_bench.dir/src/hugetext_bench.cpp.o"
+  "CMakeFiles/hugetext_bench.dir/src/hugetext_bench.cpp.o.d"
+  "bin/hugetext_bench"
+  "bin/hugetext_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/hugetext_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
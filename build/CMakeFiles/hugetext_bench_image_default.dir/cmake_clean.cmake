@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/hugetext_bench_image_default.dir/src/hugetext_bench_image.cpp.o"
+  "CMakeFiles/hugetext_bench_image_default.dir/src/hugetext_bench_image.cpp.o.d"
+  "bin/hugetext_bench_image_default"
+  "bin/hugetext_bench_image_default.pdb"
+  "hugetext_bench_payload_enc/hugetext_bench_payload.o"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/hugetext_bench_image_default.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/hugetext_bench_payload.dir/src/hugetext_bench_payload.cpp.o"
+  "CMakeFiles/hugetext_bench_payload.dir/src/hugetext_bench_payload.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/hugetext_bench_payload.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/hugetext_bench_payload_enc"
+  "hugetext_bench_payload_enc/hugetext_bench_payload.o"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang )
+  include(CMakeFiles/hugetext_bench_payload_enc.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/io_bench.dir/src/io_bench.cpp.o"
+  "CMakeFiles/io_bench.dir/src/io_bench.cpp.o.d"
+  "bin/io_bench"
+  "bin/io_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/io_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/memfd_bench.dir/src/memfd_bench.cpp.o"
+  "CMakeFiles/memfd_bench.dir/src/memfd_bench.cpp.o.d"
+  "bin/memfd_bench"
+  "bin/memfd_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/memfd_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
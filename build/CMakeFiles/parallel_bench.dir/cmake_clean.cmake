@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/parallel_bench.dir/src/parallel_bench.cpp.o"
+  "CMakeFiles/parallel_bench.dir/src/parallel_bench.cpp.o.d"
+  "CMakeFiles/parallel_bench.dir/src/parallel_decrypt.cpp.o"
+  "CMakeFiles/parallel_bench.dir/src/parallel_decrypt.cpp.o.d"
+  "CMakeFiles/parallel_bench.dir/src/xor_kernel.cpp.o"
+  "CMakeFiles/parallel_bench.dir/src/xor_kernel.cpp.o.d"
+  "bin/parallel_bench"
+  "bin/parallel_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/parallel_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
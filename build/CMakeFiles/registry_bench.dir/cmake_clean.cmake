@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/registry_bench.dir/src/registry_bench.cpp.o"
+  "CMakeFiles/registry_bench.dir/src/registry_bench.cpp.o.d"
+  "bin/registry_bench"
+  "bin/registry_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/registry_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
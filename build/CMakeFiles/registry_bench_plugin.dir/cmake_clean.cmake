@@ -0,0 +1,10 @@
+file(REMOVE_RECURSE
+  "bin/libregistry_bench_plugin.pdb"
+  "bin/libregistry_bench_plugin.so"
+  "registry_bench_plugin_obj_enc/registry_bench_plugin_obj.o"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang )
+  include(CMakeFiles/registry_bench_plugin.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
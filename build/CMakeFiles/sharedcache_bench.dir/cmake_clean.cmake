@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/sharedcache_bench.dir/src/sharedcache_bench.cpp.o"
+  "CMakeFiles/sharedcache_bench.dir/src/sharedcache_bench.cpp.o.d"
+  "bin/sharedcache_bench"
+  "bin/sharedcache_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/sharedcache_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
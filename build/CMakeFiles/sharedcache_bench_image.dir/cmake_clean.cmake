@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/sharedcache_bench_image.dir/src/sharedcache_bench_image.cpp.o"
+  "CMakeFiles/sharedcache_bench_image.dir/src/sharedcache_bench_image.cpp.o.d"
+  "bin/sharedcache_bench_image"
+  "bin/sharedcache_bench_image.pdb"
+  "sharedcache_bench_payload_enc/sharedcache_bench_payload.o"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/sharedcache_bench_image.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
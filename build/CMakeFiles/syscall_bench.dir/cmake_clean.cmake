@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/syscall_bench.dir/src/syscall_bench.cpp.o"
+  "CMakeFiles/syscall_bench.dir/src/syscall_bench.cpp.o.d"
+  "bin/syscall_bench"
+  "bin/syscall_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/syscall_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
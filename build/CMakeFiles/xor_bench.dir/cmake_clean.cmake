@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/xor_bench.dir/src/xor_bench.cpp.o"
+  "CMakeFiles/xor_bench.dir/src/xor_bench.cpp.o.d"
+  "CMakeFiles/xor_bench.dir/src/xor_kernel.cpp.o"
+  "CMakeFiles/xor_bench.dir/src/xor_kernel.cpp.o.d"
+  "bin/xor_bench"
+  "bin/xor_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/xor_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
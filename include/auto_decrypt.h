@@ -0,0 +1,34 @@
+#ifndef AUTO_DECRYPT_H
+#define AUTO_DECRYPT_H
+
+#include "image_locator.h"
+
+// ========== 装载时自动解密（供 LD_AUDIT 模块 la_objopen 调用） ==========
+// la_objopen 在对象映射完成后、重定位与构造函数执行之前回调，此时整段解密，
+// 构造函数所在代码也可以加密。未加密对象只检查程序头中的 PT_NOTE，开销与库大小无关。
+// 解密后在映射中的描述符头置 ENCRYPT_TABLE_FLAG_DECRYPTED，进程内的 Decryptor
+// 再调用 decrypt()/decryptFunction() 时视为已解密，不会重复异或。
+
+enum AutoDecryptResult {
+    AUTO_NOT_ENCRYPTED = 0,     // 没有加密描述符
+    AUTO_DECRYPTED,
+    AUTO_ALREADY_DECRYPTED,
+    AUTO_FAILED,                // mprotect 失败或描述符不可用，镜像保持加密
+    AUTO_BAD_CHECKSUM           // 明文 CRC32C 与描述符不符，已恢复为密文
+};
+
+class AutoDecrypt {
+public:
+    AutoDecrypt() = delete;
+    ~AutoDecrypt() = delete;
+    AutoDecrypt(const AutoDecrypt&) = delete;
+    AutoDecrypt& operator=(const AutoDecrypt&) = delete;
+
+    // 镜像是否带加密描述符（只遍历 PT_NOTE 的 note 头）
+    static bool hasMarker(const ImageInfo& image);
+    // 整段解密镜像、校验明文并标记描述符；不创建线程、不做 I/O，可在动态链接器回调中调用
+    static AutoDecryptResult decryptImage(const ImageInfo& image);
+    static const char* resultName(AutoDecryptResult result);
+};
+
+#endif // AUTO_DECRYPT_H
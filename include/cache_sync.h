@@ -0,0 +1,51 @@
+#ifndef CACHE_SYNC_H
+#define CACHE_SYNC_H
+
+#include <cstddef>
+#include <cstdint>
+
+// ========== 指令缓存同步策略（解密后让CPU取到新写入的代码） ==========
+enum CacheSyncKind {
+    CACHE_SYNC_AUTO = 0,        // 按架构选择默认策略
+    CACHE_SYNC_NONE,            // x86：数据/指令缓存硬件一致，仅编译器屏障
+    CACHE_SYNC_SERIALIZE,       // x86：执行一条串行化指令（serialize/cpuid）
+    CACHE_SYNC_CLFLUSH,         // x86：旧实现，逐行clflush（仅保留用于基准对比）
+    CACHE_SYNC_ARM64_DC_IC,     // aarch64：DC CVAU + IC IVAU + DSB/ISB
+    CACHE_SYNC_MEMBARRIER,      // 本线程同步 + membarrier(SYNC_CORE) 广播给已运行的其他线程
+    CACHE_SYNC_COUNT
+};
+
+// ========== 策略接口 ==========
+class CacheSyncStrategy {
+public:
+    virtual ~CacheSyncStrategy() = default;
+
+    virtual CacheSyncKind kind() const = 0;
+    virtual const char* name() const = 0;
+    // 当前CPU/内核是否支持该策略
+    virtual bool available() const { return true; }
+    // 对刚写入的 [start, start+len) 做指令可见性同步
+    virtual void sync(uint8_t* start, size_t len) = 0;
+};
+
+// ========== 策略注册表 ==========
+class CacheSync {
+public:
+    CacheSync() = delete;
+    ~CacheSync() = delete;
+    CacheSync(const CacheSync&) = delete;
+    CacheSync& operator=(const CacheSync&) = delete;
+
+    static CacheSyncStrategy& get(CacheSyncKind kind);
+    static CacheSyncStrategy& current();
+    // 选择全局策略；不可用时保持原策略并返回false
+    static bool select(CacheSyncKind kind);
+    static CacheSyncKind defaultKind();
+
+    static inline void sync(uint8_t* start, size_t len) {
+        if (!start || len == 0) return;
+        current().sync(start, len);
+    }
+};
+
+#endif // CACHE_SYNC_H
@@ -0,0 +1,387 @@
+#ifndef CIPHER_H
+#define CIPHER_H
+
+#include <cstddef>
+#include <cstdint>
+#include "encrypt_format.h"
+#include "xor_kernel.h"
+#if defined(__x86_64__)
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+// ========== 共用密钥（encrypt_tool / Decryptor / QNX 版本的唯一定义处，改密钥只改这里） ==========
+namespace cipher_keys {
+
+inline constexpr uint8_t XOR_KEY[8] = {0x12, 0x34, 0x56, 0x78, 0x90, 0xAB, 0xCD, 0xEF};
+
+// QNX 版本历史上使用的16字节异或密钥（已加密的 QNX 目标文件依赖它，不能与 Linux 合并）
+inline constexpr uint8_t QNX_XOR_KEY[16] = {
+    0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0xFE, 0xDC, 0xBA, 0x98, 0x76, 0x54, 0x32, 0x10};
+
+// AES-128 取前16字节，AES-256 用全部32字节
+inline constexpr uint8_t AES_KEY[32] = {
+    0x3a, 0x91, 0x5c, 0xe7, 0x08, 0x6d, 0xb2, 0x4f, 0xc5, 0x17, 0x9e, 0x63, 0xd0, 0x2b, 0x74, 0xa8,
+    0x5f, 0xe2, 0x39, 0x86, 0x1c, 0xcb, 0x70, 0x0d, 0x94, 0x4a, 0xf3, 0x28, 0xb7, 0x61, 0xde, 0x05};
+
+} // namespace cipher_keys
+
+// ========== AES-CTR 实现等级（运行时cpuid选择） ==========
+enum AesIsa {
+    AES_ISA_PORTABLE = 0,       // 查表 S 盒 + xtime，任意平台可用
+    AES_ISA_AESNI    = 1,       // AES-NI，每次迭代流水8个分组
+    AES_ISA_COUNT
+};
+
+#define AES_BLOCK_SIZE 16
+
+namespace cipher_detail {
+
+inline constexpr uint8_t AES_SBOX[256] = {
+    0x63, 0x7c, 0x77, 0x7b, 0xf2, 0x6b, 0x6f, 0xc5, 0x30, 0x01, 0x67, 0x2b, 0xfe, 0xd7, 0xab, 0x76,
+    0xca, 0x82, 0xc9, 0x7d, 0xfa, 0x59, 0x47, 0xf0, 0xad, 0xd4, 0xa2, 0xaf, 0x9c, 0xa4, 0x72, 0xc0,
+    0xb7, 0xfd, 0x93, 0x26, 0x36, 0x3f, 0xf7, 0xcc, 0x34, 0xa5, 0xe5, 0xf1, 0x71, 0xd8, 0x31, 0x15,
+    0x04, 0xc7, 0x23, 0xc3, 0x18, 0x96, 0x05, 0x9a, 0x07, 0x12, 0x80, 0xe2, 0xeb, 0x27, 0xb2, 0x75,
+    0x09, 0x83, 0x2c, 0x1a, 0x1b, 0x6e, 0x5a, 0xa0, 0x52, 0x3b, 0xd6, 0xb3, 0x29, 0xe3, 0x2f, 0x84,
+    0x53, 0xd1, 0x00, 0xed, 0x20, 0xfc, 0xb1, 0x5b, 0x6a, 0xcb, 0xbe, 0x39, 0x4a, 0x4c, 0x58, 0xcf,
+    0xd0, 0xef, 0xaa, 0xfb, 0x43, 0x4d, 0x33, 0x85, 0x45, 0xf9, 0x02, 0x7f, 0x50, 0x3c, 0x9f, 0xa8,
+    0x51, 0xa3, 0x40, 0x8f, 0x92, 0x9d, 0x38, 0xf5, 0xbc, 0xb6, 0xda, 0x21, 0x10, 0xff, 0xf3, 0xd2,
+    0xcd, 0x0c, 0x13, 0xec, 0x5f, 0x97, 0x44, 0x17, 0xc4, 0xa7, 0x7e, 0x3d, 0x64, 0x5d, 0x19, 0x73,
+    0x60, 0x81, 0x4f, 0xdc, 0x22, 0x2a, 0x90, 0x88, 0x46, 0xee, 0xb8, 0x14, 0xde, 0x5e, 0x0b, 0xdb,
+    0xe0, 0x32, 0x3a, 0x0a, 0x49, 0x06, 0x24, 0x5c, 0xc2, 0xd3, 0xac, 0x62, 0x91, 0x95, 0xe4, 0x79,
+    0xe7, 0xc8, 0x37, 0x6d, 0x8d, 0xd5, 0x4e, 0xa9, 0x6c, 0x56, 0xf4, 0xea, 0x65, 0x7a, 0xae, 0x08,
+    0xba, 0x78, 0x25, 0x2e, 0x1c, 0xa6, 0xb4, 0xc6, 0xe8, 0xdd, 0x74, 0x1f, 0x4b, 0xbd, 0x8b, 0x8a,
+    0x70, 0x3e, 0xb5, 0x66, 0x48, 0x03, 0xf6, 0x0e, 0x61, 0x35, 0x57, 0xb9, 0x86, 0xc1, 0x1d, 0x9e,
+    0xe1, 0xf8, 0x98, 0x11, 0x69, 0xd9, 0x8e, 0x94, 0x9b, 0x1e, 0x87, 0xe9, 0xce, 0x55, 0x28, 0xdf,
+    0x8c, 0xa1, 0x89, 0x0d, 0xbf, 0xe6, 0x42, 0x68, 0x41, 0x99, 0x2d, 0x0f, 0xb0, 0x54, 0xbb, 0x16,
+};
+
+constexpr uint8_t xtime(uint8_t x)
+{
+    return (uint8_t)((x << 1) ^ ((x >> 7) * 0x1b));
+}
+
+// 计数器分组：nonce（小端8字节）|| 分组序号（大端8字节）
+inline void aes_counter(uint8_t out[AES_BLOCK_SIZE], uint64_t nonce, uint64_t block)
+{
+    for (int i = 0; i < 8; i++) {
+        out[i] = (uint8_t)(nonce >> (8 * i));
+        out[15 - i] = (uint8_t)(block >> (8 * i));
+    }
+}
+
+template <int Rounds>
+inline void aes_encrypt_block(const uint8_t (&rk)[Rounds + 1][AES_BLOCK_SIZE],
+                              const uint8_t in[AES_BLOCK_SIZE], uint8_t out[AES_BLOCK_SIZE])
+{
+    uint8_t s[AES_BLOCK_SIZE];
+    for (int i = 0; i < AES_BLOCK_SIZE; i++) s[i] = in[i] ^ rk[0][i];
+
+    for (int round = 1; round <= Rounds; round++) {
+        // SubBytes + ShiftRows（状态按列存放：s[row + 4 * col]）
+        uint8_t t[AES_BLOCK_SIZE];
+        for (int c = 0; c < 4; c++) {
+            for (int r = 0; r < 4; r++) {
+                t[r + 4 * c] = AES_SBOX[s[r + 4 * ((c + r) & 3)]];
+            }
+        }
+        // MixColumns（最后一轮没有）
+        if (round != Rounds) {
+            for (int c = 0; c < 4; c++) {
+                uint8_t* col = t + 4 * c;
+                const uint8_t a0 = col[0], a1 = col[1], a2 = col[2], a3 = col[3];
+                const uint8_t all = a0 ^ a1 ^ a2 ^ a3;
+                col[0] ^= all ^ xtime(a0 ^ a1);
+                col[1] ^= all ^ xtime(a1 ^ a2);
+                col[2] ^= all ^ xtime(a2 ^ a3);
+                col[3] ^= all ^ xtime(a3 ^ a0);
+            }
+        }
+        for (int i = 0; i < AES_BLOCK_SIZE; i++) s[i] = t[i] ^ rk[round][i];
+    }
+    for (int i = 0; i < AES_BLOCK_SIZE; i++) out[i] = s[i];
+}
+
+template <int Rounds>
+inline void aes_ctr_portable(const uint8_t (&rk)[Rounds + 1][AES_BLOCK_SIZE],
+                             uint8_t* data, size_t len, uint64_t nonce, uint64_t offset)
+{
+    uint64_t block = offset / AES_BLOCK_SIZE;
+    size_t skip = offset % AES_BLOCK_SIZE;
+    uint8_t ctr[AES_BLOCK_SIZE], ks[AES_BLOCK_SIZE];
+    while (len > 0) {
+        aes_counter(ctr, nonce, block++);
+        aes_encrypt_block<Rounds>(rk, ctr, ks);
+        const size_t n = (AES_BLOCK_SIZE - skip < len) ? AES_BLOCK_SIZE - skip : len;
+        for (size_t i = 0; i < n; i++) data[i] ^= ks[skip + i];
+        data += n;
+        len -= n;
+        skip = 0;
+    }
+}
+
+#if defined(__x86_64__)
+__attribute__((target("aes,sse2")))
+inline __m128i aesni_counter(uint64_t nonce, uint64_t block)
+{
+    return _mm_set_epi64x((long long)__builtin_bswap64(block), (long long)nonce);
+}
+
+template <int Rounds>
+__attribute__((target("aes,sse2")))
+inline __m128i aesni_encrypt(const __m128i* rk, __m128i x)
+{
+    x = _mm_xor_si128(x, rk[0]);
+#pragma GCC unroll 16
+    for (int r = 1; r < Rounds; r++) x = _mm_aesenc_si128(x, rk[r]);
+    return _mm_aesenclast_si128(x, rk[Rounds]);
+}
+
+// 8个分组一组：各分组的轮运算互不依赖，交错发射以填满 AESENC 流水线；轮数为编译期常量，轮循环完全展开
+template <int Rounds>
+__attribute__((target("aes,sse2")))
+inline void aes_ctr_aesni(const uint8_t (&round_keys)[Rounds + 1][AES_BLOCK_SIZE],
+                          uint8_t* data, size_t len, uint64_t nonce, uint64_t offset)
+{
+    __m128i rk[Rounds + 1];
+    for (int r = 0; r <= Rounds; r++) rk[r] = _mm_loadu_si128((const __m128i*)round_keys[r]);
+
+    uint64_t block = offset / AES_BLOCK_SIZE;
+    const size_t skip = offset % AES_BLOCK_SIZE;
+    alignas(16) uint8_t ks[AES_BLOCK_SIZE];
+
+    // 非分组对齐的头部
+    if (skip) {
+        _mm_store_si128((__m128i*)ks, aesni_encrypt<Rounds>(rk, aesni_counter(nonce, block++)));
+        const size_t n = (AES_BLOCK_SIZE - skip < len) ? AES_BLOCK_SIZE - skip : len;
+        for (size_t i = 0; i < n; i++) data[i] ^= ks[skip + i];
+        data += n;
+        len -= n;
+    }
+
+    while (len >= 8 * AES_BLOCK_SIZE) {
+        __m128i x[8];
+        for (int i = 0; i < 8; i++) x[i] = _mm_xor_si128(aesni_counter(nonce, block + i), rk[0]);
+#pragma GCC unroll 16
+        for (int r = 1; r < Rounds; r++) {
+            for (int i = 0; i < 8; i++) x[i] = _mm_aesenc_si128(x[i], rk[r]);
+        }
+        for (int i = 0; i < 8; i++) {
+            x[i] = _mm_aesenclast_si128(x[i], rk[Rounds]);
+            __m128i* p = (__m128i*)(data + i * AES_BLOCK_SIZE);
+            _mm_storeu_si128(p, _mm_xor_si128(_mm_loadu_si128(p), x[i]));
+        }
+        block += 8;
+        data += 8 * AES_BLOCK_SIZE;
+        len -= 8 * AES_BLOCK_SIZE;
+    }
+
+    while (len >= AES_BLOCK_SIZE) {
+        __m128i* p = (__m128i*)data;
+        _mm_storeu_si128(p, _mm_xor_si128(_mm_loadu_si128(p), aesni_encrypt<Rounds>(rk, aesni_counter(nonce, block++))));
+        data += AES_BLOCK_SIZE;
+        len -= AES_BLOCK_SIZE;
+    }
+
+    if (len) {
+        _mm_store_si128((__m128i*)ks, aesni_encrypt<Rounds>(rk, aesni_counter(nonce, block)));
+        for (size_t i = 0; i < len; i++) data[i] ^= ks[i];
+    }
+}
+#endif
+
+inline AesIsa aes_detect_isa()
+{
+#if defined(__x86_64__)
+    unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+    if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) && (ecx & bit_AES)) {
+        return AES_ISA_AESNI;
+    }
+#endif
+    return AES_ISA_PORTABLE;
+}
+
+} // namespace cipher_detail
+
+// ========== 算法策略 ==========
+// 每个策略提供：Schedule<KeyLen>（constexpr 密钥编排）、expand、apply（默认实现）、applyWith（指定实现）
+// 及实现等级的查询。密钥流一律按段内偏移寻址，任意函数/页可单独解密，加密与解密是同一操作。
+
+// 循环异或：data[i] ^= key[(offset + i) % KeyLen]，nonce 不使用
+// 非 x86（QNX aarch64）上只用头文件内的 applyScalar<KeyLen>，整个 Cipher 不依赖任何 .cpp；
+// x86 上长区间仍分发到 xor_kernel.cpp：SSE2/AVX2/AVX-512 内核带 target 属性、按 cpuid 选一份，
+// 且分发指针须是信号处理函数里可安全读取的原子量（惰性解密），放在头文件里每个翻译单元都会各复制一份
+struct XorPolicy {
+    typedef XorIsa Isa;
+    static const int ISA_COUNT = XOR_ISA_COUNT;
+
+    template <size_t KeyLen>
+    struct Schedule {
+        uint8_t key[KeyLen];
+    };
+
+    template <size_t KeyLen>
+    static constexpr uint8_t cipherId() { return ENCRYPT_CIPHER_XOR; }
+
+    template <size_t KeyLen>
+    static constexpr Schedule<KeyLen> expand(const uint8_t* key) {
+        Schedule<KeyLen> s{};
+        for (size_t i = 0; i < KeyLen; i++) s.key[i] = key[i];
+        return s;
+    }
+
+    // 短区间（重定位空洞之间的碎片）走按 KeyLen 特化的内联循环，长区间走 SIMD 内核
+    template <size_t KeyLen>
+    static inline void apply(const Schedule<KeyLen>& s, uint8_t* data, size_t len, uint64_t, uint64_t offset) {
+#if defined(__x86_64__)
+        XorKernel::apply<KeyLen>(data, len, s.key, offset);
+#else
+        XorKernel::applyScalar<KeyLen>(data, len, s.key, offset);
+#endif
+    }
+
+#if defined(__x86_64__)
+    template <size_t KeyLen>
+    static bool applyWith(Isa isa, const Schedule<KeyLen>& s, uint8_t* data, size_t len, uint64_t, uint64_t offset) {
+        return XorKernel::applyWith(isa, data, len, s.key, KeyLen, offset);
+    }
+    static Isa activeIsa() { return XorKernel::activeIsa(); }
+    static bool isaSupported(Isa isa) { return XorKernel::isaSupported(isa); }
+    static const char* isaName(Isa isa) { return XorKernel::isaName(isa); }
+#endif
+};
+
+// AES-CTR：计数器分组 = nonce（8字节，小端）|| 分组序号（8字节，大端），分组序号 = 偏移 / 16；
+// KeyLen 为 16（AES-128）或 32（AES-256）
+struct AesCtrPolicy {
+    typedef AesIsa Isa;
+    static const int ISA_COUNT = AES_ISA_COUNT;
+
+    template <size_t KeyLen>
+    struct Schedule {
+        static_assert(KeyLen == 16 || KeyLen == 32, "AES-CTR key must be 16 or 32 bytes");
+        static constexpr int ROUNDS = (int)KeyLen / 4 + 6;
+        alignas(16) uint8_t rk[ROUNDS + 1][AES_BLOCK_SIZE];
+    };
+
+    template <size_t KeyLen>
+    static constexpr uint8_t cipherId() {
+        return KeyLen == 16 ? ENCRYPT_CIPHER_AES128_CTR : ENCRYPT_CIPHER_AES256_CTR;
+    }
+
+    // FIPS-197 密钥扩展（以4字节字为单位）；常量密钥在编译期完成，AES-NI 与可移植实现共用
+    template <size_t KeyLen>
+    static constexpr Schedule<KeyLen> expand(const uint8_t* key) {
+        constexpr int nk = (int)KeyLen / 4;
+        constexpr int words = 4 * (Schedule<KeyLen>::ROUNDS + 1);
+        Schedule<KeyLen> s{};
+        uint8_t w[words * 4] = {};
+        for (size_t i = 0; i < KeyLen; i++) w[i] = key[i];
+        uint8_t rcon = 0x01;
+        for (int i = nk; i < words; i++) {
+            uint8_t t[4] = {w[4 * i - 4], w[4 * i - 3], w[4 * i - 2], w[4 * i - 1]};
+            if (i % nk == 0) {
+                const uint8_t first = t[0];
+                t[0] = cipher_detail::AES_SBOX[t[1]] ^ rcon;
+                t[1] = cipher_detail::AES_SBOX[t[2]];
+                t[2] = cipher_detail::AES_SBOX[t[3]];
+                t[3] = cipher_detail::AES_SBOX[first];
+                rcon = cipher_detail::xtime(rcon);
+            } else if (nk > 6 && i % nk == 4) {
+                for (int j = 0; j < 4; j++) t[j] = cipher_detail::AES_SBOX[t[j]];
+            }
+            for (int j = 0; j < 4; j++) w[4 * i + j] = w[4 * (i - nk) + j] ^ t[j];
+        }
+        for (int i = 0; i < words * 4; i++) s.rk[i / AES_BLOCK_SIZE][i % AES_BLOCK_SIZE] = w[i];
+        return s;
+    }
+
+    template <size_t KeyLen>
+    static inline void apply(const Schedule<KeyLen>& s, uint8_t* data, size_t len, uint64_t nonce, uint64_t offset) {
+        constexpr int rounds = Schedule<KeyLen>::ROUNDS;
+#if defined(__x86_64__)
+        if (activeIsa() == AES_ISA_AESNI) {
+            cipher_detail::aes_ctr_aesni<rounds>(s.rk, data, len, nonce, offset);
+            return;
+        }
+#endif
+        cipher_detail::aes_ctr_portable<rounds>(s.rk, data, len, nonce, offset);
+    }
+
+    template <size_t KeyLen>
+    static bool applyWith(Isa isa, const Schedule<KeyLen>& s, uint8_t* data, size_t len, uint64_t nonce, uint64_t offset) {
+        constexpr int rounds = Schedule<KeyLen>::ROUNDS;
+        if (!isaSupported(isa)) return false;
+#if defined(__x86_64__)
+        if (isa == AES_ISA_AESNI) {
+            cipher_detail::aes_ctr_aesni<rounds>(s.rk, data, len, nonce, offset);
+            return true;
+        }
+#endif
+        cipher_detail::aes_ctr_portable<rounds>(s.rk, data, len, nonce, offset);
+        return true;
+    }
+
+    // 单分组加密（FIPS-197 已知答案测试用）
+    template <size_t KeyLen>
+    static void encryptBlock(const Schedule<KeyLen>& s, const uint8_t in[AES_BLOCK_SIZE], uint8_t out[AES_BLOCK_SIZE]) {
+        cipher_detail::aes_encrypt_block<Schedule<KeyLen>::ROUNDS>(s.rk, in, out);
+    }
+
+    // 首次调用时用cpuid选择；信号处理函数中使用前须先在普通上下文调用一次
+    static AesIsa activeIsa() {
+        static const AesIsa isa = cipher_detail::aes_detect_isa();
+        return isa;
+    }
+    static bool isaSupported(Isa isa) { return isa >= AES_ISA_PORTABLE && isa <= activeIsa(); }
+    static const char* isaName(Isa isa) {
+        switch (isa) {
+            case AES_ISA_PORTABLE: return "portable";
+            case AES_ISA_AESNI:    return "aes-ni";
+            default:               return "unknown";
+        }
+    }
+};
+
+// ========== 加密/解密共用的算法模板 ==========
+// 算法与密钥长度在编译期确定：热循环按 Policy/KeyLen 完全特化并内联，不经过按算法的运行时分支。
+// 密钥编排在构造时完成（constexpr，常量密钥的实例放在只读段中，无运行时初始化）；
+// apply 只读成员，可在多线程及信号处理函数中并发调用
+template <class Policy, size_t KeyLen>
+class Cipher {
+public:
+    typedef typename Policy::template Schedule<KeyLen> Schedule;
+    static constexpr size_t KEY_LEN = KeyLen;
+    static constexpr uint8_t CIPHER_ID = Policy::template cipherId<KeyLen>();
+
+    constexpr explicit Cipher(const uint8_t* key) : m_schedule(Policy::template expand<KeyLen>(key)) {}
+
+    // data[i] ^= keystream[offset + i]；nonce 仅 AES-CTR 使用
+    inline void apply(uint8_t* data, size_t len, uint64_t nonce = 0, uint64_t offset = 0) const {
+        if (!data || len == 0) return;
+        Policy::template apply<KeyLen>(m_schedule, data, len, nonce, offset);
+    }
+
+    // 指定实现执行（基准测试/交叉校验用，不支持的实现返回false）
+    bool applyWith(typename Policy::Isa isa, uint8_t* data, size_t len, uint64_t nonce = 0, uint64_t offset = 0) const {
+        return Policy::template applyWith<KeyLen>(isa, m_schedule, data, len, nonce, offset);
+    }
+
+    constexpr const Schedule& schedule() const { return m_schedule; }
+
+private:
+    Schedule m_schedule;
+};
+
+typedef Cipher<XorPolicy, sizeof(cipher_keys::XOR_KEY)> XorCipher;
+typedef Cipher<XorPolicy, sizeof(cipher_keys::QNX_XOR_KEY)> QnxXorCipher;
+typedef Cipher<AesCtrPolicy, 16> Aes128CtrCipher;
+typedef Cipher<AesCtrPolicy, 32> Aes256CtrCipher;
+
+// 常量密钥实例：轮密钥在编译期展开
+inline constexpr XorCipher XOR_CIPHER(cipher_keys::XOR_KEY);
+inline constexpr QnxXorCipher QNX_XOR_CIPHER(cipher_keys::QNX_XOR_KEY);
+inline constexpr Aes128CtrCipher AES128_CIPHER(cipher_keys::AES_KEY);
+inline constexpr Aes256CtrCipher AES256_CIPHER(cipher_keys::AES_KEY);
+
+#endif // CIPHER_H
@@ -0,0 +1,24 @@
+#ifndef CRC32C_H
+#define CRC32C_H
+
+#include <cstddef>
+#include <cstdint>
+
+// ========== CRC32C（Castagnoli 多项式，反射形式 0x82F63B78） ==========
+// 首次调用时用 cpuid 选择：支持 SSE4.2 时用 crc32 指令（每次 8 字节），否则查表。
+// crc 为上一段的返回值，首段传 0；分段计算与一次算完结果相同。
+// combine() 由相邻两段各自的 CRC 得到拼接后的 CRC（GF(2) 上乘 x^(8*len2)，O(log len2)），
+// 供多线程分块计算后按顺序合并
+class Crc32c {
+public:
+    Crc32c() = delete;
+    ~Crc32c() = delete;
+    Crc32c(const Crc32c&) = delete;
+    Crc32c& operator=(const Crc32c&) = delete;
+
+    static uint32_t update(uint32_t crc, const void* data, size_t len);
+    static uint32_t combine(uint32_t crc1, uint32_t crc2, size_t len2);
+    static bool hardware();
+};
+
+#endif // CRC32C_H
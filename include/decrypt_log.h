@@ -0,0 +1,43 @@
+#ifndef DECRYPT_LOG_H
+#define DECRYPT_LOG_H
+
+#include <cstdio>
+
+// ========== 运行时解密库日志（编译期级别） ==========
+// 高于 DECRYPT_LOG_LEVEL 的日志调用整条编译为空（保留 if (0) 分支只为格式检查，不生成代码）。
+// 未指定时 Release（定义了 NDEBUG）只保留错误日志（只出现在失败路径上），
+// 正常启动路径不调用任何 stdio；其余构建输出全部日志。可用 -DDECRYPT_LOG_LEVEL=N 覆盖
+#define DECRYPT_LOG_LEVEL_NONE   0
+#define DECRYPT_LOG_LEVEL_ERROR  1      // 失败原因（stderr）
+#define DECRYPT_LOG_LEVEL_INFO   2      // 解密流程（stdout）
+#define DECRYPT_LOG_LEVEL_DEBUG  3      // 配置变更与定位细节（stdout）
+
+#ifndef DECRYPT_LOG_LEVEL
+#ifdef NDEBUG
+#define DECRYPT_LOG_LEVEL DECRYPT_LOG_LEVEL_ERROR
+#else
+#define DECRYPT_LOG_LEVEL DECRYPT_LOG_LEVEL_DEBUG
+#endif
+#endif
+
+#define DECRYPT_LOG_DISCARD(...) do { if (0) printf(__VA_ARGS__); } while (0)
+
+#if DECRYPT_LOG_LEVEL >= DECRYPT_LOG_LEVEL_ERROR
+#define DECRYPT_LOG_ERROR(...) fprintf(stderr, __VA_ARGS__)
+#else
+#define DECRYPT_LOG_ERROR(...) DECRYPT_LOG_DISCARD(__VA_ARGS__)
+#endif
+
+#if DECRYPT_LOG_LEVEL >= DECRYPT_LOG_LEVEL_INFO
+#define DECRYPT_LOG_INFO(...) printf(__VA_ARGS__)
+#else
+#define DECRYPT_LOG_INFO(...) DECRYPT_LOG_DISCARD(__VA_ARGS__)
+#endif
+
+#if DECRYPT_LOG_LEVEL >= DECRYPT_LOG_LEVEL_DEBUG
+#define DECRYPT_LOG_DEBUG(...) printf(__VA_ARGS__)
+#else
+#define DECRYPT_LOG_DEBUG(...) DECRYPT_LOG_DISCARD(__VA_ARGS__)
+#endif
+
+#endif // DECRYPT_LOG_H
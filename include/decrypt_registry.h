@@ -0,0 +1,76 @@
+#ifndef DECRYPT_REGISTRY_H
+#define DECRYPT_REGISTRY_H
+
+#include "image_locator.h"
+#include "encrypt_table.h"
+#include <dlfcn.h>
+#include <link.h>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// ========== 多目标解密注册表 ==========
+// 每个目标（主程序、插件SO……）有独立的镜像信息、加密表与状态，互不影响。
+// 目标按 link_map 身份精确匹配（dlopen/dlmopen 句柄 -> l_name 指针 + l_addr），
+// 同一路径在不同 dlmopen 命名空间中的副本是不同目标；也可按镜像内任意地址注册。
+// 注册期间对目标镜像持有一份 dlopen 引用（RTLD_NOLOAD），调用方 dlclose 后镜像仍不会卸载，remove() 时释放。
+// resolve() 用一次 dl_iterate_phdr 解析全部未解析目标（其他命名空间的句柄目标直接从 link_map 解析）；decryptAll() 对所有目标做一次分块并行解密，
+// 重叠或首尾相接的页区间合并后只做一次 mprotect；解密器自身所在镜像交给 Decryptor::decryptSelf()。
+// 目标必须带 .note.encrypt_text 描述符（旧格式镜像请用 Decryptor::decrypt()）。
+
+enum TargetState {
+    TARGET_PENDING = 0,         // 已注册，尚未解析
+    TARGET_RESOLVED,            // 已找到镜像
+    TARGET_DECRYPTED,
+    TARGET_NOT_FOUND,           // 镜像未加载（或已卸载）
+    TARGET_NO_DESCRIPTOR,       // 镜像中没有加密描述符
+    TARGET_FAILED,              // mprotect 失败
+    TARGET_REMOVED,             // 已 remove()，不再持有镜像引用
+    TARGET_BAD_CHECKSUM         // 明文 CRC32C 与描述符不符，已恢复为密文
+};
+
+struct TargetImage {
+    TargetState state;
+    const struct link_map* lm;  // 镜像的 link_map（按地址注册时解析后才有），由 handle 保证有效
+    void* handle;               // 对镜像持有的 dlopen 引用，remove() 时 dlclose
+    uintptr_t addr;             // 按地址注册时镜像内的地址
+    ImageInfo image;
+    EncryptTable* table;        // 解密器所在镜像复用 EncryptTable::self()，其余指向 own_table
+    std::unique_ptr<EncryptTable> own_table;
+};
+
+class DecryptRegistry {
+public:
+    static DecryptRegistry& instance();
+
+    // 返回目标编号，失败返回 -1；重复注册同一镜像返回已有编号
+    int addHandle(void* dl_handle);
+    int addAddress(const void* addr);
+    int addMain();
+    // 释放对镜像的引用并不再处理该目标（已解密的代码保持明文），编号不复用
+    bool remove(int id);
+
+    // 一次 dl_iterate_phdr 解析所有 PENDING/NOT_FOUND 目标，返回本次解析成功的数量
+    size_t resolve();
+    // 解析并解密所有尚未解密的目标（逐目标校验明文），全部成功返回 true，失败原因见各目标的 state
+    bool decryptAll();
+
+    size_t size() const { return m_targets.size(); }
+    TargetState state(int id) const;
+    const TargetImage* target(int id) const;
+    static const char* stateName(TargetState state);
+
+private:
+    DecryptRegistry() = default;
+    DecryptRegistry(const DecryptRegistry&) = delete;
+    DecryptRegistry& operator=(const DecryptRegistry&) = delete;
+
+    int add_locked(const struct link_map* lm, Lmid_t lmid, uintptr_t addr);
+    size_t resolve_locked();
+    bool load_table_locked(TargetImage& t);
+
+    mutable std::mutex m_mutex;
+    std::vector<std::unique_ptr<TargetImage>> m_targets;
+};
+
+#endif // DECRYPT_REGISTRY_H
@@ -21,30 +21,29 @@
 #include <limits.h>
 #include <link.h>
 #include <cstdint>
+#include <type_traits>
+#include <atomic>
+#include <future>
+#include "cipher.h"
+#include "cache_sync.h"
+
+class EncryptTable;
+struct CipherKey;
 // ========== 保留宏定义 ==========
 #define CRYPT_FUNC __attribute__((section(".encrypt_text")))
 #define MEM_BAR()   __asm__ __volatile__ ("" ::: "memory")
 
-// ========== 极简异或密钥（加密/解密共用，可自定义） ==========
-static const uint8_t XOR_KEY[] = {0x12, 0x34, 0x56, 0x78, 0x90, 0xAB, 0xCD, 0xEF};
-static const size_t XOR_KEY_LEN = sizeof(XOR_KEY) / sizeof(XOR_KEY[0]);
+// ========== 密钥与算法（与加密端共用 cipher.h 中的唯一定义） ==========
+// 加密表解密用的算法实例集合：首次调用时完成 AES 实现的 cpuid 选择，
+// 须在安装缺页处理之前调用一次（信号处理函数中不再做静态初始化）
+const CipherKey& runtime_cipher_key();
 
-// ========== 缓存刷新函数（保留） ==========
+// ========== 缓存刷新函数（委托给可插拔的指令缓存同步策略） ==========
 static inline void flush_cache(uint8_t* start, size_t len)
 {
     if (!start || len == 0) return;
-    #ifdef __linux__
-        // 增强缓存刷新：x86_64专用clflush + 通用clear_cache
-        __builtin___clear_cache((char*)start, (char*)(start + len));
-        // 循环刷新每个缓存行（x86_64缓存行64字节）
-        const size_t cache_line = 64;
-        for (size_t i = 0; i < len; i += cache_line) {
-            __builtin_ia32_clflush(start + i);
-        }
-        __sync_synchronize(); // 内存屏障，确保刷新生效
-    #else
-        asm volatile("" ::: "memory");
-    #endif
+    // x86默认只执行一条串行化指令，不再逐行clflush把刚写入的代码逐出缓存
+    CacheSync::sync(start, len);
 }
 
 // ========== 反调试函数（保留，注释掉实际逻辑） ==========
@@ -61,10 +60,8 @@ public:
     // 核心：极简异或解密（加密端用相同逻辑加密）
     static void simpleXorDecrypt(uint8_t* data, size_t len) {
         if (!data || len == 0) return;
-        // 循环异或密钥，100%可逆，无任何分段/位操作问题
-        for (size_t i = 0; i < len; i++) {
-            data[i] ^= XOR_KEY[i % XOR_KEY_LEN];
-        }
+        // 与加密端共用同一算法实例（编译期特化的异或循环 + SIMD内核）
+        XOR_CIPHER.apply(data, len);
     }
 };
 
@@ -76,28 +73,154 @@ public:
         TYPE_STATIC_A = 1
     };
 
+    enum DecryptMode {
+        MODE_EAGER = 0,     // decrypt() 时整段解密
+        MODE_LAZY = 1       // 整页保持不可访问，首次缺页时按页解密
+    };
+
+    // 整段解密写入方式
+    enum DecryptEngine {
+        ENGINE_MPROTECT = 0,    // 原地解密：mprotect RWX -> 解密 -> mprotect RX
+        ENGINE_MEMFD = 1        // 解密到 memfd 后封印，一次 mmap(MAP_FIXED) 以 RX 换入（W^X，见 memfd_text.h）；
+                                // 多一次 shmem 分页与内核复制，大段时仍比 ENGINE_MPROTECT 慢（256 MB 约两成），默认不用
+    };
+
+    // 解密状态机：IDLE -> IN_PROGRESS -> DONE / FAILED（FAILED 可由下一次 decrypt() 重试）
+    enum DecryptState {
+        STATE_IDLE = 0,
+        STATE_IN_PROGRESS = 1,
+        STATE_DONE = 2,
+        STATE_FAILED = 3
+    };
+
+    // 线程安全：只有一个线程执行解密，其余线程在 futex 上等待其结果
     static bool decrypt();
-    static bool isDecrypted();
+    // 热路径可随意调用：一次 relaxed 读，命中后补 acquire 栅栏（x86 上均无额外指令）
+    static bool isDecrypted() {
+        if (g_state.load(std::memory_order_relaxed) != STATE_DONE) return false;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return true;
+    }
+    static DecryptState state();
+
+    // 最近一次 decrypt() / decryptAsync()（及 TYPE_STATIC_A 时的 decryptSelf()）的失败原因
+    enum DecryptError {
+        DECRYPT_OK = 0,
+        DECRYPT_ERR_FAILED = 1,         // 定位镜像、改权限、映射等失败（原因见错误日志）
+        DECRYPT_ERR_INTEGRITY = 2       // 明文 CRC32C 与 encrypt_tool 记录的不符（密钥错误、重复加密或文件损坏），
+                                        // 代码已恢复为密文、权限恢复为 RX
+    };
+    static DecryptError lastError();
     static void setTargetInfo(TargetType type, const char* name = nullptr);
+    // 选择解密后的指令缓存同步策略；已有其他线程运行时可选 CACHE_SYNC_MEMBARRIER
+    static bool setCacheSync(CacheSyncKind kind);
+    // 必须在 decrypt() 之前设置
+    static void setDecryptMode(DecryptMode mode);
+    // 整段解密的写入方式（惰性模式不受影响），须在 decrypt() 之前设置
+    static void setDecryptEngine(DecryptEngine engine);
+    // 整段解密改为映射 dir（tmpfs，如 /dev/shm）中按 build-id + 密钥指纹在进程间共享的明文
+    // （见 shared_text_cache.h），条目不可用时照常解密；nullptr / 空串关闭。惰性模式不受影响，须在 decrypt() 之前设置
+    static void setSharedCache(const char* dir);
+    // 整段解密的线程数（0 = 按在线CPU数）与启用多线程的段大小阈值，须在 decrypt() 之前设置
+    static void setParallelDecrypt(size_t threads, size_t threshold);
+    // 整段解密完成后把 .encrypt_text 中按 2 MB 对齐的部分换成透明大页（见 huge_text.h），须在 decrypt() 之前设置
+    static void setHugePages(bool enable);
+    // 惰性模式下实际解密的页数 / 惰性管理的总页数
+    static size_t lazyPagesDecrypted();
+    static size_t lazyPagesTotal();
+
+    // 整段解密各阶段（顺序即执行顺序）；描述符路径不读文件，PHASE_FILE_MAP 为 0。
+    // ENGINE_MEMFD 下 RWX 阶段为创建 memfd，RX 阶段为封印与 MAP_FIXED 换入（在缓存刷新之前）；
+    // 共享缓存的查找、校验、生成与映射全部计入 PHASE_DECRYPT
+    enum DecryptPhase {
+        PHASE_BASE_DISCOVERY = 0,   // 定位目标镜像与装载基址
+        PHASE_FILE_MAP = 1,         // 旧格式：open + fstat + mmap 镜像文件
+        PHASE_SECTION_LOOKUP = 2,   // 解析 PT_NOTE 描述符 / 扫描段头定位 .encrypt_text
+        PHASE_PROBE = 3,            // 一次 madvise(MADV_POPULATE_READ) 预读并检查加密区间可访问（惰性模式不预读）
+        PHASE_MPROTECT_RWX = 4,     // 含 MADV_POPULATE_WRITE 预先完成写时复制
+        PHASE_DECRYPT = 5,          // 密钥流异或（含分块并行）
+        PHASE_CACHE_FLUSH = 6,
+        PHASE_MPROTECT_RX = 7,
+        PHASE_COUNT = 8
+    };
+    // 最近一次 decrypt() 各阶段耗时（纳秒，CLOCK_MONOTONIC），未经过的阶段为 0
+    static uint64_t phaseNs(DecryptPhase phase);
+    static const char* phaseName(DecryptPhase phase);
+
+    // 最近一次 decrypt() 的统计（供导出到调用方自己的指标系统），与日志级别无关始终记录
+    struct Stats {
+        uint64_t phase_ns[PHASE_COUNT];     // 同 phaseNs()
+        uint64_t total_ns;                  // run_decrypt 总耗时
+        uint64_t bytes_decrypted;           // 经过密钥流的字节数（不含重定位空洞与已按函数解密的部分）
+        uint64_t pages_touched;             // 设为 RWX 并写入的页数
+        uint32_t mprotect_calls;            // 惰性模式：字节数只含挂起时立即解密的首尾部分，页数与
+                                            // mprotect 不计（缺页解密见 lazyPages*）
+        uint64_t minor_faults;              // getrusage(RUSAGE_SELF) 差值，含同期其他线程的缺页
+        uint64_t major_faults;
+        uint64_t huge_page_bytes;           // setHugePages(true) 时换成大页的字节数
+        uint32_t shared_cache;              // SharedTextCache::Result（未启用或不可用为 0）
+    };
+    static Stats stats();
+
+    // 按函数解密（依赖 encrypt_tool 写入的加密描述符函数表），可在 decrypt() 之前调用；
+    // fn 为函数内任意地址，已解密的函数直接返回。惰性模式下已挂起的函数由缺页处理，
+    // 这里不重复解密；尚未挂起时照常解密
+    static bool decryptFunction(const void* fn);
+    // 批量解密：相邻函数所在页合并成一次 mprotect
+    static bool decryptFunctions(const void* const* fns, size_t count);
+    // 后台线程解密：先按 setProfile() 载入的启动画像顺序逐个解密函数，再解密剩余部分；
+    // 返回的 future 在全部解密完成后就绪（丢弃 future 不会阻塞调用方）
+    static std::future<bool> decryptAsync();
+    // 解密器自身所在镜像的整表解密（DecryptRegistry 用）：与按函数解密、decrypt()/decryptAsync() 共用
+    // g_func_mutex；目标为主程序（TYPE_STATIC_A）时经状态机，完成后 isDecrypted() 为真，惰性模式已挂起时不再解密
+    static DecryptError decryptSelf();
+    // 门控：fn 已就绪时只有一次原子读；未就绪时调用线程立即解密该函数（不等待后台线程排到它）
+    static bool waitFunction(const void* fn);
+    // 启动画像：载入解密顺序 / 记录本次运行各函数首次经过门控的时间，saveProfile() 写出
+    static bool setProfile(const char* path);
+    static bool startProfileRecording(const char* path);
+    static bool saveProfile();
+
+    // 非虚成员函数地址（Itanium ABI：虚函数的成员指针第一个字为奇数，返回 nullptr）
+    template <typename M>
+    static const void* memberAddress(M fn) {
+        static_assert(std::is_member_function_pointer<M>::value, "member function pointer required");
+        static_assert(sizeof(M) == 2 * sizeof(uintptr_t), "unexpected member pointer ABI");
+        uintptr_t words[2];
+        memcpy(words, &fn, sizeof(words));
+        return (words[0] & 1) ? nullptr : (const void*)words[0];
+    }
 
 private:
     static TargetType g_target_type;
     static uintptr_t g_base_addr;
     static char TARGET_NAME[PATH_MAX];
-    static bool g_is_decrypted;
+    static std::atomic<uint32_t> g_state;   // DecryptState，进行中时可带等待者标志位
     static char g_target_path[PATH_MAX];
     static bool g_target_loaded;
+    static DecryptMode g_decrypt_mode;
+    static DecryptEngine g_decrypt_engine;
+    static bool g_huge_pages;
 
-    bool is_address_accessible(uintptr_t addr, size_t len);
     bool is_target_so(const char* so_path) const;
     bool find_target_so_path();
     bool find_executable_path();
     bool decrypt_so_section_impl();
     bool decrypt_executable_section_impl();
-    
-    // 直接用完整定义的dl_phdr_info，无任何前向声明！
-    int dl_callback(struct dl_phdr_info* info, size_t size) const;
-    static int dl_callback_wrapper(struct dl_phdr_info* info, size_t size, void* data);
+    bool decrypt_from_descriptor(bool& found);
+    bool decrypt_section_range(uintptr_t sec_real_addr, size_t sec_size, EncryptTable* table);
+    static bool decrypt_section_memfd(uintptr_t page_start, size_t page_len,
+                                      uintptr_t sec_real_addr, size_t sec_size, EncryptTable* table);
+    static bool decrypt_section_shared(uintptr_t page_start, size_t page_len,
+                                       uintptr_t sec_real_addr, size_t sec_size, EncryptTable* table);
+    static bool begin_decrypt(bool wait, bool& result);
+    static void end_decrypt(bool ok);
+    static bool wait_decrypt();
+    static bool run_decrypt();
+    static bool decrypt_function_indices(long* idx, size_t count);
+    static DecryptError decrypt_table_remaining();
+    static bool decrypt_async_worker();
+
     
     static Decryptor& getInstance();
     Decryptor() = default;
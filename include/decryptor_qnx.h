@@ -10,6 +10,7 @@
 #include <dlfcn.h>
 #include <sys/types.h>
 #include <errno.h>
+#include "cipher.h"
 
 // ARM64 QNX 强制指令对齐+段属性，和加密端一致
 #define CRYPT_FUNC __attribute__((section(".encrypt_text"), aligned(4), alloc, execinstr, pure))
@@ -19,14 +20,32 @@
 #define ISB_SYNC()  __asm__ __volatile__ ("isb sy" ::: "memory", "cc")
 #define MEM_BAR()   __asm__ __volatile__ ("" ::: "memory")
 
-// ✅ 正确的ARM64 QNX缓存刷新函数 (end在前，start在后)
+// ✅ ARM64 QNX缓存刷新：按 CTR_EL0 给出的行大小 DC CVAU + IC IVAU，替代 __clear_cache
+// （与 cache_sync.cpp 的 Arm64DcIcSync 相同；该文件依赖 Linux membarrier，QNX 不编译它）
 static inline void flush_arm64_cache(uint8_t* start, size_t len)
 {
     if (!start || len == 0) return;
-    uint8_t* end = start + len - 1;
-    extern void __clear_cache(void*, void*);
-    __clear_cache((void*)end, (void*)start);
-    DSB_SYNC();
+    uint64_t ctr = 0;
+    __asm__ __volatile__("mrs %0, ctr_el0" : "=r"(ctr));
+    const uintptr_t dline = (uintptr_t)4 << ((ctr >> 16) & 0xF);
+    const uintptr_t iline = (uintptr_t)4 << (ctr & 0xF);
+    const uintptr_t end = (uintptr_t)start + len;
+
+    // CTR_EL0.IDC=1：数据缓存清理到PoU不是必须的
+    if (!((ctr >> 28) & 1)) {
+        for (uintptr_t p = (uintptr_t)start & ~(dline - 1); p < end; p += dline) {
+            __asm__ __volatile__("dc cvau, %0" :: "r"(p) : "memory");
+        }
+    }
+    __asm__ __volatile__("dsb ish" ::: "memory");
+
+    // CTR_EL0.DIC=1：指令缓存失效不是必须的
+    if (!((ctr >> 29) & 1)) {
+        for (uintptr_t p = (uintptr_t)start & ~(iline - 1); p < end; p += iline) {
+            __asm__ __volatile__("ic ivau, %0" :: "r"(p) : "memory");
+        }
+        __asm__ __volatile__("dsb ish" ::: "memory");
+    }
     ISB_SYNC();
     MEM_BAR();
 }
@@ -39,11 +58,8 @@ public:
     DecryptTool(const DecryptTool&) = delete;
     DecryptTool& operator=(const DecryptTool&) = delete;
 
-    static void simple_xor_crypt(uint8_t* data, size_t len);
-
-private:
-    static const uint8_t XOR_KEY[16];
-    static const size_t  XOR_KEY_LEN;
+    // 与加密端走同一条路径：cipher.h 中的 QNX_XOR_CIPHER（非 x86 上完全内联，不依赖 xor_kernel.cpp）
+    static inline void simple_xor_crypt(uint8_t* data, size_t len) { QNX_XOR_CIPHER.apply(data, len); }
 };
 
 // ✅ 解密核心类
@@ -0,0 +1,77 @@
+#ifndef ENCRYPT_FORMAT_H
+#define ENCRYPT_FORMAT_H
+
+#include <cstddef>
+#include <cstdint>
+
+// ========== 加密描述符格式（encrypt_tool 写入目标文件，运行时读取） ==========
+// encrypt_tool 为每个含 .encrypt_text 的目标文件追加一个可分配的 SHT_NOTE 段 .note.encrypt_text，
+// 链接后各目标文件的 note 首尾相接，落在 PT_NOTE 段内，运行时只需遍历已映射的程序头即可找到
+// （无文件I/O，不依赖段头表，strip 后仍可用）。每个 note：
+//   Elf64_Nhdr { namesz = 9, descsz, type = ENCRYPT_NOTE_TYPE } "LinuxEnc\0" + 3字节填充
+//   desc = [EncryptTableHeader][EncryptFuncEntry × func_count][EncryptHole × hole_count]
+// 段按8字节对齐，desc 从 note 内第24字节开始，各字段自然对齐。
+// 地址字段均为 R_X86_64_PC64 重定位（目标地址 - 字段自身地址），静态链接时即可确定，
+// 不产生动态重定位，PIE/SO/ET_EXEC 通用，段可保持只读。
+// mprotect 的页对齐范围取决于链接后的地址，由运行时按各块的加密区间求并集后对齐得到。
+// 密钥流按块内偏移寻址（XOR 为 key[off % key_len]，AES-CTR 为 E(K, nonce || off / 16)），
+// 任意函数/页都能单独解密；AES-CTR 的 nonce 每个目标文件一个，写在头中。
+// 带 ENCRYPT_TABLE_FLAG_CRC 的块在 plain_crc 中记录本目标文件 .encrypt_text 明文的 CRC32C：
+// 跳过重定位空洞（链接器会改写），其余字节按偏移顺序拼接。运行时整段解密时顺带计算并比较。
+
+#define ENCRYPT_NOTE_SECTION    ".note.encrypt_text"
+#define ENCRYPT_NOTE_OWNER      "LinuxEnc"
+#define ENCRYPT_NOTE_TYPE       0x4B454E43u     // "CNEK"
+#define ENCRYPT_TABLE_MAGIC     0x434E454Bu     // "KENC"
+#define ENCRYPT_TABLE_VERSION   3
+
+// EncryptTableHeader::cipher
+#define ENCRYPT_CIPHER_XOR          0           // 8字节循环异或（旧格式的唯一算法）
+#define ENCRYPT_CIPHER_AES128_CTR   1
+#define ENCRYPT_CIPHER_AES256_CTR   2
+
+// EncryptTableHeader::flags
+#define ENCRYPT_TABLE_FLAG_ENCRYPTED    0x1     // 该目标文件的 .encrypt_text 已加密
+#define ENCRYPT_TABLE_FLAG_DECRYPTED    0x2     // 仅运行时：装载时已被自动解密（LD_AUDIT 写入映射中的描述符，文件中从不设置）
+#define ENCRYPT_TABLE_FLAG_CRC          0x4     // plain_crc 有效（旧版 encrypt_tool 写的块没有，不做校验）
+
+struct EncryptTableHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t flags;             // ENCRYPT_TABLE_FLAG_*
+    uint32_t block_size;        // 整个块字节数（含头，8字节对齐），即 note 的 descsz
+    uint32_t func_count;
+    int64_t  rel_section;       // PC64 -> 本目标文件 .encrypt_text 起始
+    uint32_t section_size;      // 本目标文件 .encrypt_text 大小
+    uint32_t hole_count;
+    uint8_t  cipher;            // ENCRYPT_CIPHER_*
+    uint8_t  reserved[3];
+    uint32_t plain_crc;         // ENCRYPT_TABLE_FLAG_CRC：明文（不含空洞）的 CRC32C
+    uint64_t nonce;             // AES-CTR 计数器高8字节；XOR 时为0
+};
+
+struct EncryptFuncEntry {
+    int64_t  rel_addr;          // PC64 -> 函数起始
+    uint32_t size;
+    uint32_t key_offset;        // 函数在本目标文件 .encrypt_text 内的偏移（即密钥流位置）
+    uint32_t hole_first;        // 本块 hole 数组中第一个落在函数内的下标
+    uint32_t hole_count;
+};
+
+// 重定位空洞：链接器会改写这些字节（含可能被松弛改写的操作码），加密端不加密，解密端跳过
+struct EncryptHole {
+    uint32_t offset;            // 段内偏移
+    uint32_t size;
+};
+
+static_assert(sizeof(EncryptTableHeader) == 48, "EncryptTableHeader layout");
+static_assert(sizeof(EncryptFuncEntry) == 24, "EncryptFuncEntry layout");
+static_assert(sizeof(EncryptHole) == 8, "EncryptHole layout");
+
+// PC64 字段解引用：字段地址 + 字段值
+static inline uintptr_t encrypt_rel_target(const int64_t* field)
+{
+    return (uintptr_t)field + (uintptr_t)*field;
+}
+
+#endif // ENCRYPT_FORMAT_H
@@ -0,0 +1,134 @@
+#ifndef ENCRYPT_TABLE_H
+#define ENCRYPT_TABLE_H
+
+#include "encrypt_format.h"
+#include "cipher.h"
+#include <link.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+struct ImageInfo;
+
+// ========== 解密密钥集合（按块的 cipher 字段选用） ==========
+// 只持有已完成密钥编排的算法实例；块使用的算法缺少对应实例时该块不解密
+struct CipherKey {
+    const XorCipher* xor_cipher;
+    const Aes128CtrCipher* aes128;
+    const Aes256CtrCipher* aes256;
+};
+
+class EncryptTable;
+
+// ========== 明文校验和（带 ENCRYPT_TABLE_FLAG_CRC 的块） ==========
+// 分块解密时每个分块把所覆盖的各块区间的 CRC32C 片段 add() 进来（可多线程并发），
+// 全部分块完成后 verify() 按块内偏移顺序合并，与 encrypt_tool 写入的 plain_crc 比较
+#define ENCRYPT_CRC_TILE ((size_t)8 << 10)     // 异或后趁数据仍在 L1 中累加 CRC 的分段大小
+
+class PlainChecksum {
+public:
+    // [offset, end) 为片段在块内的范围，len 为参与计算的字节数（不含空洞）；
+    // 紧接上一个片段的会就地合并，顺序解密整段时只保留一个片段
+    void add(uint32_t block, size_t offset, size_t end, size_t len, uint32_t crc);
+    // 本次解密的每个带校验和的块都被完整覆盖且相符时返回 true，否则 bad_block 为第一个不符的块
+    bool verify(const EncryptTable& table, size_t& bad_block) const;
+
+private:
+    struct Piece {
+        uint32_t block;
+        uint32_t offset;
+        uint32_t end;
+        uint32_t len;
+        uint32_t crc;
+    };
+    mutable std::mutex m_mutex;
+    std::vector<Piece> m_pieces;
+};
+
+// ========== 运行时加密表（解析镜像 PT_NOTE 中的 .note.encrypt_text 描述符） ==========
+struct EncryptBlock {
+    const EncryptTableHeader* header;   // 映射中的描述符头
+    uintptr_t sec_addr;                 // 该目标文件 .encrypt_text 运行时地址
+    size_t sec_size;
+    const EncryptFuncEntry* funcs;
+    uint32_t func_count;
+    const EncryptHole* holes;
+    uint32_t hole_count;
+    uint32_t func_first;                // 该块第一个函数在全局函数数组中的下标
+    uint8_t cipher;                     // ENCRYPT_CIPHER_*
+    uint64_t nonce;                     // AES-CTR 计数器高8字节
+    bool decrypted;                     // 装载时已被自动解密（ENCRYPT_TABLE_FLAG_DECRYPTED），不再处理
+};
+
+struct EncryptFunc {
+    uintptr_t addr;
+    uint32_t size;
+    uint32_t block;
+};
+
+enum EncryptFuncState {
+    FUNC_ENCRYPTED = 0,
+    FUNC_DECRYPTING = 1,
+    FUNC_DECRYPTED = 2
+};
+
+class EncryptTable {
+public:
+    EncryptTable() = default;
+    EncryptTable(const EncryptTable&) = delete;
+    EncryptTable& operator=(const EncryptTable&) = delete;
+
+    // 本镜像（链接了解密器的可执行文件或SO）的加密表
+    static EncryptTable& self();
+
+    // 遍历镜像已映射的 PT_NOTE，收集所有带加密标记的描述符；所有者/类型不符的 note 跳过，
+    // 所有者相符但魔数/版本/算法不符或已损坏的计入 rejectedCount() 且整张表置空
+    bool loadNotes(const ElfW(Phdr)* phdr, uint16_t phnum, uintptr_t load_bias);
+    bool loadImage(const ImageInfo& image);
+
+    bool empty() const { return m_blocks.empty(); }
+    // 镜像带有加密 note 但无法使用的描述符个数：非 0 时必须报错，不能按旧格式整段异或
+    size_t rejectedCount() const { return m_rejected; }
+    size_t blockCount() const { return m_blocks.size(); }
+    size_t funcCount() const { return m_funcs.size(); }
+    const EncryptBlock& block(size_t i) const { return m_blocks[i]; }
+    const EncryptFunc& func(size_t i) const { return m_funcs[i]; }
+    std::atomic<uint8_t>& funcState(size_t i) { return m_state[i]; }
+    // 所有块加密区间的并集 [start, start+size)（各目标文件的 .encrypt_text 链接后相邻）
+    bool extent(uintptr_t& start, size_t& size) const;
+
+    // 按地址查找函数（地址落在函数内即可），找不到返回 -1
+    long findFunction(uintptr_t addr) const;
+
+    // 解密 [start, start+len) 与各块的交集：跳过重定位空洞，密钥流按块内偏移计算
+    // 不处理内存权限，调用方负责 RWX；仅做查表与密钥流异或，可在信号处理函数中调用。
+    // delta 非 0 时解密的是位于 start + delta 的副本（地址与密钥流偏移仍按运行时地址计算）
+    size_t decryptRange(uintptr_t start, size_t len, const CipherKey& key, intptr_t delta = 0) const;
+
+    // 解密所有块中尚未单独解密的函数及函数间隙，并标记全部函数为已解密；只生效一次
+    size_t decryptRemaining(const CipherKey& key);
+    // 解密 [start, start+len) 内除已单独解密函数外的部分，不修改函数状态（供分块并行解密）；
+    // 所有分块完成后调用 markAllDecrypted()
+    size_t decryptPending(uintptr_t start, size_t len, const CipherKey& key, intptr_t delta = 0) const;
+    // 同 decryptPending，另对带校验和的块按 ENCRYPT_CRC_TILE 分段：每段异或后立即累加明文 CRC32C
+    // （已单独解密的函数只累加），片段交给 sums
+    size_t decryptPendingChecked(uintptr_t start, size_t len, const CipherKey& key, PlainChecksum& sums,
+                                 intptr_t delta = 0) const;
+    // 有尚未解密、带校验和的块
+    bool hasChecksums() const;
+    void markAllDecrypted();
+    bool allDecrypted() const { return m_all_decrypted.load(std::memory_order_acquire); }
+
+private:
+    void addBlock(const uint8_t* desc, size_t desc_size);
+
+    std::vector<EncryptBlock> m_blocks;
+    std::vector<EncryptFunc> m_funcs;
+    std::vector<uint32_t> m_by_addr;    // 按地址排序的函数下标
+    std::unique_ptr<std::atomic<uint8_t>[]> m_state;
+    size_t m_rejected = 0;
+    std::atomic<bool> m_all_decrypted{false};
+};
+
+#endif // ENCRYPT_TABLE_H
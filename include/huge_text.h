@@ -0,0 +1,26 @@
+#ifndef HUGE_TEXT_H
+#define HUGE_TEXT_H
+
+#include <cstddef>
+#include <cstdint>
+
+// ========== 已解密代码换成透明大页（2 MB）承载 ==========
+// 解密写入后的代码页是文件私有映射上的匿名 COW 页，内核不会把它们合并成大页
+// （MADV_COLLAPSE 对文件映射只处理页缓存）。这里把区间内按 2 MB 对齐的部分复制到一块
+// MADV_HUGEPAGE 的匿名内存，必要时 MADV_COLLAPSE，设为 RX 后用一次 mremap(MREMAP_FIXED)
+// 原子替换原映射，内容不变。
+// 需要 .encrypt_text 所在段按 2 MB 对齐（cmake/encrypt_text_segment.ld），否则对齐部分可能为空
+class HugeText {
+public:
+    HugeText() = delete;
+    ~HugeText() = delete;
+    HugeText(const HugeText&) = delete;
+    HugeText& operator=(const HugeText&) = delete;
+
+    static const size_t HUGE_PAGE_SIZE = 2u << 20;
+
+    // [start, start+len) 必须当前可读且为 RX；返回换成大页的字节数（THP 关闭/不足 2 MB 时为 0）
+    static size_t promote(uintptr_t start, size_t len);
+};
+
+#endif // HUGE_TEXT_H
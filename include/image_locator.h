@@ -0,0 +1,36 @@
+#ifndef IMAGE_LOCATOR_H
+#define IMAGE_LOCATOR_H
+
+#include <link.h>
+#include <cstddef>
+#include <cstdint>
+
+// ========== 已加载镜像定位（dl_iterate_phdr，无文件I/O、不依赖 /proc） ==========
+// load_bias 即 dlpi_addr：运行时地址 = load_bias + p_vaddr/sh_addr。
+// PIE/SO 为实际装载偏移，ET_EXEC 为 0（sh_addr 已是绝对地址）。
+struct ImageInfo {
+    uintptr_t load_bias;
+    const char* path;               // 主程序为 AT_EXECFN，其余为 link_map 中的名字；可能为空串
+    const ElfW(Phdr)* phdr;         // 已映射的程序头表
+    uint16_t phnum;
+    bool is_main;                   // 主程序（dl_iterate_phdr 的第一个对象）
+};
+
+class ImageLocator {
+public:
+    ImageLocator() = delete;
+    ~ImageLocator() = delete;
+    ImageLocator(const ImageLocator&) = delete;
+    ImageLocator& operator=(const ImageLocator&) = delete;
+
+    // 包含 addr 的镜像（addr 落在某个 PT_LOAD 内）
+    static bool findByAddress(const void* addr, ImageInfo& out);
+    // 路径包含 name 的镜像（与原 strstr 匹配规则一致；主程序按 AT_EXECFN 匹配）
+    static bool findByName(const char* name, ImageInfo& out);
+    // 主程序
+    static bool findMain(ImageInfo& out);
+    // 由 link_map 直接得到镜像信息，不遍历（可用于其他 dlmopen 命名空间及 LD_AUDIT 回调中）
+    static bool fromLinkMap(const struct link_map* lm, ImageInfo& out);
+};
+
+#endif // IMAGE_LOCATOR_H
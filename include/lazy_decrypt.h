@@ -0,0 +1,42 @@
+#ifndef LAZY_DECRYPT_H
+#define LAZY_DECRYPT_H
+
+#include <cstddef>
+#include <cstdint>
+
+// 同时挂起的惰性解密段数上限（每个目标镜像一个）
+#define LAZY_MAX_RANGES 16
+
+// ========== 按页惰性解密（SIGSEGV驱动） ==========
+// arm() 后加密段内部整页保持 PROT_NONE，首次访问触发缺页信号时只解密该页；
+// 段首/段尾不满一页的部分与普通 .text 共页，立即解密，保证解密器自身代码不会落在惰性页上。
+// 每页状态由三张原子位图维护（claimed/ready/failed），多线程同时命中同一页时只有一个线程解密；
+// 改权限失败的页恢复为密文 + PROT_NONE 并置 failed，等待中的线程随之返回，缺页交还给之前的处理函数。
+// 区间解密回调：解密 [start, start+len)（调用时该区间已可写），sec_start 为加密段起始；
+// 会在信号处理函数中调用，不能分配内存或加锁；须为密钥流异或（对同一区间再调用一次即恢复密文，失败回滚依赖这一点）
+typedef void (*LazyDecryptFn)(uintptr_t start, size_t len, uintptr_t sec_start, void* ctx);
+
+class LazyDecryptor {
+public:
+    LazyDecryptor() = delete;
+    ~LazyDecryptor() = delete;
+    LazyDecryptor(const LazyDecryptor&) = delete;
+    LazyDecryptor& operator=(const LazyDecryptor&) = delete;
+
+    // sec_addr/sec_size：加密段运行时地址与大小；整段异或，密钥流偏移按段内偏移计算
+    static bool arm(uintptr_t sec_addr, size_t sec_size, const uint8_t* key, size_t key_len);
+    // 自定义区间解密（如按加密表跳过重定位空洞）
+    static bool arm(uintptr_t sec_addr, size_t sec_size, LazyDecryptFn fn, void* ctx);
+    // 立即解密所有尚未解密的页（切回全量模式或退出前使用）
+    static bool decryptAll();
+
+    // addr 所在加密段已由 arm() 接管（惰性页由缺页处理解密，首尾部分已立即解密）
+    static bool armed(uintptr_t addr);
+
+    static size_t pagesTotal();         // 惰性管理的页数（不含立即解密的首尾页）
+    static size_t pagesDecrypted();     // 已按需解密的页数
+    static size_t bytesDecrypted();     // 已解密字节数（含首尾页的立即解密部分）
+    static size_t faultsHandled();      // 处理过的缺页信号次数（含等待其他线程的次数）
+};
+
+#endif // LAZY_DECRYPT_H
@@ -0,0 +1,30 @@
+#ifndef MEMFD_TEXT_H
+#define MEMFD_TEXT_H
+
+#include <cstddef>
+#include <cstdint>
+
+// ========== memfd 换入已解密代码（W^X：任何页都不会同时可写可执行） ==========
+// create() 建一个 memfd，调用方把明文写入（先 pwrite 密文，再经可写共享映射就地解密，写完须解除映射），
+// 然后 commit()：加 F_SEAL_WRITE/GROW/SHRINK/SEAL 封印，再用一次 mmap(MAP_FIXED) 以只读可执行
+// 覆盖原加密区间。封印后的映射无法再获得写权限（mprotect 加 PROT_WRITE 也会失败）。
+class MemfdText {
+public:
+    MemfdText() = default;
+    ~MemfdText();
+    MemfdText(const MemfdText&) = delete;
+    MemfdText& operator=(const MemfdText&) = delete;
+
+    // len 须为页大小的整数倍
+    bool create(size_t len);
+    int fd() const { return m_fd; }
+    size_t size() const { return m_len; }
+    // addr 须页对齐；成功后 fd 已关闭
+    bool commit(uintptr_t addr);
+
+private:
+    int m_fd = -1;
+    size_t m_len = 0;
+};
+
+#endif // MEMFD_TEXT_H
@@ -0,0 +1,48 @@
+#ifndef PARALLEL_DECRYPT_H
+#define PARALLEL_DECRYPT_H
+
+#include <cstddef>
+#include <cstdint>
+
+// 单线程/多线程分界的默认段大小
+#define PARALLEL_DEFAULT_THRESHOLD  ((size_t)4 << 20)
+// 默认分块大小（按页对齐）
+#define PARALLEL_DEFAULT_CHUNK      ((size_t)256 << 10)
+#define PARALLEL_MAX_THREADS        64
+
+// 区间解密回调：解密 [start, start+len)，sec_start 为该目标加密段起始（密钥流偏移基准）
+typedef void (*RangeDecryptFn)(uintptr_t start, size_t len, uintptr_t sec_start, void* ctx);
+
+struct DecryptTarget {
+    uintptr_t sec_addr;
+    size_t sec_size;
+    RangeDecryptFn fn;
+    void* ctx;
+};
+
+// ========== 多核分块解密 ==========
+// 所有目标按页对齐切块后平均分给各工作线程（调用线程也是其中之一），
+// 每个线程的待处理区间是一个打包的原子 (lo, hi)：本线程从 lo 端取块，空闲线程从最忙线程的 hi 端偷走一半。
+// 只负责异或，内存权限由调用方在 run() 前后设置。总大小低于阈值时直接在调用线程串行完成。
+class ParallelDecryptor {
+public:
+    ParallelDecryptor() = delete;
+    ~ParallelDecryptor() = delete;
+    ParallelDecryptor(const ParallelDecryptor&) = delete;
+    ParallelDecryptor& operator=(const ParallelDecryptor&) = delete;
+
+    static bool run(const DecryptTarget* targets, size_t count);
+
+    // 0 = 按在线CPU数
+    static void setThreads(size_t threads);
+    static size_t threads();
+    static void setThreshold(size_t bytes);
+    static size_t threshold();
+    static void setChunkSize(size_t bytes);
+    static size_t chunkSize();
+    // 上一次 run() 实际使用的线程数与被偷取的次数
+    static size_t lastThreads();
+    static size_t lastSteals();
+};
+
+#endif // PARALLEL_DECRYPT_H
@@ -0,0 +1,45 @@
+#ifndef SHARED_TEXT_CACHE_H
+#define SHARED_TEXT_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <sys/types.h>
+
+struct ImageInfo;
+
+// ========== 跨进程共享的已解密代码缓存（tmpfs，按 build-id + 密钥指纹） ==========
+// 同一加密镜像的多个进程共用同一份明文物理页：第一个进程把整页区间的明文写入
+// <dir>/encrypt_text-<uid>-<build-id>-<指纹>，之后的进程（包括重启后）直接以
+// MAP_SHARED | MAP_FIXED 只读可执行映射到加密区间，不再各自持有一份私有脏页。
+// 条目格式：一页头部（魔数、版本、build-id、指纹、区间相对装载基址的偏移与长度、明文 CRC32C）+ 整页明文。
+// 并发首次启动：同名 .lock 文件上 flock 串行化生成者，等锁的进程拿到锁后先重新查找；
+// 发布时写临时文件再 rename，读者只会看到完整条目。
+// 只接受属主为当前用户且组/其他用户不可写的普通文件（O_NOFOLLOW），映射前校验头部、
+// 全文 CRC32C，并由调用方抽查若干页与本进程现场解密的结果一致
+class SharedTextCache {
+public:
+    SharedTextCache() = delete;
+    ~SharedTextCache() = delete;
+    SharedTextCache(const SharedTextCache&) = delete;
+    SharedTextCache& operator=(const SharedTextCache&) = delete;
+
+    enum Result {
+        CACHE_UNAVAILABLE = 0,  // 无法使用（无 build-id、目录不可写、noexec 挂载等），调用方照常解密
+        CACHE_HIT = 1,          // 映射了已有条目
+        CACHE_PUBLISHED = 2     // 本进程生成并发布了条目，并已映射
+    };
+
+    // 把 [page_start, page_start+page_len) 的明文写进 fd 从 offset 开始的区间
+    typedef bool (*FillFn)(int fd, off_t offset, void* ctx);
+    // 抽查条目明文 plain（对应 page_start 起的 page_len 字节），与本进程不符时返回 false
+    typedef bool (*VerifyFn)(const uint8_t* plain, void* ctx);
+
+    // 镜像的 NT_GNU_BUILD_ID（十六进制写入 out）；没有 build-id 或带文本重定位（各进程代码不同）时返回 false
+    static bool imageKey(const ImageInfo& image, char* out, size_t out_size);
+
+    // page_start 与 page_len 须页对齐；返回 HIT / PUBLISHED 时区间已是共享的只读可执行映射
+    static Result attach(const char* dir, const char* image_key, uint64_t fingerprint, const ImageInfo& image,
+                         uintptr_t page_start, size_t page_len, FillFn fill, VerifyFn verify, void* ctx);
+};
+
+#endif // SHARED_TEXT_CACHE_H
@@ -0,0 +1,78 @@
+#ifndef XOR_KERNEL_H
+#define XOR_KERNEL_H
+
+#include <cstddef>
+#include <cstdint>
+
+// ========== 异或内核指令集等级（运行时cpuid选择） ==========
+enum XorIsa {
+    XOR_ISA_SCALAR = 0,
+    XOR_ISA_SSE2   = 1,
+    XOR_ISA_AVX2   = 2,
+    XOR_ISA_AVX512 = 3,
+    XOR_ISA_COUNT
+};
+
+// SIMD路径支持的最大密钥长度（超过则走标量路径）
+#define XOR_MAX_SIMD_KEY_LEN 256
+
+// ========== 编译期密钥长度特化：2的幂长度用掩码代替取模 ==========
+template <size_t KeyLen, bool IsPow2 = (KeyLen != 0 && (KeyLen & (KeyLen - 1)) == 0)>
+struct XorKeyIndex {
+    static inline size_t wrap(size_t i) { return i % KeyLen; }
+};
+
+template <size_t KeyLen>
+struct XorKeyIndex<KeyLen, true> {
+    static inline size_t wrap(size_t i) { return i & (KeyLen - 1); }
+};
+
+// ========== 异或内核（加密端/解密端共用） ==========
+// 约定：data[i] ^= key[(key_offset + i) % key_len]
+// key_offset 为数据首字节在密钥流中的位置，按页/按函数解密时传入段内偏移即可
+class XorKernel {
+public:
+    XorKernel() = delete;
+    ~XorKernel() = delete;
+    XorKernel(const XorKernel&) = delete;
+    XorKernel& operator=(const XorKernel&) = delete;
+
+    typedef void (*KernelFn)(uint8_t* data, size_t len, const uint8_t* key, size_t key_len, size_t key_offset);
+
+    // 运行时分发入口：首次调用时用cpuid选择最优实现，之后只是一次间接调用
+    static void apply(uint8_t* data, size_t len, const uint8_t* key, size_t key_len, size_t key_offset = 0);
+
+    // 编译期定长密钥入口：短数据直接走特化的标量循环，长数据走SIMD
+    template <size_t KeyLen>
+    static inline void apply(uint8_t* data, size_t len, const uint8_t (&key)[KeyLen], size_t key_offset = 0) {
+        if (len < SMALL_LEN) {
+            applyScalar<KeyLen>(data, len, key, key_offset);
+        } else {
+            apply(data, len, key, KeyLen, key_offset);
+        }
+    }
+
+    template <size_t KeyLen>
+    static inline void applyScalar(uint8_t* data, size_t len, const uint8_t (&key)[KeyLen], size_t key_offset = 0) {
+        for (size_t i = 0; i < len; i++) {
+            data[i] ^= key[XorKeyIndex<KeyLen>::wrap(key_offset + i)];
+        }
+    }
+
+    // 指定指令集执行（基准测试/交叉校验用，不支持的指令集返回false）
+    static bool applyWith(XorIsa isa, uint8_t* data, size_t len, const uint8_t* key, size_t key_len, size_t key_offset = 0);
+
+    // 标量参考实现：逐字节取模，作为所有SIMD实现的对照基准
+    static void scalarReference(uint8_t* data, size_t len, const uint8_t* key, size_t key_len, size_t key_offset = 0);
+
+    static XorIsa detectIsa();
+    static XorIsa activeIsa();
+    static bool isaSupported(XorIsa isa);
+    static const char* isaName(XorIsa isa);
+
+private:
+    static const size_t SMALL_LEN = 64;
+    static KernelFn kernelFor(XorIsa isa);
+};
+
+#endif // XOR_KERNEL_H
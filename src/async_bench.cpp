@@ -0,0 +1,186 @@
+#include "decryptor_linux.h"
+#include "encrypt_table.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <sys/wait.h>
+
+// ===================== 首个请求延迟基准（同步整段解密 vs 后台解密） =====================
+// 载荷 async_bench_payload.cpp 在构建时被 encrypt_tool 加密（约16MB .encrypt_text）。
+// 每次测量都在新进程中进行：子进程先做一段模拟的启动工作，再处理“首个请求”
+// （请求处理函数 + 两个冷函数），报告从 main 到请求完成的时间以及全部解密完成的时间。
+//   sync          ：先整段解密（等价于 init() 里同步调用 decrypt()）
+//   async         ：decryptAsync() 按表顺序后台解密，请求前经过门控
+//   async-profile ：decryptAsync() 按记录的启动画像顺序后台解密
+// 用法：async_bench [runs] [startup_work_us]
+
+extern void (*const g_bench_cold[])();
+extern const size_t g_bench_cold_count;
+uint64_t bench_handle_request(uint64_t seed);
+
+static const size_t COLD_A = 5;
+static const size_t COLD_B = 41;
+
+static inline uint64_t now_ns()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static uint64_t median(std::vector<uint64_t>& v)
+{
+    std::sort(v.begin(), v.end());
+    return v[v.size() / 2];
+}
+
+// 与加密载荷中的处理函数相同的明文实现，用于校验解密结果
+static uint64_t reference_request(uint64_t seed)
+{
+    uint64_t h = seed ^ 0x9E3779B97F4A7C15ull;
+    for (int i = 0; i < 64; i++) {
+        h ^= h >> 33;
+        h *= 0xFF51AFD7ED558CCDull;
+    }
+    return h;
+}
+
+static void startup_work(uint64_t us)
+{
+    const uint64_t end = now_ns() + us * 1000;
+    volatile uint64_t x = 0;
+    while (now_ns() < end) {
+        x = x + 1;
+    }
+}
+
+// 首个请求：每个函数调用前都经过门控
+static bool first_request()
+{
+    Decryptor::waitFunction((const void*)bench_handle_request);
+    const uint64_t r = bench_handle_request(42);
+    Decryptor::waitFunction((const void*)g_bench_cold[COLD_A]);
+    g_bench_cold[COLD_A]();
+    Decryptor::waitFunction((const void*)g_bench_cold[COLD_B]);
+    g_bench_cold[COLD_B]();
+    return r == reference_request(42);
+}
+
+static int run_child(const std::string& mode, const char* profile, uint64_t work_us, int out_fd)
+{
+    const uint64_t t0 = now_ns();
+    if (EncryptTable::self().empty()) {
+        fprintf(stderr, "[async_bench] payload has no encrypt descriptor (not encrypted?)\n");
+        return 2;
+    }
+    Decryptor::setTargetInfo(Decryptor::TYPE_STATIC_A, nullptr);
+
+    bool ok = true;
+    uint64_t ttfr = 0, total = 0;
+    if (mode == "sync") {
+        ok = Decryptor::decryptAsync().get();
+        startup_work(work_us);
+        ok = first_request() && ok;
+        ttfr = total = now_ns() - t0;
+    } else {
+        if (mode == "async-profile" && !Decryptor::setProfile(profile)) return 2;
+        if (mode == "record" && !Decryptor::startProfileRecording(profile)) return 2;
+
+        std::future<bool> done = Decryptor::decryptAsync();
+        startup_work(work_us);
+        ok = first_request();
+        ttfr = now_ns() - t0;
+        ok = done.get() && ok;
+        total = now_ns() - t0;
+        if (mode == "record") ok = Decryptor::saveProfile() && ok;
+    }
+
+    // 解密完成后所有冷函数都必须可执行
+    for (size_t i = 0; i < g_bench_cold_count; i++) {
+        g_bench_cold[i]();
+    }
+
+    dprintf(out_fd, "%llu %llu\n", (unsigned long long)ttfr, (unsigned long long)total);
+    return ok ? 0 : 3;
+}
+
+// 在新进程中运行一次，子进程日志丢弃，结果经管道返回
+static bool spawn(const char* self, const std::string& mode, const std::string& profile, uint64_t work_us,
+                  uint64_t& ttfr, uint64_t& total)
+{
+    int fds[2];
+    if (pipe(fds) != 0) return false;
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        close(fds[0]);
+        int devnull = open("/dev/null", O_WRONLY);
+        if (devnull >= 0) dup2(devnull, STDOUT_FILENO);
+        std::string fd_str = std::to_string(fds[1]);
+        std::string work_str = std::to_string(work_us);
+        execl(self, self, "--child", mode.c_str(), profile.c_str(), work_str.c_str(), fd_str.c_str(), (char*)nullptr);
+        _exit(127);
+    }
+    close(fds[1]);
+
+    char buf[128] = {0};
+    ssize_t n = read(fds[0], buf, sizeof(buf) - 1);
+    close(fds[0]);
+    int status = 0;
+    waitpid(pid, &status, 0);
+    if (n <= 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        fprintf(stderr, "[async_bench] %s run failed (status 0x%x)\n", mode.c_str(), status);
+        return false;
+    }
+    unsigned long long a = 0, b = 0;
+    if (sscanf(buf, "%llu %llu", &a, &b) != 2) return false;
+    ttfr = a;
+    total = b;
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc == 6 && strcmp(argv[1], "--child") == 0) {
+        return run_child(argv[2], argv[3], strtoull(argv[4], nullptr, 10), atoi(argv[5]));
+    }
+
+    int runs = 7;
+    uint64_t work_us = 2000;
+    if (argc >= 2) runs = std::max(1, atoi(argv[1]));
+    if (argc >= 3) work_us = strtoull(argv[2], nullptr, 10);
+
+    char self[PATH_MAX] = {0};
+    if (readlink("/proc/self/exe", self, sizeof(self) - 1) <= 0) {
+        perror("[async_bench] readlink");
+        return 1;
+    }
+    const std::string profile = std::string(self) + ".profile";
+
+    uint64_t ttfr = 0, total = 0;
+    if (!spawn(self, "record", profile, work_us, ttfr, total)) {
+        return 1;
+    }
+    printf("[async_bench] recorded startup profile: %s\n", profile.c_str());
+    printf("[async_bench] %zu cold functions, startup work %llu us, %d runs per mode\n\n",
+           g_bench_cold_count, (unsigned long long)work_us, runs);
+
+    printf("%-14s %22s %22s\n", "mode", "first_request(us)", "all_decrypted(us)");
+    const char* modes[] = {"sync", "async", "async-profile"};
+    for (const char* mode : modes) {
+        std::vector<uint64_t> t_first, t_total;
+        for (int i = 0; i < runs; i++) {
+            if (!spawn(self, mode, profile, work_us, ttfr, total)) {
+                return 1;
+            }
+            t_first.push_back(ttfr);
+            t_total.push_back(total);
+        }
+        printf("%-14s %22.1f %22.1f\n", mode, median(t_first) / 1000.0, median(t_total) / 1000.0);
+    }
+    return 0;
+}
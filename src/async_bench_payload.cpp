@@ -0,0 +1,51 @@
+#include "decryptor_linux.h"
+
+// ========== async_bench 加密载荷（构建时由 encrypt_tool 加密） ==========
+// 一个真实的请求处理函数 + 一批体积很大的冷函数（nop 填充 + ret），
+// 撑大 .encrypt_text，使整段解密耗时足以和首个请求的延迟区分开
+
+#define BENCH_COLD_SIZE_STR "262144"
+
+#define BENCH_COLD_FUNC(n) \
+    __asm__(".pushsection .encrypt_text,\"ax\",@progbits\n" \
+            ".p2align 4\n" \
+            ".globl bench_cold_" #n "\n" \
+            ".hidden bench_cold_" #n "\n" \
+            ".type bench_cold_" #n ",@function\n" \
+            "bench_cold_" #n ":\n" \
+            ".fill " BENCH_COLD_SIZE_STR ",1,0x90\n" \
+            "ret\n" \
+            ".size bench_cold_" #n ",.-bench_cold_" #n "\n" \
+            ".popsection\n"); \
+    extern "C" void bench_cold_##n();
+
+#define BENCH_COLD_8(p) \
+    BENCH_COLD_FUNC(p##0) BENCH_COLD_FUNC(p##1) BENCH_COLD_FUNC(p##2) BENCH_COLD_FUNC(p##3) \
+    BENCH_COLD_FUNC(p##4) BENCH_COLD_FUNC(p##5) BENCH_COLD_FUNC(p##6) BENCH_COLD_FUNC(p##7)
+
+BENCH_COLD_8(1) BENCH_COLD_8(2) BENCH_COLD_8(3) BENCH_COLD_8(4)
+BENCH_COLD_8(5) BENCH_COLD_8(6) BENCH_COLD_8(7) BENCH_COLD_8(8)
+
+#define BENCH_COLD_REF_8(p) \
+    bench_cold_##p##0, bench_cold_##p##1, bench_cold_##p##2, bench_cold_##p##3, \
+    bench_cold_##p##4, bench_cold_##p##5, bench_cold_##p##6, bench_cold_##p##7
+
+extern void (*const g_bench_cold[])();
+extern const size_t g_bench_cold_count;
+
+void (*const g_bench_cold[])() = {
+    BENCH_COLD_REF_8(1), BENCH_COLD_REF_8(2), BENCH_COLD_REF_8(3), BENCH_COLD_REF_8(4),
+    BENCH_COLD_REF_8(5), BENCH_COLD_REF_8(6), BENCH_COLD_REF_8(7), BENCH_COLD_REF_8(8)
+};
+const size_t g_bench_cold_count = sizeof(g_bench_cold) / sizeof(g_bench_cold[0]);
+
+// 首个请求的处理函数
+CRYPT_FUNC __attribute__((noinline)) uint64_t bench_handle_request(uint64_t seed)
+{
+    uint64_t h = seed ^ 0x9E3779B97F4A7C15ull;
+    for (int i = 0; i < 64; i++) {
+        h ^= h >> 33;
+        h *= 0xFF51AFD7ED558CCDull;
+    }
+    return h;
+}
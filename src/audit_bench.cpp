@@ -0,0 +1,168 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+// ===================== LD_AUDIT 自动解密 dlopen 延迟基准 =====================
+// 插件 audit_bench_plugin.cpp 的构造函数位于 .encrypt_text；构建出加密与未加密两个版本。
+// 每种配置在新进程中进行：把插件复制成 copies 份，反复 rounds 轮全部 dlopen、校验构造函数结果、再全部 dlclose，
+// 统计单次 dlopen / dlclose 的中位数与 p99：
+//   plain            ：未加密插件，无审计模块（基线）
+//   plain+audit      ：未加密插件，LD_AUDIT（未加密对象的固定开销）
+//   encrypted+audit  ：加密插件，LD_AUDIT（装载时整段解密）
+// 用法：audit_bench [rounds] [copies]
+
+#ifndef AUDIT_BENCH_PLAIN_PLUGIN
+#define AUDIT_BENCH_PLAIN_PLUGIN "libaudit_bench_plugin_plain.so"
+#endif
+#ifndef AUDIT_BENCH_ENC_PLUGIN
+#define AUDIT_BENCH_ENC_PLUGIN "libaudit_bench_plugin.so"
+#endif
+#ifndef AUDIT_BENCH_AUDIT_LIB
+#define AUDIT_BENCH_AUDIT_LIB "libencrypt_audit.so"
+#endif
+
+typedef uint64_t (*PluginValueFn)();
+
+static inline uint64_t now_ns()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static uint64_t percentile(std::vector<uint64_t>& v, double p)
+{
+    std::sort(v.begin(), v.end());
+    return v[std::min(v.size() - 1, (size_t)(v.size() * p))];
+}
+
+// 与插件构造函数相同的明文实现
+static uint64_t reference_value()
+{
+    uint64_t h = 0x9E3779B97F4A7C15ull;
+    for (int i = 0; i < 8; i++) {
+        h ^= h >> 33;
+        h *= 0xFF51AFD7ED558CCDull;
+    }
+    return h;
+}
+
+static bool copy_file(const char* src, const std::string& dst)
+{
+    FILE* in = fopen(src, "rb");
+    if (!in) return false;
+    std::vector<char> data;
+    char buf[65536];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), in)) > 0) {
+        data.insert(data.end(), buf, buf + n);
+    }
+    fclose(in);
+    const int fd = open(dst.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0755);
+    if (fd < 0) return false;
+    const bool ok = write(fd, data.data(), data.size()) == (ssize_t)data.size();
+    close(fd);
+    return ok;
+}
+
+static int run_child(const char* label, const char* plugin, size_t rounds, size_t copies)
+{
+    char dir_tmpl[] = "/tmp/audit_bench_XXXXXX";
+    if (!mkdtemp(dir_tmpl)) {
+        perror("mkdtemp");
+        return 1;
+    }
+    std::vector<std::string> paths(copies);
+    for (size_t i = 0; i < copies; i++) {
+        paths[i] = std::string(dir_tmpl) + "/libplugin_" + std::to_string(i) + ".so";
+        if (!copy_file(plugin, paths[i])) {
+            fprintf(stderr, "[audit_bench] Cannot copy %s\n", plugin);
+            return 1;
+        }
+    }
+
+    const uint64_t expected = reference_value();
+    std::vector<uint64_t> open_ns, close_ns;
+    std::vector<void*> handles(copies);
+    bool ok = true;
+    for (size_t r = 0; r < rounds && ok; r++) {
+        for (size_t i = 0; i < copies; i++) {
+            const uint64_t t0 = now_ns();
+            handles[i] = dlopen(paths[i].c_str(), RTLD_NOW | RTLD_LOCAL);
+            open_ns.push_back(now_ns() - t0);
+            PluginValueFn fn = handles[i] ? (PluginValueFn)dlsym(handles[i], "audit_plugin_value") : nullptr;
+            if (!fn || fn() != expected) {
+                fprintf(stderr, "[audit_bench] %s: constructor check failed for %s (%s)\n",
+                        label, paths[i].c_str(), handles[i] ? "bad value" : dlerror());
+                ok = false;
+                break;
+            }
+        }
+        for (size_t i = 0; i < copies && handles[i]; i++) {
+            const uint64_t t0 = now_ns();
+            dlclose(handles[i]);
+            close_ns.push_back(now_ns() - t0);
+            handles[i] = nullptr;
+        }
+    }
+
+    for (size_t i = 0; i < copies; i++) {
+        unlink(paths[i].c_str());
+    }
+    rmdir(dir_tmpl);
+    if (!ok) return 1;
+
+    printf("%-18s %10.1f %10.1f %10.1f %10.1f   OK\n", label,
+           percentile(open_ns, 0.5) / 1e3, percentile(open_ns, 0.99) / 1e3,
+           percentile(close_ns, 0.5) / 1e3, percentile(close_ns, 0.99) / 1e3);
+    fflush(stdout);
+    return 0;
+}
+
+static bool spawn(const char* self, const char* label, const char* plugin, bool audit,
+                  const std::string& rounds, const std::string& copies)
+{
+    fflush(stdout);
+    const pid_t pid = fork();
+    if (pid == 0) {
+        if (audit) {
+            setenv("LD_AUDIT", AUDIT_BENCH_AUDIT_LIB, 1);
+        } else {
+            unsetenv("LD_AUDIT");
+        }
+        execl(self, self, "--child", label, plugin, rounds.c_str(), copies.c_str(), (char*)nullptr);
+        _exit(127);
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        printf("%-18s failed (status 0x%x)\n", label, status);
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc == 6 && strcmp(argv[1], "--child") == 0) {
+        return run_child(argv[2], argv[3], strtoul(argv[4], nullptr, 10), strtoul(argv[5], nullptr, 10));
+    }
+
+    const std::string rounds = argc > 1 ? argv[1] : "20";
+    const std::string copies = argc > 2 ? argv[2] : "50";
+    printf("dlopen/dlclose latency, %s rounds x %s plugin copies (us)\n", rounds.c_str(), copies.c_str());
+    printf("%-18s %10s %10s %10s %10s\n", "mode", "open p50", "open p99", "close p50", "close p99");
+
+    bool ok = spawn(argv[0], "plain", AUDIT_BENCH_PLAIN_PLUGIN, false, rounds, copies);
+    ok = spawn(argv[0], "plain+audit", AUDIT_BENCH_PLAIN_PLUGIN, true, rounds, copies) && ok;
+    ok = spawn(argv[0], "encrypted+audit", AUDIT_BENCH_ENC_PLUGIN, true, rounds, copies) && ok;
+    return ok ? 0 : 1;
+}
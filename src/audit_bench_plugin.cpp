@@ -0,0 +1,30 @@
+#include "decryptor_linux.h"
+
+// ========== audit_bench 插件载荷（构建时由 encrypt_tool 加密后链接为SO；另有未加密版本作对照） ==========
+// 构造函数本身位于 .encrypt_text：只有在构造函数执行前完成解密（LD_AUDIT）时才能正常装载
+
+__asm__(".pushsection .encrypt_text,\"ax\",@progbits\n"
+        ".p2align 4\n"
+        ".type audit_plugin_cold,@function\n"
+        "audit_plugin_cold:\n"
+        ".fill 65536,1,0x90\n"
+        "ret\n"
+        ".size audit_plugin_cold,.-audit_plugin_cold\n"
+        ".popsection\n");
+
+static uint64_t g_ctor_value = 0;
+
+CRYPT_FUNC __attribute__((constructor, noinline)) static void audit_plugin_init()
+{
+    uint64_t h = 0x9E3779B97F4A7C15ull;
+    for (int i = 0; i < 8; i++) {
+        h ^= h >> 33;
+        h *= 0xFF51AFD7ED558CCDull;
+    }
+    g_ctor_value = h;
+}
+
+extern "C" uint64_t audit_plugin_value()
+{
+    return g_ctor_value;
+}
@@ -0,0 +1,148 @@
+#include "auto_decrypt.h"
+#include "decryptor_linux.h"
+#include "encrypt_table.h"
+#include "decrypt_log.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <errno.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+// ===================== 内部实现 =====================
+namespace {
+
+// 地址所在 PT_LOAD 的映射权限（用于解密/改写后恢复）
+static int segment_prot(const ImageInfo& image, uintptr_t addr)
+{
+    for (uint16_t i = 0; i < image.phnum; i++) {
+        const ElfW(Phdr)& ph = image.phdr[i];
+        if (ph.p_type != PT_LOAD) continue;
+        const uintptr_t start = image.load_bias + ph.p_vaddr;
+        if (addr >= start && addr < start + ph.p_memsz) {
+            return ((ph.p_flags & PF_R) ? PROT_READ : 0) | ((ph.p_flags & PF_W) ? PROT_WRITE : 0) |
+                   ((ph.p_flags & PF_X) ? PROT_EXEC : 0);
+        }
+    }
+    return -1;
+}
+
+// 临时改写 [start, start+len) 所在页，结束后恢复为所在段的权限
+struct PageWindow {
+    uintptr_t page_start;
+    size_t page_len;
+    int prot;
+
+    PageWindow(const ImageInfo& image, uintptr_t start, size_t len)
+    {
+        const uintptr_t page_mask = ~((uintptr_t)sysconf(_SC_PAGESIZE) - 1);
+        page_start = start & page_mask;
+        page_len = ((start + len + ~page_mask) & page_mask) - page_start;
+        prot = segment_prot(image, start);
+    }
+
+    bool open() const
+    {
+        return prot >= 0 && mprotect((void*)page_start, page_len, PROT_READ | PROT_WRITE) == 0;
+    }
+
+    bool close() const
+    {
+        return mprotect((void*)page_start, page_len, prot) == 0;
+    }
+};
+
+} // namespace
+
+// ===================== AutoDecrypt 实现 =====================
+bool AutoDecrypt::hasMarker(const ImageInfo& image)
+{
+    static const char owner[] = ENCRYPT_NOTE_OWNER;
+
+    for (uint16_t i = 0; image.phdr && i < image.phnum; i++) {
+        const ElfW(Phdr)& ph = image.phdr[i];
+        if (ph.p_type != PT_NOTE) continue;
+        const size_t align = ph.p_align >= 8 ? 8 : 4;
+        const uint8_t* p = (const uint8_t*)(image.load_bias + ph.p_vaddr);
+        const uint8_t* end = p + ph.p_memsz;
+
+        while (p + sizeof(ElfW(Nhdr)) <= end) {
+            const ElfW(Nhdr)* nhdr = (const ElfW(Nhdr)*)p;
+            const size_t desc_off = (sizeof(ElfW(Nhdr)) + nhdr->n_namesz + align - 1) & ~(align - 1);
+            if (nhdr->n_type == ENCRYPT_NOTE_TYPE && nhdr->n_namesz == sizeof(owner) &&
+                memcmp(p + sizeof(ElfW(Nhdr)), owner, sizeof(owner)) == 0) {
+                return true;
+            }
+            p += (desc_off + nhdr->n_descsz + align - 1) & ~(align - 1);
+        }
+    }
+    return false;
+}
+
+AutoDecryptResult AutoDecrypt::decryptImage(const ImageInfo& image)
+{
+    if (!hasMarker(image)) return AUTO_NOT_ENCRYPTED;
+
+    EncryptTable table;
+    if (!table.loadImage(image)) return table.rejectedCount() ? AUTO_FAILED : AUTO_NOT_ENCRYPTED;
+    if (table.allDecrypted()) return AUTO_ALREADY_DECRYPTED;
+
+    uintptr_t start = 0;
+    size_t size = 0;
+    table.extent(start, size);
+
+    // 1. 整段解密（动态链接器持有装载锁，不使用并行解密线程）
+    const PageWindow text(image, start, size);
+    if (!text.open()) {
+        DECRYPT_LOG_ERROR("[AutoDecrypt] Failed to unprotect %s: %s\n", image.path, strerror(errno));
+        return AUTO_FAILED;
+    }
+    PlainChecksum sums;
+    table.decryptPendingChecked(start, size, runtime_cipher_key(), sums);
+    size_t bad = 0;
+    const bool verified = sums.verify(table, bad);
+    if (!verified) {
+        // 同一密钥流再异或一次恢复为密文，描述符不标记已解密
+        const EncryptBlock& b = table.block(bad);
+        DECRYPT_LOG_ERROR("[AutoDecrypt] Plaintext CRC32C mismatch in %s block %zu at 0x%lx (%zu bytes)\n",
+                          image.path, bad, (unsigned long)b.sec_addr, b.sec_size);
+        table.decryptPending(start, size, runtime_cipher_key());
+    }
+    flush_cache((uint8_t*)start, size);
+    if (!text.close()) {
+        DECRYPT_LOG_ERROR("[AutoDecrypt] Failed to restore protection of %s: %s\n", image.path, strerror(errno));
+        return AUTO_FAILED;
+    }
+    if (!verified) return AUTO_BAD_CHECKSUM;
+
+    // 2. 在映射中的描述符头上标记已解密（各目标文件的 note 链接后相邻）
+    uintptr_t hdr_lo = UINTPTR_MAX, hdr_hi = 0;
+    for (size_t i = 0; i < table.blockCount(); i++) {
+        const uintptr_t h = (uintptr_t)table.block(i).header;
+        hdr_lo = std::min(hdr_lo, h);
+        hdr_hi = std::max(hdr_hi, h + sizeof(EncryptTableHeader));
+    }
+    const PageWindow notes(image, hdr_lo, hdr_hi - hdr_lo);
+    if (!notes.open()) {
+        DECRYPT_LOG_ERROR("[AutoDecrypt] Failed to mark descriptor of %s: %s\n", image.path, strerror(errno));
+        return AUTO_FAILED;
+    }
+    for (size_t i = 0; i < table.blockCount(); i++) {
+        EncryptTableHeader* hdr = const_cast<EncryptTableHeader*>(table.block(i).header);
+        hdr->flags |= ENCRYPT_TABLE_FLAG_DECRYPTED;
+    }
+    notes.close();
+    return AUTO_DECRYPTED;
+}
+
+const char* AutoDecrypt::resultName(AutoDecryptResult result)
+{
+    switch (result) {
+        case AUTO_NOT_ENCRYPTED:        return "not-encrypted";
+        case AUTO_DECRYPTED:            return "decrypted";
+        case AUTO_ALREADY_DECRYPTED:    return "already-decrypted";
+        case AUTO_FAILED:               return "failed";
+        case AUTO_BAD_CHECKSUM:         return "bad-checksum";
+    }
+    return "unknown";
+}
@@ -0,0 +1,140 @@
+#include "image_locator.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <climits>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+// ===================== 镜像基址查找基准（/proc/self/maps 解析 vs dl_iterate_phdr） =====================
+// 用一个临时文件映射 N 次（默认10000）制造大量带路径的 r-xp 映射，分别测量：
+//   legacy     ：原 find_executable_path 的 /proc/self/maps 逐行解析（按名字查找时扫过所有合成映射）
+//   locator    ：ImageLocator（dl_iterate_phdr，按地址/按名字）
+// 同时给出 legacy 在本进程（PIE）上求得的基址与真实装载偏移的差异。
+// 用法：base_bench [mappings]
+
+static inline uint64_t now_ns()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+// 原实现（取第一个匹配的 r-xp 映射起始地址作为基址）
+static bool legacy_find_base(const char* target_name, uintptr_t& base, char* path, size_t path_len)
+{
+    const bool has_target_name = target_name && strlen(target_name) > 0;
+
+    FILE* f = fopen("/proc/self/maps", "r");
+    if (!f) return false;
+
+    bool found = false;
+    char line[1024];
+    while (fgets(line, sizeof(line), f)) {
+        if (strstr(line, " r-xp ") == nullptr) continue;
+
+        char* p_path = strchr(line, '/');
+        if (!p_path) continue;
+
+        char pathbuf[PATH_MAX] = {0};
+        if (sscanf(p_path, "%s", pathbuf) != 1) continue;
+        if (pathbuf[0] == '[') continue;
+
+        if (has_target_name && strstr(pathbuf, target_name) == nullptr) {
+            continue;
+        }
+
+        uintptr_t addr = 0;
+        if (sscanf(line, "%lx-", &addr) != 1 || addr == 0) continue;
+
+        snprintf(path, path_len, "%s", pathbuf);
+        base = addr;
+        found = true;
+        break;
+    }
+
+    fclose(f);
+    return found;
+}
+
+template <typename Fn>
+static double time_us(int iters, Fn fn)
+{
+    const uint64_t t0 = now_ns();
+    for (int i = 0; i < iters; i++) {
+        fn();
+    }
+    return (now_ns() - t0) / 1000.0 / iters;
+}
+
+static void report(size_t mappings)
+{
+    char path[PATH_MAX] = {0};
+    uintptr_t base = 0;
+    ImageInfo image;
+
+    const int legacy_iters = mappings > 1000 ? 50 : 2000;
+    const int locator_iters = 20000;
+
+    const double legacy_exe = time_us(legacy_iters, [&] { legacy_find_base(nullptr, base, path, sizeof(path)); });
+    const double legacy_libc = time_us(legacy_iters, [&] { legacy_find_base("libc.so", base, path, sizeof(path)); });
+    const double loc_addr = time_us(locator_iters, [&] { ImageLocator::findByAddress((const void*)&report, image); });
+    const double loc_libc = time_us(locator_iters, [&] { ImageLocator::findByName("libc.so", image); });
+
+    printf("%-10zu %14.2f %14.2f %14.3f %14.3f\n", mappings, legacy_exe, legacy_libc, loc_addr, loc_libc);
+}
+
+int main(int argc, char** argv)
+{
+    size_t mappings = 10000;
+    if (argc >= 2) {
+        mappings = strtoull(argv[1], nullptr, 10);
+    }
+
+    // 正确性：legacy 取到的“基址”与真实装载偏移
+    ImageInfo self;
+    char path[PATH_MAX] = {0};
+    uintptr_t legacy_base = 0;
+    if (!ImageLocator::findByAddress((const void*)&main, self) || !legacy_find_base(nullptr, legacy_base, path, sizeof(path))) {
+        fprintf(stderr, "[base_bench] image lookup failed\n");
+        return 1;
+    }
+    printf("[base_bench] self: %s\n", self.path);
+    printf("[base_bench] load_bias (dl_iterate_phdr) = 0x%lx, legacy base (first r-xp) = 0x%lx%s\n",
+           (unsigned long)self.load_bias, (unsigned long)legacy_base,
+           legacy_base == self.load_bias ? "" : "  <-- wrong for PIE");
+
+    printf("\n%-10s %14s %14s %14s %14s\n", "mappings", "legacy_exe(us)", "legacy_so(us)", "locator_addr", "locator_so");
+    report(0);
+
+    char tmpl[] = "/tmp/base_bench_XXXXXX";
+    int fd = mkstemp(tmpl);
+    if (fd < 0 || ftruncate(fd, 4096) != 0) {
+        perror("[base_bench] temp file");
+        return 1;
+    }
+    unlink(tmpl);
+
+    // 每次映射后留一页空洞，避免相邻映射合并
+    std::vector<void*> maps;
+    for (size_t i = 0; i < mappings; i++) {
+        void* hole = mmap(nullptr, 8192, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (hole == MAP_FAILED) break;
+        void* p = mmap(hole, 4096, PROT_READ | PROT_EXEC, MAP_PRIVATE | MAP_FIXED, fd, 0);
+        munmap((uint8_t*)hole + 4096, 4096);
+        if (p == MAP_FAILED) break;
+        maps.push_back(p);
+    }
+    close(fd);
+    report(maps.size());
+
+    for (void* p : maps) {
+        munmap(p, 4096);
+    }
+    return 0;
+}
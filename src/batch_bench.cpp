@@ -0,0 +1,209 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+
+// ===================== encrypt_tool 批量模式吞吐基准 =====================
+// 把模板目标文件复制成 files 份，分散到 dirs 个子目录（两级），分别用 -j1（串行路径）与 -jN
+// 运行 encrypt_tool -r，报告 files/s 与 MB/s；并校验两次运行的输出文件逐字节相同、工具日志
+// （除吞吐量一行外）完全一致。
+// 最后模拟增量构建：把 -jN 树中每 100 个文件换回明文模板后再运行一次，已加密文件应按标记跳过，
+// 耗时与改动量成正比，结果仍与全量加密一致。
+// 用法：batch_bench [files] [dirs] [jobs]
+
+#ifndef BATCH_BENCH_TOOL
+#define BATCH_BENCH_TOOL "encrypt_tool"
+#endif
+#ifndef BATCH_BENCH_TEMPLATE
+#define BATCH_BENCH_TEMPLATE "template.o"
+#endif
+
+static inline uint64_t now_ns()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static bool read_file(const std::string& path, std::vector<char>& data)
+{
+    FILE* fp = fopen(path.c_str(), "rb");
+    if (!fp) return false;
+    data.clear();
+    char buf[65536];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), fp)) > 0) {
+        data.insert(data.end(), buf, buf + n);
+    }
+    fclose(fp);
+    return true;
+}
+
+static bool write_file(const std::string& path, const std::vector<char>& data)
+{
+    const int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return false;
+    const bool ok = write(fd, data.data(), data.size()) == (ssize_t)data.size();
+    close(fd);
+    return ok;
+}
+
+static std::string file_path(const std::string& root, size_t i, size_t dirs)
+{
+    char rel[64];
+    const size_t d = i % dirs;
+    snprintf(rel, sizeof(rel), "/g%02zu/d%04zu/obj_%06zu.o", d % 16, d, i);
+    return root + rel;
+}
+
+static bool make_tree(const std::string& root, size_t files, size_t dirs, const std::vector<char>& image)
+{
+    mkdir(root.c_str(), 0755);
+    for (size_t d = 0; d < dirs; d++) {
+        char sub[64];
+        snprintf(sub, sizeof(sub), "/g%02zu", d % 16);
+        mkdir((root + sub).c_str(), 0755);
+        snprintf(sub, sizeof(sub), "/g%02zu/d%04zu", d % 16, d);
+        mkdir((root + sub).c_str(), 0755);
+    }
+    for (size_t i = 0; i < files; i++) {
+        if (!write_file(file_path(root, i, dirs), image)) return false;
+    }
+    return true;
+}
+
+// 运行 encrypt_tool，日志写入 log_path，返回耗时（纳秒），失败返回 0
+static uint64_t run_tool(const std::string& root, size_t jobs, const std::string& log_path)
+{
+    const std::string jobs_arg = std::to_string(jobs);
+    const uint64_t t0 = now_ns();
+    const pid_t pid = fork();
+    if (pid == 0) {
+        const int fd = open(log_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) _exit(127);
+        dup2(fd, STDOUT_FILENO);
+        dup2(fd, STDERR_FILENO);
+        execl(BATCH_BENCH_TOOL, BATCH_BENCH_TOOL, "-r", "-j", jobs_arg.c_str(), root.c_str(), (char*)nullptr);
+        _exit(127);
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+    const uint64_t elapsed = now_ns() - t0;
+    return (WIFEXITED(status) && WEXITSTATUS(status) == 0) ? elapsed : 0;
+}
+
+// 日志去掉吞吐量一行与目录前缀后比较
+static std::string normalized_log(const std::string& path, const std::string& root)
+{
+    std::vector<char> data;
+    read_file(path, data);
+    std::string text(data.begin(), data.end()), out;
+    size_t pos = 0;
+    while (pos < text.size()) {
+        size_t end = text.find('\n', pos);
+        if (end == std::string::npos) end = text.size();
+        std::string line = text.substr(pos, end - pos);
+        pos = end + 1;
+        if (line.find("Throughput:") != std::string::npos || line.find("[Main]") != std::string::npos) continue;
+        for (size_t p; (p = line.find(root)) != std::string::npos; ) line.replace(p, root.size(), "<root>");
+        out += line + "\n";
+    }
+    return out;
+}
+
+int main(int argc, char* argv[])
+{
+    const size_t files = argc > 1 ? strtoul(argv[1], nullptr, 10) : 2000;
+    const size_t dirs = argc > 2 ? strtoul(argv[2], nullptr, 10) : 64;
+    size_t jobs = argc > 3 ? strtoul(argv[3], nullptr, 10) : 0;
+    if (jobs == 0) jobs = sysconf(_SC_NPROCESSORS_ONLN) > 1 ? sysconf(_SC_NPROCESSORS_ONLN) : 4;
+    if (files == 0 || dirs == 0) {
+        fprintf(stderr, "usage: %s [files] [dirs] [jobs]\n", argv[0]);
+        return 1;
+    }
+
+    std::vector<char> image;
+    if (!read_file(BATCH_BENCH_TEMPLATE, image) || image.empty()) {
+        fprintf(stderr, "[batch_bench] Cannot read template object %s\n", BATCH_BENCH_TEMPLATE);
+        return 1;
+    }
+    char dir_tmpl[] = "/tmp/batch_bench_XXXXXX";
+    if (!mkdtemp(dir_tmpl)) {
+        perror("mkdtemp");
+        return 1;
+    }
+    const std::string base = dir_tmpl;
+    const double total_mb = files * (double)image.size() / (1024.0 * 1024.0);
+    printf("encrypt_tool -r: %zu objects (%.1f MB) in %zu directories, %ld CPUs\n",
+           files, total_mb, dirs, sysconf(_SC_NPROCESSORS_ONLN));
+    printf("%-8s %10s %12s %10s\n", "jobs", "time(ms)", "files/s", "MB/s");
+
+    const size_t modes[2] = {1, jobs};
+    std::string trees[2], logs[2];
+    bool ok = true;
+    for (int m = 0; m < 2; m++) {
+        trees[m] = base + "/j" + std::to_string(modes[m]);
+        logs[m] = base + "/j" + std::to_string(modes[m]) + ".log";
+        if (!make_tree(trees[m], files, dirs, image)) {
+            fprintf(stderr, "[batch_bench] Failed to create object tree\n");
+            return 1;
+        }
+        sync();
+        const uint64_t ns = run_tool(trees[m], modes[m], logs[m]);
+        if (ns == 0) {
+            printf("%-8zu failed (see %s)\n", modes[m], logs[m].c_str());
+            ok = false;
+            continue;
+        }
+        printf("%-8zu %10.1f %12.1f %10.1f\n", modes[m], ns / 1e6, files / (ns / 1e9), total_mb / (ns / 1e9));
+    }
+
+    // 输出文件与日志一致性
+    size_t mismatched = 0;
+    std::vector<char> a, b;
+    for (size_t i = 0; ok && i < files; i++) {
+        if (!read_file(file_path(trees[0], i, dirs), a) || !read_file(file_path(trees[1], i, dirs), b) || a != b) {
+            mismatched++;
+        }
+    }
+    const bool same_log = ok && normalized_log(logs[0], trees[0]) == normalized_log(logs[1], trees[1]);
+    printf("outputs identical: %s (%zu mismatched), logs identical: %s\n",
+           ok && mismatched == 0 ? "yes" : "no", mismatched, same_log ? "yes" : "no");
+
+    // 增量：约 1% 的文件变回明文
+    bool incremental_ok = ok;
+    if (ok) {
+        size_t changed = 0;
+        for (size_t i = 0; i < files; i += 100, changed++) {
+            write_file(file_path(trees[1], i, dirs), image);
+        }
+        const std::string log = base + "/incremental.log";
+        const uint64_t ns = run_tool(trees[1], jobs, log);
+        size_t remismatched = 0;
+        for (size_t i = 0; ns && i < files; i++) {
+            if (!read_file(file_path(trees[0], i, dirs), a) || !read_file(file_path(trees[1], i, dirs), b) || a != b) {
+                remismatched++;
+            }
+        }
+        read_file(log, a);
+        char expect[96];
+        snprintf(expect, sizeof(expect), "Already encrypted (skipped): %zu ", files - changed);
+        const bool skipped = std::string(a.begin(), a.end()).find(expect) != std::string::npos;
+        incremental_ok = ns && remismatched == 0 && skipped;
+        printf("incremental: %zu changed, %.1f ms, outputs identical: %s, unchanged skipped: %s\n",
+               changed, ns / 1e6, ns && remismatched == 0 ? "yes" : "no", skipped ? "yes" : "no");
+    }
+    ok = ok && incremental_ok;
+
+    if (ok && mismatched == 0 && same_log) {
+        const std::string cmd = "rm -rf '" + base + "'";
+        if (system(cmd.c_str()) != 0) fprintf(stderr, "[batch_bench] Failed to remove %s\n", base.c_str());
+    }
+    return ok && mismatched == 0 && same_log ? 0 : 1;
+}
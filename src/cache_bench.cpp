@@ -0,0 +1,122 @@
+#include "cache_sync.h"
+#include "xor_kernel.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <sys/mman.h>
+
+// ===================== 指令缓存同步策略基准 =====================
+// 1) 各策略在不同段大小下的同步耗时
+// 2) 同步后解密函数的首次调用延迟（区域填满 ret 指令，每页一个“函数”）
+
+typedef void (*RetFn)(void);
+
+static const uint8_t BENCH_KEY[] = {0x12, 0x34, 0x56, 0x78, 0x90, 0xAB, 0xCD, 0xEF};
+
+static inline uint64_t now_ns()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static uint64_t median(std::vector<uint64_t>& v)
+{
+    std::sort(v.begin(), v.end());
+    return v[v.size() / 2];
+}
+
+static std::string size_str(size_t size)
+{
+    return size >= (1 << 20) ? std::to_string(size >> 20) + "MB" : std::to_string(size >> 10) + "KB";
+}
+
+struct BenchResult {
+    uint64_t sync_ns;
+    uint64_t first_call_ns;
+    uint64_t per_page_call_ns;
+};
+
+static BenchResult run_one(CacheSyncStrategy& s, uint8_t* region, size_t size, int reps)
+{
+    const size_t page = 4096;
+    const size_t pages = size / page;
+    std::vector<uint64_t> sync_ns, first_ns, page_ns;
+
+    for (int r = 0; r < reps; r++) {
+        // 模拟解密：两次异或写回原始 ret 指令，保证可执行内容不变
+        XorKernel::apply(region, size, BENCH_KEY);
+        XorKernel::apply(region, size, BENCH_KEY);
+
+        uint64_t t0 = now_ns();
+        s.sync(region, size);
+        uint64_t t1 = now_ns();
+        sync_ns.push_back(t1 - t0);
+
+        uint64_t t2 = now_ns();
+        ((RetFn)(void*)region)();
+        uint64_t t3 = now_ns();
+        first_ns.push_back(t3 - t2);
+
+        uint64_t t4 = now_ns();
+        for (size_t p = 1; p < pages; p++) {
+            ((RetFn)(void*)(region + p * page))();
+        }
+        uint64_t t5 = now_ns();
+        page_ns.push_back(pages > 1 ? (t5 - t4) / (pages - 1) : 0);
+    }
+
+    BenchResult res;
+    res.sync_ns = median(sync_ns);
+    res.first_call_ns = median(first_ns);
+    res.per_page_call_ns = median(page_ns);
+    return res;
+}
+
+int main(int argc, char** argv)
+{
+    size_t max_size = (size_t)64 << 20;
+    if (argc >= 2) {
+        max_size = (size_t)strtoull(argv[1], nullptr, 10) << 20;  // 单位MB
+        if (max_size < 4096) max_size = 4096;
+    }
+
+    uint8_t* region = (uint8_t*)mmap(nullptr, max_size, PROT_READ | PROT_WRITE | PROT_EXEC,
+                                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (region == MAP_FAILED) {
+        perror("[cache_bench] mmap RWX");
+        return 1;
+    }
+    memset(region, 0xC3, max_size);  // ret
+
+    std::vector<CacheSyncStrategy*> strategies;
+    for (int k = CACHE_SYNC_NONE; k < CACHE_SYNC_COUNT; k++) {
+        CacheSyncStrategy& s = CacheSync::get((CacheSyncKind)k);
+        if (s.kind() != (CacheSyncKind)k || !s.available()) {
+            printf("[cache_bench] strategy %-22s n/a\n", s.kind() == (CacheSyncKind)k ? s.name() : "(arch)");
+            continue;
+        }
+        if (k == CACHE_SYNC_MEMBARRIER && !CacheSync::select(CACHE_SYNC_MEMBARRIER)) {
+            printf("[cache_bench] strategy %-22s registration failed\n", s.name());
+            continue;
+        }
+        strategies.push_back(&s);
+    }
+
+    printf("\n%-8s %-22s %14s %16s %18s\n", "size", "strategy", "sync(ns)", "first_call(ns)", "per_page_call(ns)");
+    for (size_t size = 4096; size <= max_size; size *= 4) {
+        const int reps = size <= ((size_t)1 << 20) ? 21 : 5;
+        for (CacheSyncStrategy* s : strategies) {
+            BenchResult r = run_one(*s, region, size, reps);
+            printf("%-8s %-22s %14lu %16lu %18lu\n", size_str(size).c_str(), s->name(),
+                   (unsigned long)r.sync_ns, (unsigned long)r.first_call_ns, (unsigned long)r.per_page_call_ns);
+        }
+    }
+
+    munmap(region, max_size);
+    return 0;
+}
@@ -0,0 +1,249 @@
+#include "cache_sync.h"
+#include <atomic>
+#include <unistd.h>
+#include <errno.h>
+#if defined(__linux__)
+#include <sys/syscall.h>
+#include <linux/membarrier.h>
+#endif
+#if defined(__x86_64__)
+#include <cpuid.h>
+#endif
+
+// ===================== 各架构策略实现 =====================
+namespace {
+
+// membarrier 只有 Linux 有；其他系统上 membarrier 策略不可用
+static inline int sys_membarrier(int cmd, unsigned int flags)
+{
+#if defined(__linux__) && defined(__NR_membarrier)
+    return (int)syscall(__NR_membarrier, cmd, flags, 0);
+#else
+    (void)cmd; (void)flags;
+    errno = ENOSYS;
+    return -1;
+#endif
+}
+
+// x86：指令缓存与数据写入由硬件保持一致（SDM 8.1.3），只需阻止编译器重排
+class X86NoopSync : public CacheSyncStrategy {
+public:
+    CacheSyncKind kind() const override { return CACHE_SYNC_NONE; }
+    const char* name() const override { return "none"; }
+    bool available() const override {
+#if defined(__x86_64__)
+        return true;
+#else
+        return false;
+#endif
+    }
+    void sync(uint8_t* start, size_t len) override {
+        (void)start; (void)len;
+        __asm__ __volatile__("" ::: "memory");
+    }
+};
+
+// x86：跨修改代码的文档化保证——写入后执行一条串行化指令
+class X86SerializeSync : public CacheSyncStrategy {
+public:
+    X86SerializeSync() {
+#if defined(__x86_64__)
+        unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+        if (__get_cpuid_max(0, nullptr) >= 7) {
+            __cpuid_count(7, 0, eax, ebx, ecx, edx);
+            m_has_serialize = (edx & bit_SERIALIZE) != 0;
+        }
+#endif
+    }
+    CacheSyncKind kind() const override { return CACHE_SYNC_SERIALIZE; }
+    const char* name() const override { return "serialize"; }
+    bool available() const override {
+#if defined(__x86_64__)
+        return true;
+#else
+        return false;
+#endif
+    }
+    void sync(uint8_t* start, size_t len) override {
+        (void)start; (void)len;
+#if defined(__x86_64__)
+        if (m_has_serialize) {
+            __asm__ __volatile__(".byte 0x0f, 0x01, 0xe8" ::: "memory");  // serialize
+        } else {
+            unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+            __cpuid(0, eax, ebx, ecx, edx);
+            __asm__ __volatile__("" ::: "memory");
+        }
+#endif
+    }
+private:
+    bool m_has_serialize = false;
+};
+
+// x86：旧实现，逐行clflush会把刚写入的代码逐出缓存，首次执行需要重新从内存取指
+class X86ClflushSync : public CacheSyncStrategy {
+public:
+    CacheSyncKind kind() const override { return CACHE_SYNC_CLFLUSH; }
+    const char* name() const override { return "clflush"; }
+    bool available() const override {
+#if defined(__x86_64__)
+        return true;
+#else
+        return false;
+#endif
+    }
+    void sync(uint8_t* start, size_t len) override {
+#if defined(__x86_64__)
+        __builtin___clear_cache((char*)start, (char*)(start + len));
+        const size_t cache_line = 64;
+        for (size_t i = 0; i < len; i += cache_line) {
+            __builtin_ia32_clflush(start + i);
+        }
+        __sync_synchronize();
+#else
+        (void)start; (void)len;
+#endif
+    }
+};
+
+// aarch64：按CTR_EL0给出的行大小清数据缓存到PoU，再失效指令缓存
+class Arm64DcIcSync : public CacheSyncStrategy {
+public:
+    CacheSyncKind kind() const override { return CACHE_SYNC_ARM64_DC_IC; }
+    const char* name() const override { return "dc-cvau/ic-ivau"; }
+    bool available() const override {
+#if defined(__aarch64__)
+        return true;
+#else
+        return false;
+#endif
+    }
+    void sync(uint8_t* start, size_t len) override {
+#if defined(__aarch64__)
+        uint64_t ctr = 0;
+        __asm__ __volatile__("mrs %0, ctr_el0" : "=r"(ctr));
+        const uintptr_t dline = (uintptr_t)4 << ((ctr >> 16) & 0xF);
+        const uintptr_t iline = (uintptr_t)4 << (ctr & 0xF);
+        const uintptr_t end = (uintptr_t)start + len;
+
+        // CTR_EL0.IDC=1：数据缓存清理到PoU不是必须的
+        if (!((ctr >> 28) & 1)) {
+            for (uintptr_t p = (uintptr_t)start & ~(dline - 1); p < end; p += dline) {
+                __asm__ __volatile__("dc cvau, %0" :: "r"(p) : "memory");
+            }
+        }
+        __asm__ __volatile__("dsb ish" ::: "memory");
+
+        // CTR_EL0.DIC=1：指令缓存失效不是必须的
+        if (!((ctr >> 29) & 1)) {
+            for (uintptr_t p = (uintptr_t)start & ~(iline - 1); p < end; p += iline) {
+                __asm__ __volatile__("ic ivau, %0" :: "r"(p) : "memory");
+            }
+            __asm__ __volatile__("dsb ish" ::: "memory");
+        }
+        __asm__ __volatile__("isb" ::: "memory");
+#else
+        __builtin___clear_cache((char*)start, (char*)(start + len));
+#endif
+    }
+};
+
+// 已有其他线程在运行时：本线程先做架构同步，再用membarrier让所有线程执行一次core串行化
+class MembarrierSync : public CacheSyncStrategy {
+public:
+    explicit MembarrierSync(CacheSyncStrategy& local) : m_local(local) {}
+
+    CacheSyncKind kind() const override { return CACHE_SYNC_MEMBARRIER; }
+    const char* name() const override { return "membarrier-sync-core"; }
+#if defined(__linux__)
+    bool available() const override {
+        int mask = sys_membarrier(MEMBARRIER_CMD_QUERY, 0);
+        return mask > 0 && (mask & MEMBARRIER_CMD_PRIVATE_EXPEDITED_SYNC_CORE);
+    }
+    // 使用前必须注册一次（重复注册无害，并发调用各自注册即可）
+    bool registerProcess() {
+        if (m_registered.load(std::memory_order_acquire)) return true;
+        if (!available()) return false;
+        const bool ok = sys_membarrier(MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED_SYNC_CORE, 0) == 0;
+        if (ok) m_registered.store(true, std::memory_order_release);
+        return ok;
+    }
+    void sync(uint8_t* start, size_t len) override {
+        m_local.sync(start, len);
+        if (m_registered.load(std::memory_order_acquire)) {
+            sys_membarrier(MEMBARRIER_CMD_PRIVATE_EXPEDITED_SYNC_CORE, 0);
+        }
+    }
+#else
+    bool available() const override { return false; }
+    bool registerProcess() { return false; }
+    void sync(uint8_t* start, size_t len) override { m_local.sync(start, len); }
+#endif
+private:
+    CacheSyncStrategy& m_local;
+    std::atomic<bool> m_registered{false};
+};
+
+// 多个解密线程并发读取，select() 可能同时写入
+static std::atomic<CacheSyncStrategy*> g_current(nullptr);
+
+} // namespace
+
+// ===================== CacheSync 注册表实现 =====================
+CacheSyncKind CacheSync::defaultKind()
+{
+#if defined(__aarch64__)
+    return CACHE_SYNC_ARM64_DC_IC;
+#else
+    return CACHE_SYNC_SERIALIZE;
+#endif
+}
+
+CacheSyncStrategy& CacheSync::get(CacheSyncKind kind)
+{
+    static X86NoopSync      s_none;
+    static X86SerializeSync s_serialize;
+    static X86ClflushSync   s_clflush;
+    static Arm64DcIcSync    s_dc_ic;
+
+    if (kind == CACHE_SYNC_AUTO) {
+        kind = defaultKind();
+    }
+    switch (kind) {
+        case CACHE_SYNC_NONE:        return s_none;
+        case CACHE_SYNC_SERIALIZE:   return s_serialize;
+        case CACHE_SYNC_ARM64_DC_IC: return s_dc_ic;
+        case CACHE_SYNC_CLFLUSH:     return s_clflush;
+        case CACHE_SYNC_MEMBARRIER: {
+            // 本线程部分复用架构默认策略（默认策略不能是membarrier自身）
+            static MembarrierSync s_membarrier(get(defaultKind()));
+            return s_membarrier;
+        }
+        default:                     return get(defaultKind());
+    }
+}
+
+CacheSyncStrategy& CacheSync::current()
+{
+    CacheSyncStrategy* s = g_current.load(std::memory_order_acquire);
+    if (!s) {
+        // 并发首次调用都写入同一个默认策略；select() 已写入的不覆盖
+        CacheSyncStrategy* expected = nullptr;
+        s = &get(defaultKind());
+        if (!g_current.compare_exchange_strong(expected, s, std::memory_order_acq_rel)) s = expected;
+    }
+    return *s;
+}
+
+bool CacheSync::select(CacheSyncKind kind)
+{
+    CacheSyncStrategy& s = get(kind);
+    if (!s.available()) {
+        return false;
+    }
+    if (s.kind() == CACHE_SYNC_MEMBARRIER && !static_cast<MembarrierSync&>(s).registerProcess()) {
+        return false;
+    }
+    g_current.store(&s, std::memory_order_release);
+    return true;
+}
@@ -0,0 +1,232 @@
+#include "cipher.h"
+#include <x86intrin.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// ===================== FIPS-197 附录C 已知答案测试 =====================
+template <size_t KeyLen>
+static bool known_answer(const uint8_t (&expect)[16])
+{
+    static const uint8_t key[32] = {
+        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+        0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f};
+    static const uint8_t plain[16] = {
+        0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff};
+
+    const Cipher<AesCtrPolicy, KeyLen> aes(key);
+    uint8_t out[16];
+    AesCtrPolicy::encryptBlock<KeyLen>(aes.schedule(), plain, out);
+    if (memcmp(out, expect, sizeof(out)) != 0) {
+        fprintf(stderr, "[cipher_bench] FIPS-197 AES-%zu known answer MISMATCH\n", KeyLen * 8);
+        return false;
+    }
+
+    // CTR 密钥流分组即 E(K, nonce || 大端分组序号)，各实现都要与单分组加密一致
+    const uint64_t nonce = 0x7766554433221100ULL, block = 0x0123456789abcdeULL;
+    uint8_t ctr[16];
+    for (int i = 0; i < 8; i++) {
+        ctr[i] = (uint8_t)(nonce >> (8 * i));
+        ctr[15 - i] = (uint8_t)(block >> (8 * i));
+    }
+    uint8_t expect_ks[16];
+    AesCtrPolicy::encryptBlock<KeyLen>(aes.schedule(), ctr, expect_ks);
+    for (int isa = 0; isa < AesCtrPolicy::ISA_COUNT; isa++) {
+        if (!AesCtrPolicy::isaSupported((AesIsa)isa)) continue;
+        uint8_t ks[16] = {0};
+        aes.applyWith((AesIsa)isa, ks, sizeof(ks), nonce, block * AES_BLOCK_SIZE);
+        if (memcmp(ks, expect_ks, sizeof(ks)) != 0) {
+            fprintf(stderr, "[cipher_bench] AES-%zu-CTR keystream MISMATCH isa=%s\n",
+                    KeyLen * 8, AesCtrPolicy::isaName((AesIsa)isa));
+            return false;
+        }
+    }
+    return true;
+}
+
+// 编译期展开的常量实例与运行时构造的实例轮密钥一致
+static bool constexpr_schedule()
+{
+    const Aes128CtrCipher rt128(cipher_keys::AES_KEY);
+    const Aes256CtrCipher rt256(cipher_keys::AES_KEY);
+    if (memcmp(&rt128.schedule(), &AES128_CIPHER.schedule(), sizeof(rt128.schedule())) != 0 ||
+        memcmp(&rt256.schedule(), &AES256_CIPHER.schedule(), sizeof(rt256.schedule())) != 0) {
+        fprintf(stderr, "[cipher_bench] constexpr key schedule differs from runtime expansion\n");
+        return false;
+    }
+    return true;
+}
+
+// ===================== 往返矩阵：策略 × 密钥长度 × 实现 × 对齐 × 长度 × 密钥流偏移 =====================
+// 每个实现的结果与参考实现（第0级）逐字节一致，再用默认实现解密回原文
+template <class Policy, size_t KeyLen>
+static bool round_trip(const char* name, size_t& cases)
+{
+    typedef typename Policy::Isa Isa;
+    static const size_t offsets[] = {0, 1, 5, 16, 35};
+    const size_t max_len = 300;
+    const size_t max_align = 64;
+
+    uint8_t key[KeyLen];
+    for (size_t i = 0; i < KeyLen; i++) key[i] = (uint8_t)(i * 131 + KeyLen);
+    const Cipher<Policy, KeyLen> cipher(key);
+    const uint64_t nonce = 0x0123456789abcdefULL;
+
+    std::vector<uint8_t> src(max_len + max_align);
+    for (size_t i = 0; i < src.size(); i++) src[i] = (uint8_t)(i * 29 + 3);
+    alignas(64) uint8_t ref[max_len + max_align];
+    alignas(64) uint8_t out[max_len + max_align];
+
+    for (int isa = 0; isa < Policy::ISA_COUNT; isa++) {
+        if (!Policy::isaSupported((Isa)isa)) continue;
+        for (size_t off : offsets) {
+            for (size_t align = 0; align < max_align; align++) {
+                for (size_t len = 0; len <= max_len; len++) {
+                    memcpy(ref, src.data(), sizeof(ref));
+                    memcpy(out, src.data(), sizeof(out));
+                    cipher.applyWith((Isa)0, ref + align, len, nonce, off);
+                    cipher.applyWith((Isa)isa, out + align, len, nonce, off);
+                    if (memcmp(ref, out, sizeof(out)) != 0) {
+                        fprintf(stderr, "[cipher_bench] MISMATCH %s isa=%s off=%zu align=%zu len=%zu\n",
+                                name, Policy::isaName((Isa)isa), off, align, len);
+                        return false;
+                    }
+                    cipher.apply(out + align, len, nonce, off);
+                    if (memcmp(src.data(), out, sizeof(out)) != 0) {
+                        fprintf(stderr, "[cipher_bench] ROUND TRIP FAILED %s isa=%s off=%zu align=%zu len=%zu\n",
+                                name, Policy::isaName((Isa)isa), off, align, len);
+                        return false;
+                    }
+                    cases++;
+                }
+            }
+        }
+    }
+
+    // 随机切分后各片按自身偏移解密，与整段一次解密一致（对应逐函数/逐页解密）
+    const size_t sec_size = 64 * 1024 + 7;
+    std::vector<uint8_t> whole(sec_size), pieces(sec_size);
+    for (size_t i = 0; i < sec_size; i++) whole[i] = pieces[i] = (uint8_t)(i * 131 + 7);
+    cipher.apply(whole.data(), sec_size, nonce, 0);
+    srand(1);
+    for (size_t pos = 0; pos < sec_size;) {
+        const size_t len = std::min(sec_size - pos, (size_t)(rand() % 5000 + 1));
+        cipher.apply(pieces.data() + pos, len, nonce, pos);
+        pos += len;
+        cases++;
+    }
+    if (whole != pieces) {
+        fprintf(stderr, "[cipher_bench] %s sub-range decrypt differs from whole-section decrypt\n", name);
+        return false;
+    }
+    return true;
+}
+
+static bool verify()
+{
+    static const uint8_t expect128[16] = {
+        0x69, 0xc4, 0xe0, 0xd8, 0x6a, 0x7b, 0x04, 0x30, 0xd8, 0xcd, 0xb7, 0x80, 0x70, 0xb4, 0xc5, 0x5a};
+    static const uint8_t expect256[16] = {
+        0x8e, 0xa2, 0xb7, 0xca, 0x51, 0x67, 0x45, 0xbf, 0xea, 0xfc, 0x49, 0x90, 0x4b, 0x49, 0x60, 0x89};
+    if (!known_answer<16>(expect128) || !known_answer<32>(expect256) || !constexpr_schedule()) {
+        return false;
+    }
+    printf("[cipher_bench] FIPS-197 known answers and constexpr key schedules passed\n");
+
+    size_t cases = 0;
+    const bool ok =
+        round_trip<XorPolicy, 1>("xor/1", cases) &&
+        round_trip<XorPolicy, 3>("xor/3", cases) &&
+        round_trip<XorPolicy, 8>("xor/8", cases) &&
+        round_trip<XorPolicy, 16>("xor/16", cases) &&
+        round_trip<XorPolicy, 32>("xor/32", cases) &&
+        round_trip<XorPolicy, 100>("xor/100", cases) &&
+        round_trip<AesCtrPolicy, 16>("aes128-ctr", cases) &&
+        round_trip<AesCtrPolicy, 32>("aes256-ctr", cases);
+    if (ok) {
+        printf("[cipher_bench] Round-trip matrix passed: %zu cases\n", cases);
+    }
+    return ok;
+}
+
+// ===================== cycles/byte：相同段大小下异或 vs AES-CTR =====================
+static const uint64_t BENCH_NONCE = 0x0123456789abcdefULL;
+
+static void run_xor(uint8_t* buf, size_t size) { XOR_CIPHER.apply(buf, size); }
+static void run_aes128_ni(uint8_t* buf, size_t size) { AES128_CIPHER.applyWith(AES_ISA_AESNI, buf, size, BENCH_NONCE); }
+static void run_aes256_ni(uint8_t* buf, size_t size) { AES256_CIPHER.applyWith(AES_ISA_AESNI, buf, size, BENCH_NONCE); }
+static void run_aes128_sw(uint8_t* buf, size_t size) { AES128_CIPHER.applyWith(AES_ISA_PORTABLE, buf, size, BENCH_NONCE); }
+static void run_aes256_sw(uint8_t* buf, size_t size) { AES256_CIPHER.applyWith(AES_ISA_PORTABLE, buf, size, BENCH_NONCE); }
+
+struct Variant {
+    const char* name;
+    void (*run)(uint8_t* buf, size_t size);
+    bool slow;              // 可移植 AES 慢两个数量级，按较小的数据量计时
+};
+
+static double measure_cpb(const Variant& v, uint8_t* buf, size_t size)
+{
+    const size_t target_bytes = v.slow ? ((size_t)16 << 20) : ((size_t)256 << 20);
+    size_t iters = target_bytes / size;
+    if (iters == 0) iters = 1;
+
+    v.run(buf, size);  // 预热
+
+    unsigned aux;
+    const uint64_t t0 = __rdtscp(&aux);
+    for (size_t i = 0; i < iters; i++) v.run(buf, size);
+    const uint64_t t1 = __rdtscp(&aux);
+    return (double)(t1 - t0) / ((double)size * iters);
+}
+
+int main(int argc, char** argv)
+{
+    size_t max_size = (size_t)64 << 20;
+    if (argc >= 2) {
+        max_size = (size_t)strtoull(argv[1], nullptr, 10) << 20;  // 单位MB
+        if (max_size < 4096) max_size = 4096;
+    }
+
+    printf("[cipher_bench] XOR ISA: %s, AES ISA: %s\n", XorPolicy::isaName(XorPolicy::activeIsa()),
+           AesCtrPolicy::isaName(AesCtrPolicy::activeIsa()));
+    if (!verify()) {
+        return 1;
+    }
+
+    std::vector<Variant> variants = {{"xor", run_xor, false}};
+    if (AesCtrPolicy::isaSupported(AES_ISA_AESNI)) {
+        variants.push_back({"aes128-ni", run_aes128_ni, false});
+        variants.push_back({"aes256-ni", run_aes256_ni, false});
+    }
+    variants.push_back({"aes128-sw", run_aes128_sw, true});
+    variants.push_back({"aes256-sw", run_aes256_sw, true});
+
+    uint8_t* buf = (uint8_t*)aligned_alloc(64, max_size);
+    if (!buf) {
+        fprintf(stderr, "[cipher_bench] Alloc %zu bytes failed\n", max_size);
+        return 1;
+    }
+    memset(buf, 0x5A, max_size);
+
+    printf("\n%-12s", "size");
+    for (const Variant& v : variants) printf("%12s", v.name);
+    printf("   (TSC cycles/byte)\n");
+
+    for (size_t size = 4096; size <= max_size; size *= 4) {
+        if (size >= (1 << 20)) {
+            printf("%-12s", (std::to_string(size >> 20) + "MB").c_str());
+        } else {
+            printf("%-12s", (std::to_string(size >> 10) + "KB").c_str());
+        }
+        for (const Variant& v : variants) {
+            printf("%12.3f", measure_cpb(v, buf, size));
+        }
+        printf("\n");
+    }
+
+    free(buf);
+    return 0;
+}
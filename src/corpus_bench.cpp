@@ -0,0 +1,256 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <getopt.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+// ===================== 合成语料上的加密流程基准 =====================
+// 先用 corpus_gen 生成一份明文语料（目标文件数、.encrypt_text 大小、段数、调试信息量、
+// 每个静态库/目录的文件数均可调），再在各自的新副本上依次运行：
+//   encrypt_tool -r -j1 / -jN
+//   与 encrypt.sh 相同的流程：encrypt_tool -r -j 0 -c <缓存目录> 后复制加密结果（冷缓存、热缓存各一次）
+// 每一步报告墙钟时间、CPU 时间（用户 + 内核）、峰值 RSS，以及写出字节数：
+// write 系统调用写出的字节（/proc/<pid>/io wchar，mmap 写回不计入）与实际提交到块设备的字节
+// （write_bytes，tmpfs 上为 0）。最后校验各步骤的加密结果逐字节相同。
+// 副本的准备（cp -a）不计时。
+// 用法：corpus_bench [-j jobs] [-w workdir] [corpus_gen 参数...]
+
+#ifndef CORPUS_BENCH_TOOL
+#define CORPUS_BENCH_TOOL "encrypt_tool"
+#endif
+#ifndef CORPUS_BENCH_GEN
+#define CORPUS_BENCH_GEN "corpus_gen"
+#endif
+
+struct RunStats {
+    bool ok = false;
+    uint64_t wall_ns = 0;
+    uint64_t cpu_ns = 0;
+    uint64_t max_rss_kb = 0;
+    uint64_t wchar = 0;             // write/pwrite 等系统调用写出的字节
+    uint64_t write_bytes = 0;       // 提交到块设备的字节
+
+    // 多个子进程组成的一步：时间与字节累加，RSS 取最大
+    void add(const RunStats& o) {
+        ok = ok && o.ok;
+        wall_ns += o.wall_ns;
+        cpu_ns += o.cpu_ns;
+        max_rss_kb = max_rss_kb > o.max_rss_kb ? max_rss_kb : o.max_rss_kb;
+        wchar += o.wchar;
+        write_bytes += o.write_bytes;
+    }
+};
+
+static inline uint64_t now_ns()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static inline uint64_t timeval_ns(const struct timeval& tv)
+{
+    return (uint64_t)tv.tv_sec * 1000000000ULL + (uint64_t)tv.tv_usec * 1000ULL;
+}
+
+// 子进程已退出但尚未回收时读取其 I/O 计数（包含已退出线程的累计值）
+static void read_proc_io(pid_t pid, RunStats& s)
+{
+    char path[64];
+    snprintf(path, sizeof(path), "/proc/%d/io", (int)pid);
+    FILE* fp = fopen(path, "r");
+    if (!fp) return;
+    char line[128];
+    unsigned long long v;
+    while (fgets(line, sizeof(line), fp)) {
+        if (sscanf(line, "wchar: %llu", &v) == 1) s.wchar = v;
+        if (sscanf(line, "write_bytes: %llu", &v) == 1) s.write_bytes = v;
+    }
+    fclose(fp);
+}
+
+// 运行一条命令，stdout/stderr 写入 log_path（为空则丢弃）
+static RunStats run_child(const std::vector<std::string>& args, const std::string& log_path)
+{
+    std::vector<char*> argv;
+    for (const std::string& a : args) argv.push_back(const_cast<char*>(a.c_str()));
+    argv.push_back(nullptr);
+
+    RunStats s;
+    fflush(stdout);
+    const uint64_t t0 = now_ns();
+    const pid_t pid = fork();
+    if (pid == 0) {
+        const int fd = log_path.empty() ? open("/dev/null", O_WRONLY)
+                                        : open(log_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) _exit(127);
+        dup2(fd, STDOUT_FILENO);
+        dup2(fd, STDERR_FILENO);
+        execv(argv[0], argv.data());
+        _exit(127);
+    }
+    if (pid < 0) return s;
+
+    siginfo_t si;
+    memset(&si, 0, sizeof(si));
+    waitid(P_PID, pid, &si, WEXITED | WNOWAIT);
+    s.wall_ns = now_ns() - t0;
+    read_proc_io(pid, s);
+
+    int status = 0;
+    struct rusage ru;
+    memset(&ru, 0, sizeof(ru));
+    wait4(pid, &status, 0, &ru);
+    s.ok = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    s.cpu_ns = timeval_ns(ru.ru_utime) + timeval_ns(ru.ru_stime);
+    s.max_rss_kb = (uint64_t)ru.ru_maxrss;
+    return s;
+}
+
+static bool copy_tree(const std::string& from, const std::string& to)
+{
+    return run_child({"/bin/cp", "-a", from, to}, "").ok;
+}
+
+static bool same_tree(const std::string& a, const std::string& b)
+{
+    return run_child({"/usr/bin/diff", "-rq", a, b}, "").ok;
+}
+
+static void print_row(const char* name, const RunStats& s, double corpus_mb)
+{
+    if (!s.ok) {
+        printf("%-24s failed\n", name);
+        return;
+    }
+    printf("%-24s %10.1f %10.1f %10.1f %12.2f %12.2f %10.1f\n", name, s.wall_ns / 1e6, s.cpu_ns / 1e6,
+           s.max_rss_kb / 1024.0, s.wchar / (1024.0 * 1024.0), s.write_bytes / (1024.0 * 1024.0),
+           corpus_mb / (s.wall_ns / 1e9));
+}
+
+static uint64_t tree_bytes(const std::string& root)
+{
+    const std::string cmd = "du -sb --apparent-size '" + root + "' 2>/dev/null";
+    FILE* fp = popen(cmd.c_str(), "r");
+    if (!fp) return 0;
+    unsigned long long bytes = 0;
+    if (fscanf(fp, "%llu", &bytes) != 1) bytes = 0;
+    pclose(fp);
+    return bytes;
+}
+
+int main(int argc, char* argv[])
+{
+    size_t jobs = 0;
+    std::string parent = "/tmp";
+    std::vector<std::string> gen_args;
+    int opt;
+    bool ok = true;
+    while ((opt = getopt(argc, argv, "j:w:n:t:f:r:s:d:a:p:")) != -1) {
+        switch (opt) {
+            case 'j': jobs = strtoul(optarg, nullptr, 10); break;
+            case 'w': parent = optarg; break;
+            case '?': ok = false; break;
+            default:
+                gen_args.push_back(std::string("-") + (char)opt);
+                gen_args.push_back(optarg);
+                break;
+        }
+    }
+    if (!ok || optind != argc) {
+        fprintf(stderr, "usage: %s [-j jobs] [-w workdir] [-n objects] [-t encrypt_text_size] [-f funcs] "
+                "[-r relocs_per_func] [-s extra_sections] [-d debug_size] [-a objects_per_archive] "
+                "[-p files_per_dir]\n", argv[0]);
+        return 1;
+    }
+    if (jobs == 0) jobs = sysconf(_SC_NPROCESSORS_ONLN) > 1 ? sysconf(_SC_NPROCESSORS_ONLN) : 4;
+
+    std::string dir_tmpl = parent + "/corpus_bench_XXXXXX";
+    if (!mkdtemp(&dir_tmpl[0])) {
+        perror("mkdtemp");
+        return 1;
+    }
+    const std::string base = dir_tmpl;
+    const std::string plain = base + "/plain";
+
+    // 生成语料
+    std::vector<std::string> gen = {CORPUS_BENCH_GEN};
+    gen.insert(gen.end(), gen_args.begin(), gen_args.end());
+    gen.push_back(plain);
+    const std::string gen_log = base + "/gen.log";
+    const RunStats gen_stats = run_child(gen, gen_log);
+    if (!gen_stats.ok) {
+        fprintf(stderr, "[corpus_bench] corpus_gen failed (see %s)\n", gen_log.c_str());
+        return 1;
+    }
+    FILE* fp = fopen(gen_log.c_str(), "r");
+    char summary[512] = "";
+    if (fp) {
+        if (!fgets(summary, sizeof(summary), fp)) summary[0] = '\0';
+        fclose(fp);
+    }
+    const double corpus_mb = tree_bytes(plain) / (1024.0 * 1024.0);
+    printf("%s", summary);
+    printf("corpus %.1f MB, %ld CPUs, -jN = %zu, workdir %s\n", corpus_mb, sysconf(_SC_NPROCESSORS_ONLN), jobs,
+           base.c_str());
+    printf("%-24s %10s %10s %10s %12s %12s %10s\n", "step", "wall(ms)", "cpu(ms)", "rss(MB)", "wchar(MB)",
+           "disk(MB)", "MB/s");
+    print_row("generate", gen_stats, corpus_mb);
+
+    const std::string jobs_arg = std::to_string(jobs);
+    const std::string cache = base + "/encrypt_cache";
+    struct Step {
+        const char* name;
+        std::vector<std::string> args;  // 目标目录追加在末尾
+        bool pipeline;                  // 加密后复制结果（encrypt.sh 的第 4 步）
+    };
+    const Step steps[] = {
+        {"encrypt_tool -j1", {CORPUS_BENCH_TOOL, "-r", "-j", "1"}, false},
+        {"encrypt_tool -jN", {CORPUS_BENCH_TOOL, "-r", "-j", jobs_arg}, false},
+        {"pipeline (cold cache)", {CORPUS_BENCH_TOOL, "-r", "-j", "0", "-c", cache}, true},
+        {"pipeline (warm cache)", {CORPUS_BENCH_TOOL, "-r", "-j", "0", "-c", cache}, true},
+    };
+
+    std::string reference;
+    for (size_t i = 0; i < sizeof(steps) / sizeof(steps[0]); i++) {
+        const std::string tree = base + "/step" + std::to_string(i);
+        const std::string log = tree + ".log";
+        if (!copy_tree(plain, tree)) {
+            fprintf(stderr, "[corpus_bench] Failed to copy corpus to %s\n", tree.c_str());
+            return 1;
+        }
+        sync();
+
+        std::vector<std::string> args = steps[i].args;
+        args.push_back(tree);
+        RunStats s = run_child(args, log);
+        if (s.ok && steps[i].pipeline) {
+            s.add(run_child({"/bin/cp", "-a", tree, tree + ".out"}, ""));
+        }
+        print_row(steps[i].name, s, corpus_mb);
+        if (!s.ok) {
+            fprintf(stderr, "[corpus_bench] %s failed (see %s)\n", steps[i].name, log.c_str());
+            ok = false;
+            continue;
+        }
+        if (reference.empty()) {
+            reference = tree;
+        } else if (!same_tree(reference, tree)) {
+            printf("%-24s OUTPUT MISMATCH vs %s\n", steps[i].name, steps[0].name);
+            ok = false;
+        }
+    }
+    printf("outputs identical across steps: %s\n", ok ? "yes" : "no");
+
+    if (ok) {
+        const std::string cmd = "rm -rf '" + base + "'";
+        if (system(cmd.c_str()) != 0) fprintf(stderr, "[corpus_bench] Failed to remove %s\n", base.c_str());
+    }
+    return ok ? 0 : 1;
+}
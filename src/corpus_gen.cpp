@@ -0,0 +1,422 @@
+#include <elf.h>
+#include <ar.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <getopt.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+// ===================== 合成 ELF 语料生成器 =====================
+// 直接写出 x86_64 可重定位目标文件（不调用编译器），每个目标文件包含：
+//   .text（一个小函数）、.encrypt_text（funcs 个 STT_FUNC，每个函数内 relocs 个对外部符号的
+//   call rel32，即 R_X86_64_PLT32 重定位空洞）、sections 个附加段（.text.N/.data.N/.rodata.N 轮换）、
+//   .debug_info（debug 字节，每 32 字节一个 R_X86_64_32 重定位，模拟调试信息及其重定位表）。
+// 各目标文件的代码字节带有文件序号，内容互不相同（加密缓存不会误命中）。
+// -a N 时每 N 个目标文件打成一个 GNU ar 静态库（带符号索引），-p N 时每 N 个输出文件放进一个子目录。
+// 用法：corpus_gen [-n objects] [-t encrypt_text_size] [-f funcs] [-r relocs_per_func]
+//                  [-s extra_sections] [-d debug_size] [-a objects_per_archive] [-p files_per_dir] <out_dir>
+// 大小参数可带 K/M/G 后缀。
+
+struct CorpusConfig {
+    size_t objects = 100;
+    size_t text_size = 64 * 1024;
+    size_t funcs = 16;
+    size_t relocs = 4;
+    size_t sections = 8;
+    size_t debug_size = 256 * 1024;
+    size_t per_archive = 0;     // 0：直接输出 .o
+    size_t per_dir = 0;         // 0：全部放在输出目录下
+};
+
+static bool parse_size(const char* s, size_t& out)
+{
+    char* end = nullptr;
+    unsigned long long v = strtoull(s, &end, 10);
+    if (end == s) return false;
+    switch (*end) {
+        case 'k': case 'K': v <<= 10; end++; break;
+        case 'm': case 'M': v <<= 20; end++; break;
+        case 'g': case 'G': v <<= 30; end++; break;
+        default: break;
+    }
+    if (*end != '\0') return false;
+    out = (size_t)v;
+    return true;
+}
+
+// ===================== 目标文件构造 =====================
+class ElfObjectWriter {
+public:
+    // 追加一个段，返回段下标；数据稍后按对齐排布
+    size_t addSection(const char* name, uint32_t type, uint64_t flags, uint64_t align,
+                      std::vector<uint8_t> data, uint64_t entsize = 0) {
+        Elf64_Shdr sh;
+        memset(&sh, 0, sizeof(sh));
+        sh.sh_name = addString(m_shstrtab, name);
+        sh.sh_type = type;
+        sh.sh_flags = flags;
+        sh.sh_addralign = align;
+        sh.sh_entsize = entsize;
+        m_shdrs.push_back(sh);
+        m_data.push_back(std::move(data));
+        return m_shdrs.size() - 1;
+    }
+
+    Elf64_Shdr& shdr(size_t idx) { return m_shdrs[idx]; }
+
+    static uint32_t addString(std::vector<uint8_t>& tab, const std::string& s) {
+        const uint32_t off = (uint32_t)tab.size();
+        tab.insert(tab.end(), s.begin(), s.end());
+        tab.push_back(0);
+        return off;
+    }
+
+    std::vector<uint8_t> finish() {
+        const size_t shstrndx = addSection(".shstrtab", SHT_STRTAB, 0, 1, {});
+        addString(m_shstrtab, "");
+        m_data[shstrndx] = m_shstrtab;
+
+        std::vector<uint8_t> out(sizeof(Elf64_Ehdr), 0);
+        for (size_t i = 1; i < m_shdrs.size(); i++) {
+            const size_t align = m_shdrs[i].sh_addralign > 1 ? m_shdrs[i].sh_addralign : 1;
+            out.resize((out.size() + align - 1) & ~(align - 1), 0);
+            m_shdrs[i].sh_offset = out.size();
+            m_shdrs[i].sh_size = m_data[i].size();
+            out.insert(out.end(), m_data[i].begin(), m_data[i].end());
+        }
+        out.resize((out.size() + 7) & ~(size_t)7, 0);
+
+        Elf64_Ehdr eh;
+        memset(&eh, 0, sizeof(eh));
+        memcpy(eh.e_ident, ELFMAG, SELFMAG);
+        eh.e_ident[EI_CLASS] = ELFCLASS64;
+        eh.e_ident[EI_DATA] = ELFDATA2LSB;
+        eh.e_ident[EI_VERSION] = EV_CURRENT;
+        eh.e_ident[EI_OSABI] = ELFOSABI_SYSV;
+        eh.e_type = ET_REL;
+        eh.e_machine = EM_X86_64;
+        eh.e_version = EV_CURRENT;
+        eh.e_shoff = out.size();
+        eh.e_ehsize = sizeof(Elf64_Ehdr);
+        eh.e_shentsize = sizeof(Elf64_Shdr);
+        eh.e_shnum = (uint16_t)m_shdrs.size();
+        eh.e_shstrndx = (uint16_t)shstrndx;
+        memcpy(out.data(), &eh, sizeof(eh));
+        const uint8_t* p = (const uint8_t*)m_shdrs.data();
+        out.insert(out.end(), p, p + m_shdrs.size() * sizeof(Elf64_Shdr));
+        return out;
+    }
+
+    ElfObjectWriter() {
+        Elf64_Shdr null_sh;
+        memset(&null_sh, 0, sizeof(null_sh));
+        m_shdrs.push_back(null_sh);
+        m_data.emplace_back();
+        m_shstrtab.push_back(0);
+    }
+
+private:
+    std::vector<Elf64_Shdr> m_shdrs;
+    std::vector<std::vector<uint8_t>> m_data;
+    std::vector<uint8_t> m_shstrtab;
+};
+
+static void put_rela(std::vector<uint8_t>& rela, uint64_t offset, uint32_t sym, uint32_t type, int64_t addend)
+{
+    Elf64_Rela r;
+    r.r_offset = offset;
+    r.r_info = ELF64_R_INFO(sym, type);
+    r.r_addend = addend;
+    const uint8_t* p = (const uint8_t*)&r;
+    rela.insert(rela.end(), p, p + sizeof(r));
+}
+
+static void put_sym(std::vector<uint8_t>& symtab, uint32_t name, unsigned bind, unsigned type,
+                    uint16_t shndx, uint64_t value, uint64_t size)
+{
+    Elf64_Sym s;
+    memset(&s, 0, sizeof(s));
+    s.st_name = name;
+    s.st_info = ELF64_ST_INFO(bind, type);
+    s.st_shndx = shndx;
+    s.st_value = value;
+    s.st_size = size;
+    const uint8_t* p = (const uint8_t*)&s;
+    symtab.insert(symtab.end(), p, p + sizeof(s));
+}
+
+// 生成第 index 个目标文件；globals 返回其全局函数符号名（静态库符号索引用）
+static std::vector<uint8_t> build_object(const CorpusConfig& cfg, size_t index, std::vector<std::string>& globals)
+{
+    ElfObjectWriter w;
+    globals.clear();
+
+    // .text：一个普通函数
+    const size_t text = w.addSection(".text", SHT_PROGBITS, SHF_ALLOC | SHF_EXECINSTR, 16,
+                                     {0x31, 0xc0, 0xc3});
+
+    // .encrypt_text：funcs 个函数，函数内均匀放置 call rel32（操作数为重定位空洞），其余为带文件序号的
+    // mov eax, imm32 与 nop，函数以 ret 结尾
+    const size_t funcs = cfg.funcs ? cfg.funcs : 1;
+    const size_t text_size = cfg.text_size < funcs * 16 ? funcs * 16 : cfg.text_size;
+    std::vector<uint8_t> code(text_size, 0x90);
+    std::vector<uint8_t> enc_rela;
+    std::vector<std::pair<size_t, size_t>> func_ranges;
+    for (size_t f = 0; f < funcs; f++) {
+        const size_t start = text_size * f / funcs;
+        const size_t end = text_size * (f + 1) / funcs;
+        func_ranges.emplace_back(start, end - start);
+        const size_t body = end - start - 1;
+        for (size_t off = start; off + 5 <= start + body; off += 64) {
+            const uint32_t imm = (uint32_t)(index * 0x9E3779B1u + off);
+            code[off] = 0xb8;
+            memcpy(&code[off + 1], &imm, 4);
+        }
+        // call 位于函数内 8 字节边界、mov 位于 64 字节边界，二者要么不重叠要么 call 整条覆盖 mov
+        const size_t stride = cfg.relocs && body > 16 && (body - 16) / cfg.relocs >= 8
+                                  ? ((body - 16) / cfg.relocs) & ~(size_t)7 : 8;
+        for (size_t r = 0; r < cfg.relocs; r++) {
+            const size_t off = start + 8 + r * stride;
+            if (off + 5 > start + body) break;
+            code[off] = 0xe8;
+            memset(&code[off + 1], 0, 4);
+            put_rela(enc_rela, off + 1, 0, R_X86_64_PLT32, -4);     // 符号下标在符号表建好后回填
+        }
+        code[end - 1] = 0xc3;
+    }
+    const size_t enc = w.addSection(".encrypt_text", SHT_PROGBITS, SHF_ALLOC | SHF_EXECINSTR, 16, code);
+
+    // 附加段
+    for (size_t s = 0; s < cfg.sections; s++) {
+        const std::string n = std::to_string(s);
+        std::vector<uint8_t> bytes(64 + (s % 4) * 32, (uint8_t)(index + s));
+        switch (s % 3) {
+            case 0:
+                bytes.back() = 0xc3;
+                w.addSection((".text.corpus_" + n).c_str(), SHT_PROGBITS, SHF_ALLOC | SHF_EXECINSTR, 16, bytes);
+                break;
+            case 1:
+                w.addSection((".data.corpus_" + n).c_str(), SHT_PROGBITS, SHF_ALLOC | SHF_WRITE, 8, bytes);
+                break;
+            default:
+                w.addSection((".rodata.corpus_" + n).c_str(), SHT_PROGBITS, SHF_ALLOC, 8, bytes);
+                break;
+        }
+    }
+
+    // 调试信息：内容 + 每 32 字节一个 R_X86_64_32
+    size_t debug = 0;
+    if (cfg.debug_size) {
+        std::vector<uint8_t> info(cfg.debug_size);
+        for (size_t i = 0; i < info.size(); i++) info[i] = (uint8_t)(i * 31 + index);
+        debug = w.addSection(".debug_info", SHT_PROGBITS, 0, 1, info);
+    }
+
+    // 符号表：null、段符号（局部），然后全局函数与外部符号
+    std::vector<uint8_t> strtab(1, 0);
+    std::vector<uint8_t> symtab;
+    put_sym(symtab, 0, STB_LOCAL, STT_NOTYPE, SHN_UNDEF, 0, 0);
+    put_sym(symtab, 0, STB_LOCAL, STT_SECTION, (uint16_t)text, 0, 0);
+    put_sym(symtab, 0, STB_LOCAL, STT_SECTION, (uint16_t)enc, 0, 0);
+    uint32_t debug_sym = 0;
+    if (debug) {
+        debug_sym = (uint32_t)(symtab.size() / sizeof(Elf64_Sym));
+        put_sym(symtab, 0, STB_LOCAL, STT_SECTION, (uint16_t)debug, 0, 0);
+    }
+    const uint32_t first_global = (uint32_t)(symtab.size() / sizeof(Elf64_Sym));
+
+    char name[64];
+    snprintf(name, sizeof(name), "corpus_%06zu_plain", index);
+    put_sym(symtab, ElfObjectWriter::addString(strtab, name), STB_GLOBAL, STT_FUNC, (uint16_t)text, 0, 3);
+    globals.push_back(name);
+    for (size_t f = 0; f < func_ranges.size(); f++) {
+        snprintf(name, sizeof(name), "corpus_%06zu_f%zu", index, f);
+        put_sym(symtab, ElfObjectWriter::addString(strtab, name), STB_GLOBAL, STT_FUNC, (uint16_t)enc,
+                func_ranges[f].first, func_ranges[f].second);
+        globals.push_back(name);
+    }
+    const uint32_t extern_sym = (uint32_t)(symtab.size() / sizeof(Elf64_Sym));
+    put_sym(symtab, ElfObjectWriter::addString(strtab, "corpus_extern"), STB_GLOBAL, STT_NOTYPE, SHN_UNDEF, 0, 0);
+
+    // .encrypt_text 的重定位全部指向外部符号
+    for (size_t off = 0; off < enc_rela.size(); off += sizeof(Elf64_Rela)) {
+        Elf64_Rela* r = (Elf64_Rela*)&enc_rela[off];
+        r->r_info = ELF64_R_INFO(extern_sym, R_X86_64_PLT32);
+    }
+
+    const size_t symtab_idx = w.addSection(".symtab", SHT_SYMTAB, 0, 8, symtab, sizeof(Elf64_Sym));
+    const size_t strtab_idx = w.addSection(".strtab", SHT_STRTAB, 0, 1, strtab);
+    w.shdr(symtab_idx).sh_link = (uint32_t)strtab_idx;
+    w.shdr(symtab_idx).sh_info = first_global;
+
+    if (!enc_rela.empty()) {
+        const size_t r = w.addSection(".rela.encrypt_text", SHT_RELA, SHF_INFO_LINK, 8, enc_rela, sizeof(Elf64_Rela));
+        w.shdr(r).sh_link = (uint32_t)symtab_idx;
+        w.shdr(r).sh_info = (uint32_t)enc;
+    }
+    if (debug && cfg.debug_size >= 4) {
+        std::vector<uint8_t> rela;
+        rela.reserve(cfg.debug_size / 32 * sizeof(Elf64_Rela));
+        for (size_t off = 0; off + 4 <= cfg.debug_size; off += 32) {
+            put_rela(rela, off, debug_sym, R_X86_64_32, (int64_t)off);
+        }
+        const size_t r = w.addSection(".rela.debug_info", SHT_RELA, SHF_INFO_LINK, 8, rela, sizeof(Elf64_Rela));
+        w.shdr(r).sh_link = (uint32_t)symtab_idx;
+        w.shdr(r).sh_info = (uint32_t)debug;
+    }
+    return w.finish();
+}
+
+// ===================== 静态库（GNU ar，带 32 位符号索引） =====================
+static void ar_header(std::vector<uint8_t>& out, const std::string& name, size_t size)
+{
+    char hdr[sizeof(struct ar_hdr) + 1];
+    snprintf(hdr, sizeof(hdr), "%-16s%-12s%-6s%-6s%-8s%-10zu%s", name.c_str(), "0", "0", "0", "644", size, ARFMAG);
+    out.insert(out.end(), hdr, hdr + sizeof(struct ar_hdr));
+}
+
+static void put_be32(std::vector<uint8_t>& out, uint32_t v)
+{
+    const uint8_t b[4] = {(uint8_t)(v >> 24), (uint8_t)(v >> 16), (uint8_t)(v >> 8), (uint8_t)v};
+    out.insert(out.end(), b, b + 4);
+}
+
+static std::vector<uint8_t> build_archive(const std::vector<std::string>& names,
+                                          const std::vector<std::vector<uint8_t>>& members,
+                                          const std::vector<std::vector<std::string>>& globals)
+{
+    size_t sym_count = 0, names_size = 0;
+    for (const auto& g : globals) {
+        sym_count += g.size();
+        for (const std::string& s : g) names_size += s.size() + 1;
+    }
+    const size_t index_size = 4 + 4 * sym_count + names_size;
+
+    // 各成员头偏移：魔数 + 索引成员（偶数对齐）之后依次排列
+    std::vector<uint32_t> offsets;
+    size_t off = SARMAG + sizeof(struct ar_hdr) + index_size + (index_size & 1);
+    for (const auto& m : members) {
+        offsets.push_back((uint32_t)off);
+        off += sizeof(struct ar_hdr) + m.size() + (m.size() & 1);
+    }
+
+    std::vector<uint8_t> out(ARMAG, ARMAG + SARMAG);
+    ar_header(out, "/", index_size);
+    put_be32(out, (uint32_t)sym_count);
+    for (size_t i = 0; i < globals.size(); i++) {
+        for (size_t k = 0; k < globals[i].size(); k++) put_be32(out, offsets[i]);
+    }
+    for (const auto& g : globals) {
+        for (const std::string& s : g) out.insert(out.end(), s.c_str(), s.c_str() + s.size() + 1);
+    }
+    if (index_size & 1) out.push_back('\n');
+
+    for (size_t i = 0; i < members.size(); i++) {
+        ar_header(out, names[i] + "/", members[i].size());
+        out.insert(out.end(), members[i].begin(), members[i].end());
+        if (members[i].size() & 1) out.push_back('\n');
+    }
+    return out;
+}
+
+static bool write_file(const std::string& path, const std::vector<uint8_t>& data)
+{
+    const int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return false;
+    const bool ok = write(fd, data.data(), data.size()) == (ssize_t)data.size();
+    close(fd);
+    return ok;
+}
+
+// 第 file 个输出文件所在目录（必要时创建）
+static std::string output_dir(const std::string& root, const CorpusConfig& cfg, size_t file)
+{
+    if (cfg.per_dir == 0) return root;
+    char sub[32];
+    snprintf(sub, sizeof(sub), "/d%04zu", file / cfg.per_dir);
+    const std::string dir = root + sub;
+    mkdir(dir.c_str(), 0755);
+    return dir;
+}
+
+int main(int argc, char* argv[])
+{
+    CorpusConfig cfg;
+    int opt;
+    bool ok = true;
+    while ((opt = getopt(argc, argv, "n:t:f:r:s:d:a:p:")) != -1) {
+        size_t* target = nullptr;
+        switch (opt) {
+            case 'n': target = &cfg.objects; break;
+            case 't': target = &cfg.text_size; break;
+            case 'f': target = &cfg.funcs; break;
+            case 'r': target = &cfg.relocs; break;
+            case 's': target = &cfg.sections; break;
+            case 'd': target = &cfg.debug_size; break;
+            case 'a': target = &cfg.per_archive; break;
+            case 'p': target = &cfg.per_dir; break;
+            default: ok = false; break;
+        }
+        if (target && !parse_size(optarg, *target)) ok = false;
+    }
+    if (!ok || optind + 1 != argc || cfg.objects == 0 || cfg.text_size > UINT32_MAX) {
+        fprintf(stderr, "usage: %s [-n objects] [-t encrypt_text_size] [-f funcs] [-r relocs_per_func] "
+                "[-s extra_sections] [-d debug_size] [-a objects_per_archive] [-p files_per_dir] <out_dir>\n", argv[0]);
+        return 1;
+    }
+    const std::string root = argv[optind];
+    if (mkdir(root.c_str(), 0755) != 0 && errno != EEXIST) {
+        fprintf(stderr, "[corpus_gen] Cannot create %s: %s\n", root.c_str(), strerror(errno));
+        return 1;
+    }
+
+    uint64_t total_bytes = 0;
+    size_t files = 0;
+    std::vector<std::string> globals;
+    std::vector<std::string> names;
+    std::vector<std::vector<uint8_t>> members;
+    std::vector<std::vector<std::string>> member_globals;
+    for (size_t i = 0; i < cfg.objects; i++) {
+        char name[32];
+        snprintf(name, sizeof(name), "obj_%06zu.o", i);
+        std::vector<uint8_t> obj = build_object(cfg, i, globals);
+
+        if (cfg.per_archive == 0) {
+            if (!write_file(output_dir(root, cfg, files) + "/" + name, obj)) {
+                fprintf(stderr, "[corpus_gen] Write %s failed: %s\n", name, strerror(errno));
+                return 1;
+            }
+            total_bytes += obj.size();
+            files++;
+            continue;
+        }
+
+        names.push_back(name);
+        members.push_back(std::move(obj));
+        member_globals.push_back(globals);
+        if (members.size() == cfg.per_archive || i + 1 == cfg.objects) {
+            snprintf(name, sizeof(name), "lib_%06zu.a", files);
+            const std::vector<uint8_t> ar = build_archive(names, members, member_globals);
+            if (!write_file(output_dir(root, cfg, files) + "/" + name, ar)) {
+                fprintf(stderr, "[corpus_gen] Write %s failed: %s\n", name, strerror(errno));
+                return 1;
+            }
+            total_bytes += ar.size();
+            files++;
+            names.clear();
+            members.clear();
+            member_globals.clear();
+        }
+    }
+
+    printf("[corpus_gen] %zu objects in %zu %s (%.1f MB) under %s: .encrypt_text %zu bytes, %zu funcs x %zu relocs, "
+           "%zu extra sections, %zu debug bytes\n",
+           cfg.objects, files, cfg.per_archive ? "archives" : "files", total_bytes / (1024.0 * 1024.0), root.c_str(),
+           cfg.text_size, cfg.funcs, cfg.relocs, cfg.sections, cfg.debug_size);
+    return 0;
+}
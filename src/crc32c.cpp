@@ -0,0 +1,101 @@
+#include "crc32c.h"
+#include <cpuid.h>
+#include <cstring>
+#include <nmmintrin.h>
+
+namespace {
+
+const uint32_t POLY = 0x82F63B78u;
+
+struct Crc32cTable {
+    uint32_t t[256];
+    Crc32cTable() {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; k++) c = (c >> 1) ^ (POLY & (0u - (c & 1)));
+            t[i] = c;
+        }
+    }
+};
+
+uint32_t crc32c_table(uint32_t crc, const uint8_t* p, size_t len)
+{
+    static const Crc32cTable table;
+    for (size_t i = 0; i < len; i++) crc = table.t[(crc ^ p[i]) & 0xff] ^ (crc >> 8);
+    return crc;
+}
+
+__attribute__((target("sse4.2")))
+uint32_t crc32c_sse42(uint32_t crc, const uint8_t* p, size_t len)
+{
+    uint64_t c = crc;
+    for (; len >= 8; p += 8, len -= 8) {
+        uint64_t v;
+        memcpy(&v, p, sizeof(v));
+        c = _mm_crc32_u64(c, v);
+    }
+    uint32_t c32 = (uint32_t)c;
+    for (; len > 0; p++, len--) c32 = _mm_crc32_u8(c32, *p);
+    return c32;
+}
+
+// 反射形式下 a * b mod P（最高位为 x^0）
+constexpr uint32_t multmodp(uint32_t a, uint32_t b)
+{
+    uint32_t m = 1u << 31, p = 0;
+    for (;;) {
+        if (a & m) {
+            p ^= b;
+            if ((a & (m - 1)) == 0) break;
+        }
+        m >>= 1;
+        b = (b & 1) ? (b >> 1) ^ POLY : b >> 1;
+    }
+    return p;
+}
+
+// x^(2^k) mod P，k = 0..31（编译期生成）
+struct X2nTable {
+    uint32_t t[32];
+    constexpr X2nTable() : t() {
+        uint32_t p = 1u << 30;      // x^1
+        for (int k = 0; k < 32; k++) {
+            t[k] = p;
+            p = multmodp(p, p);
+        }
+    }
+};
+
+constexpr X2nTable X2N;
+
+bool detect_sse42()
+{
+    unsigned int eax, ebx, ecx, edx;
+    return __get_cpuid(1, &eax, &ebx, &ecx, &edx) && (ecx & bit_SSE4_2);
+}
+
+} // namespace
+
+bool Crc32c::hardware()
+{
+    static const bool hw = detect_sse42();
+    return hw;
+}
+
+uint32_t Crc32c::update(uint32_t crc, const void* data, size_t len)
+{
+    const uint8_t* p = (const uint8_t*)data;
+    crc = ~crc;
+    crc = hardware() ? crc32c_sse42(crc, p, len) : crc32c_table(crc, p, len);
+    return ~crc;
+}
+
+uint32_t Crc32c::combine(uint32_t crc1, uint32_t crc2, size_t len2)
+{
+    // crc1 * x^(8*len2)：len2 的二进制位 n 对应 x^(2^(n+3))
+    uint32_t p = 1u << 31;          // x^0
+    for (unsigned k = 3; len2; len2 >>= 1, k++) {
+        if (len2 & 1) p = multmodp(X2N.t[k & 31], p);
+    }
+    return multmodp(p, crc1) ^ crc2;
+}
@@ -0,0 +1,132 @@
+#include "cipher.h"
+#include "crc32c.h"
+#include <x86intrin.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+// ===================== 解密 + 明文 CRC32C 校验开销 =====================
+// 对同一段密文比较三种做法的 cycles/byte：
+//   decrypt   只解密
+//   separate  整段解密后再单独扫一遍算 CRC（数据超出缓存时要从内存再读一次）
+//   fused/N   按 N 字节分片，每片解密后趁还在 L1/L2 里立即算 CRC（EncryptTable::decryptPendingChecked 的做法）
+// 并核对分片算出的 CRC 与整段 CRC、Crc32c::combine 合并结果一致。
+// 用法：crc_bench [mb] [runs]（默认 64 MB，5 次取最小值）
+
+static const uint64_t BENCH_NONCE = 0x0123456789abcdefULL;
+
+static void run_xor(uint8_t* buf, size_t len, size_t off) { XOR_CIPHER.apply(buf, len, 0, off); }
+static void run_aes128(uint8_t* buf, size_t len, size_t off) { AES128_CIPHER.apply(buf, len, BENCH_NONCE, off); }
+static void run_aes256(uint8_t* buf, size_t len, size_t off) { AES256_CIPHER.apply(buf, len, BENCH_NONCE, off); }
+
+struct Variant {
+    const char* name;
+    void (*run)(uint8_t* buf, size_t len, size_t off);
+};
+
+static const size_t TILES[] = {(size_t)4 << 10, (size_t)8 << 10, (size_t)32 << 10, (size_t)256 << 10};
+
+static uint32_t fused(const Variant& v, uint8_t* buf, size_t size, size_t tile)
+{
+    uint32_t crc = 0;
+    for (size_t done = 0; done < size;) {
+        const size_t n = std::min(tile, size - done);
+        v.run(buf + done, n, done);
+        crc = Crc32c::update(crc, buf + done, n);
+        done += n;
+    }
+    return crc;
+}
+
+// mode：0 只解密，1 解密后单独算 CRC，2 分片融合；buf 进出都是密文，返回 cycles/byte 中的最小值
+static double measure(const Variant& v, uint8_t* buf, size_t size, int runs, int mode, size_t tile,
+                      uint32_t& crc)
+{
+    double best = 1e30;
+    for (int r = 0; r < runs; r++) {
+        unsigned aux;
+        const uint64_t t0 = __rdtscp(&aux);
+        if (mode == 0) {
+            v.run(buf, size, 0);
+        } else if (mode == 1) {
+            v.run(buf, size, 0);
+            crc = Crc32c::update(0, buf, size);
+        } else {
+            crc = fused(v, buf, size, tile);
+        }
+        const uint64_t t1 = __rdtscp(&aux);
+        best = std::min(best, (double)(t1 - t0) / (double)size);
+        v.run(buf, size, 0);    // 不计时：重新加密回密文
+    }
+    return best;
+}
+
+// 分段 CRC 经 combine 合并后与整段一致
+static bool verify_combine(const uint8_t* data, size_t size)
+{
+    const uint32_t whole = Crc32c::update(0, data, size);
+    srand(7);
+    for (int round = 0; round < 64; round++) {
+        const size_t cut = (size_t)rand() % (size + 1);
+        const uint32_t a = Crc32c::update(0, data, cut);
+        const uint32_t b = Crc32c::update(0, data + cut, size - cut);
+        if (Crc32c::combine(a, b, size - cut) != whole) {
+            fprintf(stderr, "[crc_bench] combine mismatch at cut %zu\n", cut);
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    size_t size = (size_t)64 << 20;
+    int runs = 5;
+    if (argc >= 2) size = std::max((size_t)strtoull(argv[1], nullptr, 10) << 20, (size_t)1 << 20);
+    if (argc >= 3) runs = std::max(atoi(argv[2]), 1);
+
+    static const uint8_t check[] = "123456789";
+    if (Crc32c::update(0, check, 9) != 0xe3069283) {
+        fprintf(stderr, "[crc_bench] CRC32C check value mismatch\n");
+        return 1;
+    }
+    printf("[crc_bench] CRC32C: %s, XOR ISA: %s, AES ISA: %s, size %zu MB, best of %d\n",
+           Crc32c::hardware() ? "sse4.2" : "table", XorPolicy::isaName(XorPolicy::activeIsa()),
+           AesCtrPolicy::isaName(AesCtrPolicy::activeIsa()), size >> 20, runs);
+
+    std::vector<uint8_t> buf(size);
+    for (size_t i = 0; i < size; i++) buf[i] = (uint8_t)(i * 131 + (i >> 12));
+    if (!verify_combine(buf.data(), std::min(size, (size_t)1 << 20))) return 1;
+
+    const Variant variants[] = {{"xor", run_xor}, {"aes128", run_aes128}, {"aes256", run_aes256}};
+    printf("%-8s %10s %10s", "cipher", "decrypt", "separate");
+    for (size_t tile : TILES) {
+        char label[32];
+        snprintf(label, sizeof(label), "fused/%zuK", tile >> 10);
+        printf(" %12s", label);
+    }
+    printf("\n");
+
+    bool ok = true;
+    for (const Variant& v : variants) {
+        v.run(buf.data(), size, 0);     // 加密为密文
+        uint32_t ref = 0, crc = 0;
+        const double dec = measure(v, buf.data(), size, runs, 0, 0, crc);
+        const double sep = measure(v, buf.data(), size, runs, 1, 0, ref);
+        printf("%-8s %10.3f %10.3f", v.name, dec, sep);
+        for (size_t tile : TILES) {
+            const double f = measure(v, buf.data(), size, runs, 2, tile, crc);
+            if (crc != ref) {
+                fprintf(stderr, "\n[crc_bench] %s fused/%zuK CRC %08x != separate %08x\n", v.name, tile >> 10, crc, ref);
+                ok = false;
+            }
+            printf(" %12.3f", f);
+        }
+        printf("\n");
+        v.run(buf.data(), size, 0);     // 恢复明文
+    }
+    printf("[crc_bench] cycles/byte; fused CRC %s separate CRC\n", ok ? "matches" : "DIFFERS FROM");
+    return ok ? 0 : 1;
+}
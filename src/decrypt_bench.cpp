@@ -0,0 +1,224 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+// ===================== Decryptor::decrypt() 分阶段耗时基准 =====================
+// 对 .encrypt_text 为 4 KB ~ 256 MB 的各被测镜像（decrypt_bench_image_<size>，构建时加密），
+// 每次运行 fork + exec 一个新进程，由镜像自己计时 decrypt() 总耗时与各阶段耗时
+// （基址查找 / 打开并映射文件 / 段定位 / 可访问性探测 / mprotect RWX / 解密 / 缓存刷新 / mprotect RX），
+// 驱动程序另计整个进程从 fork 到退出的耗时。
+// 冷缓存：每次运行前对镜像文件 POSIX_FADV_DONTNEED（需在真实磁盘文件系统上，tmpfs 无冷缓存）；
+// 热缓存：先完整读一遍镜像文件并丢弃一次预热运行。
+// 输出每个 大小 × 缓存状态 × 阶段 的中位数与 p99（最近秩），格式为 CSV 或 JSON。
+// 用法：decrypt_bench [runs] [csv|json] [max_mb]
+
+#ifndef DECRYPT_BENCH_IMAGE_DIR
+#define DECRYPT_BENCH_IMAGE_DIR "."
+#endif
+#ifndef DECRYPT_BENCH_SIZES
+#define DECRYPT_BENCH_SIZES "4096"
+#endif
+
+// 与 Decryptor::DecryptPhase 顺序一致，前面是镜像报告的总耗时，最后是驱动程序测得的进程耗时
+static const char* const kMetrics[] = {
+    "decrypt_total", "base_discovery", "file_map", "section_lookup", "probe",
+    "mprotect_rwx", "decrypt", "cache_flush", "mprotect_rx", "process"
+};
+static const size_t METRIC_COUNT = sizeof(kMetrics) / sizeof(kMetrics[0]);
+static const size_t IMAGE_METRICS = METRIC_COUNT - 1;
+
+struct Sample {
+    uint64_t ns[METRIC_COUNT];
+};
+
+struct Summary {
+    size_t size;
+    const char* cache;
+    size_t runs;
+    uint64_t median[METRIC_COUNT];
+    uint64_t p99[METRIC_COUNT];
+};
+
+static inline uint64_t now_ns()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static std::string image_path(size_t size)
+{
+    return std::string(DECRYPT_BENCH_IMAGE_DIR) + "/decrypt_bench_image_" + std::to_string(size);
+}
+
+// 冷：丢弃镜像文件的页缓存；热：完整读入页缓存
+static bool prepare_cache(const std::string& path, bool cold)
+{
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    if (cold) {
+        posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    } else {
+        static char buf[1 << 16];
+        while (read(fd, buf, sizeof(buf)) > 0) {
+        }
+    }
+    close(fd);
+    return true;
+}
+
+// 运行一次被测镜像：结果行经管道（子进程 fd 3）读回，镜像的 stdout 日志丢弃
+static bool run_image(const std::string& path, Sample& s)
+{
+    int fds[2];
+    if (pipe(fds) != 0) return false;
+    fflush(stdout);
+    const uint64_t t0 = now_ns();
+    const pid_t pid = fork();
+    if (pid == 0) {
+        close(fds[0]);
+        if (dup2(fds[1], 3) < 0) _exit(127);
+        const int devnull = open("/dev/null", O_WRONLY);
+        if (devnull >= 0) dup2(devnull, STDOUT_FILENO);
+        execl(path.c_str(), path.c_str(), (char*)nullptr);
+        _exit(127);
+    }
+    close(fds[1]);
+    char line[512];
+    size_t len = 0;
+    ssize_t n;
+    while (len < sizeof(line) - 1 && (n = read(fds[0], line + len, sizeof(line) - 1 - len)) > 0) {
+        len += (size_t)n;
+    }
+    line[len] = '\0';
+    close(fds[0]);
+    int status = 0;
+    waitpid(pid, &status, 0);
+    s.ns[METRIC_COUNT - 1] = now_ns() - t0;
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) return false;
+
+    // <ok>,<total>,<phase...>
+    char* p = line;
+    if (strtol(p, &p, 10) != 1) return false;
+    for (size_t m = 0; m < IMAGE_METRICS; m++) {
+        if (*p != ',') return false;
+        s.ns[m] = strtoull(p + 1, &p, 10);
+    }
+    return true;
+}
+
+// 最近秩百分位
+static uint64_t percentile(std::vector<uint64_t>& v, double q)
+{
+    std::sort(v.begin(), v.end());
+    size_t rank = (size_t)(q * v.size() + 0.999999);
+    if (rank == 0) rank = 1;
+    return v[std::min(rank, v.size()) - 1];
+}
+
+static bool bench_one(size_t size, bool cold, size_t runs, Summary& out)
+{
+    const std::string path = image_path(size);
+    if (access(path.c_str(), X_OK) != 0) {
+        fprintf(stderr, "[decrypt_bench] Missing image %s\n", path.c_str());
+        return false;
+    }
+
+    Sample s;
+    if (!cold && (!prepare_cache(path, false) || !run_image(path, s))) {
+        fprintf(stderr, "[decrypt_bench] Warm-up run of %s failed\n", path.c_str());
+        return false;
+    }
+
+    std::vector<Sample> samples;
+    samples.reserve(runs);
+    for (size_t i = 0; i < runs; i++) {
+        if (cold && !prepare_cache(path, true)) return false;
+        if (!run_image(path, s)) {
+            fprintf(stderr, "[decrypt_bench] Run %zu of %s failed (decrypt or payload check)\n", i, path.c_str());
+            return false;
+        }
+        samples.push_back(s);
+    }
+
+    out.size = size;
+    out.cache = cold ? "cold" : "warm";
+    out.runs = runs;
+    std::vector<uint64_t> v(runs);
+    for (size_t m = 0; m < METRIC_COUNT; m++) {
+        for (size_t i = 0; i < runs; i++) v[i] = samples[i].ns[m];
+        out.median[m] = percentile(v, 0.5);
+        out.p99[m] = percentile(v, 0.99);
+    }
+    return true;
+}
+
+static void print_csv(const std::vector<Summary>& rows)
+{
+    printf("size_bytes,cache,runs,phase,median_ns,p99_ns\n");
+    for (const Summary& r : rows) {
+        for (size_t m = 0; m < METRIC_COUNT; m++) {
+            printf("%zu,%s,%zu,%s,%llu,%llu\n", r.size, r.cache, r.runs, kMetrics[m],
+                   (unsigned long long)r.median[m], (unsigned long long)r.p99[m]);
+        }
+    }
+}
+
+static void print_json(const std::vector<Summary>& rows)
+{
+    printf("[\n");
+    for (size_t i = 0; i < rows.size(); i++) {
+        const Summary& r = rows[i];
+        printf("  {\"size_bytes\": %zu, \"cache\": \"%s\", \"runs\": %zu, \"phases\": {", r.size, r.cache, r.runs);
+        for (size_t m = 0; m < METRIC_COUNT; m++) {
+            printf("%s\"%s\": {\"median_ns\": %llu, \"p99_ns\": %llu}", m ? ", " : "", kMetrics[m],
+                   (unsigned long long)r.median[m], (unsigned long long)r.p99[m]);
+        }
+        printf("}}%s\n", i + 1 < rows.size() ? "," : "");
+    }
+    printf("]\n");
+}
+
+int main(int argc, char* argv[])
+{
+    const size_t runs = argc > 1 ? strtoul(argv[1], nullptr, 10) : 21;
+    const std::string format = argc > 2 ? argv[2] : "csv";
+    const size_t max_bytes = argc > 3 ? (size_t)strtoull(argv[3], nullptr, 10) << 20 : (size_t)-1;
+    if (runs == 0 || (format != "csv" && format != "json")) {
+        fprintf(stderr, "usage: %s [runs] [csv|json] [max_mb]\n", argv[0]);
+        return 1;
+    }
+
+    std::vector<size_t> sizes;
+    for (const char* p = DECRYPT_BENCH_SIZES; *p;) {
+        char* end = nullptr;
+        const size_t size = strtoull(p, &end, 10);
+        if (size && size <= max_bytes) sizes.push_back(size);
+        p = (*end == ',') ? end + 1 : end;
+    }
+
+    std::vector<Summary> rows;
+    for (size_t size : sizes) {
+        for (bool cold : {true, false}) {
+            Summary r;
+            if (!bench_one(size, cold, runs, r)) return 1;
+            rows.push_back(r);
+            fprintf(stderr, "[decrypt_bench] %zu bytes %s: decrypt median %.3f ms, p99 %.3f ms\n",
+                    size, r.cache, r.median[0] / 1e6, r.p99[0] / 1e6);
+        }
+    }
+
+    if (format == "json") {
+        print_json(rows);
+    } else {
+        print_csv(rows);
+    }
+    return 0;
+}
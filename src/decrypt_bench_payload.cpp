@@ -0,0 +1,30 @@
+// ========== decrypt_bench 加密载荷（构建时由 encrypt_tool 加密） ==========
+// 一个可校验的小函数 + nop 填充的冷函数，使本目标文件的 .encrypt_text 恰好为 DECRYPT_BENCH_PAYLOAD_SIZE 字节；
+// CMake 按不同大小各编译一份，链接成各自的 decrypt_bench_image_<size>。
+// 全部写成汇编，保证两个函数的先后顺序与段大小不受编译器排布影响
+
+#ifndef DECRYPT_BENCH_PAYLOAD_SIZE
+#define DECRYPT_BENCH_PAYLOAD_SIZE 4096
+#endif
+
+#define DECRYPT_BENCH_STR_(x) #x
+#define DECRYPT_BENCH_STR(x) DECRYPT_BENCH_STR_(x)
+
+// bench_payload_check(x) = x ^ 0x9E3779B97F4A7C15
+__asm__(".pushsection .encrypt_text,\"ax\",@progbits\n"
+        ".p2align 4\n"
+        ".globl bench_payload_check\n"
+        ".type bench_payload_check,@function\n"
+        "bench_payload_check:\n"
+        "movabsq $0x9E3779B97F4A7C15, %rax\n"
+        "xorq %rdi, %rax\n"
+        "ret\n"
+        ".size bench_payload_check,.-bench_payload_check\n"
+        ".p2align 4\n"
+        ".globl bench_payload_cold\n"
+        ".type bench_payload_cold,@function\n"
+        "bench_payload_cold:\n"
+        ".fill " DECRYPT_BENCH_STR(DECRYPT_BENCH_PAYLOAD_SIZE) " - (bench_payload_cold - bench_payload_check) - 1,1,0x90\n"
+        "ret\n"
+        ".size bench_payload_cold,.-bench_payload_cold\n"
+        ".popsection\n");
@@ -0,0 +1,448 @@
+#include "decrypt_registry.h"
+#include "decryptor_linux.h"
+#include "parallel_decrypt.h"
+#include "decrypt_log.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <unordered_map>
+#include <sys/auxv.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+// ===================== 内部实现 =====================
+namespace {
+
+struct ResolveContext {
+    std::unordered_map<const char*, std::vector<TargetImage*>> by_name;     // l_name 指针 -> 目标
+    std::vector<std::pair<uintptr_t, TargetImage*>> by_addr;                // 按地址排序
+    bool first;
+    size_t resolved;
+};
+
+static void fill_image(TargetImage* t, const struct dl_phdr_info* info, bool is_main)
+{
+    const char* execfn = is_main ? (const char*)getauxval(AT_EXECFN) : nullptr;
+    t->image.load_bias = (uintptr_t)info->dlpi_addr;
+    t->image.path = (info->dlpi_name && info->dlpi_name[0]) ? info->dlpi_name : (execfn ? execfn : "");
+    t->image.phdr = info->dlpi_phdr;
+    t->image.phnum = info->dlpi_phnum;
+    t->image.is_main = is_main;
+    t->state = TARGET_RESOLVED;
+}
+
+static int resolve_callback(struct dl_phdr_info* info, size_t, void* data)
+{
+    ResolveContext* ctx = (ResolveContext*)data;
+    const bool is_main = ctx->first;
+    ctx->first = false;
+
+    // glibc 中 dlpi_name/dlpi_addr 即 l_name/l_addr：名字指针相同且装载偏移相同即为同一个 link_map
+    auto it = ctx->by_name.find(info->dlpi_name);
+    if (it != ctx->by_name.end()) {
+        for (TargetImage* t : it->second) {
+            if (t->state != TARGET_RESOLVED && t->lm->l_addr == info->dlpi_addr) {
+                fill_image(t, info, is_main);
+                ctx->resolved++;
+            }
+        }
+    }
+
+    if (!ctx->by_addr.empty()) {
+        for (int i = 0; i < info->dlpi_phnum; i++) {
+            const ElfW(Phdr)& ph = info->dlpi_phdr[i];
+            if (ph.p_type != PT_LOAD) continue;
+            const uintptr_t start = info->dlpi_addr + ph.p_vaddr;
+            const uintptr_t end = start + ph.p_memsz;
+            auto a = std::lower_bound(ctx->by_addr.begin(), ctx->by_addr.end(),
+                                      std::make_pair(start, (TargetImage*)nullptr));
+            for (; a != ctx->by_addr.end() && a->first < end; ++a) {
+                if (a->second->state != TARGET_RESOLVED) {
+                    fill_image(a->second, info, is_main);
+                    ctx->resolved++;
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+// 合并后的页区间（含一个或多个目标的加密区间）
+struct Span {
+    uintptr_t page_start;
+    uintptr_t page_end;
+    uintptr_t sec_start;        // 区间内加密段的最低/最高地址，缓存同步只覆盖这一段
+    uintptr_t sec_end;
+    bool writable;              // RWX 成功且尚未恢复失败
+};
+
+// 对 lm 所在镜像取一份 dlopen 引用（RTLD_NOLOAD 不会装载新镜像）；句柄对应的必须正是 lm，
+// 否则（同名镜像已被卸载后重新装载）放弃
+static void* pin_image(const struct link_map* lm, Lmid_t lmid)
+{
+    void* handle = nullptr;
+    if (lm->l_name && lm->l_name[0]) {
+        handle = dlmopen(lmid, lm->l_name, RTLD_LAZY | RTLD_NOLOAD);
+    } else if (lmid == LM_ID_BASE) {
+        handle = dlopen(nullptr, RTLD_LAZY | RTLD_NOLOAD);     // 主程序
+    }
+    struct link_map* got = nullptr;
+    if (handle && (dlinfo(handle, RTLD_DI_LINKMAP, &got) != 0 || got != lm)) {
+        dlclose(handle);
+        handle = nullptr;
+    }
+    return handle;
+}
+
+// 按地址解析到的目标：经 dladdr1 找到 link_map 后取引用
+static void* pin_address(uintptr_t addr, const struct link_map*& lm)
+{
+    Dl_info info;
+    struct link_map* map = nullptr;
+    Lmid_t lmid = LM_ID_BASE;
+    if (!dladdr1((const void*)addr, &info, (void**)&map, RTLD_DL_LINKMAP) || !map) return nullptr;
+    // glibc 的 dlopen 句柄就是 link_map，可直接查询其命名空间
+    if (dlinfo(map, RTLD_DI_LMID, &lmid) != 0) return nullptr;
+    void* handle = pin_image(map, lmid);
+    if (handle) lm = map;
+    return handle;
+}
+
+static void chunk_decrypt(uintptr_t start, size_t len, uintptr_t, void* ctx)
+{
+    ((const EncryptTable*)ctx)->decryptPending(start, len, runtime_cipher_key());
+}
+
+// 每个目标各自累加明文校验和
+struct CheckCtx {
+    const EncryptTable* table;
+    PlainChecksum sums;
+};
+
+static void chunk_decrypt_checked(uintptr_t start, size_t len, uintptr_t, void* ctx)
+{
+    CheckCtx& c = *(CheckCtx*)ctx;
+    c.table->decryptPendingChecked(start, len, runtime_cipher_key(), c.sums);
+}
+
+} // namespace
+
+// ===================== DecryptRegistry 实现 =====================
+DecryptRegistry& DecryptRegistry::instance()
+{
+    static DecryptRegistry registry;
+    return registry;
+}
+
+int DecryptRegistry::add_locked(const struct link_map* lm, Lmid_t lmid, uintptr_t addr)
+{
+    for (size_t i = 0; i < m_targets.size(); i++) {
+        const TargetImage& t = *m_targets[i];
+        if (t.state == TARGET_REMOVED) continue;
+        if ((lm && t.lm == lm) || (!lm && t.addr == addr)) {
+            return (int)i;
+        }
+    }
+
+    void* handle = nullptr;
+    if (lm) {
+        handle = pin_image(lm, lmid);
+        if (!handle) {
+            const char* err = dlerror();
+            DECRYPT_LOG_ERROR("[DecryptRegistry] Failed to reference %s: %s\n",
+                              lm->l_name && lm->l_name[0] ? lm->l_name : "main program", err ? err : "image mismatch");
+            return -1;
+        }
+    }
+
+    std::unique_ptr<TargetImage> t(new TargetImage());
+    t->state = TARGET_PENDING;
+    t->lm = lm;
+    t->handle = handle;
+    t->addr = addr;
+    memset(&t->image, 0, sizeof(t->image));
+    t->table = nullptr;
+    m_targets.push_back(std::move(t));
+    return (int)m_targets.size() - 1;
+}
+
+int DecryptRegistry::addHandle(void* dl_handle)
+{
+    struct link_map* lm = nullptr;
+    Lmid_t lmid = LM_ID_BASE;
+    if (!dl_handle || dlinfo(dl_handle, RTLD_DI_LINKMAP, &lm) != 0 || !lm ||
+        dlinfo(dl_handle, RTLD_DI_LMID, &lmid) != 0) {
+        const char* err = dl_handle ? dlerror() : "null handle";
+        DECRYPT_LOG_ERROR("[DecryptRegistry] Invalid dl handle: %s\n", err ? err : "no link map");
+        return -1;
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return add_locked(lm, lmid, 0);
+}
+
+int DecryptRegistry::addAddress(const void* addr)
+{
+    if (!addr) return -1;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return add_locked(nullptr, LM_ID_BASE, (uintptr_t)addr);
+}
+
+int DecryptRegistry::addMain()
+{
+    void* handle = dlopen(nullptr, RTLD_LAZY | RTLD_NOLOAD);
+    const int id = addHandle(handle);
+    if (handle) dlclose(handle);
+    return id;
+}
+
+bool DecryptRegistry::remove(int id)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (id < 0 || (size_t)id >= m_targets.size()) return false;
+    TargetImage& t = *m_targets[id];
+    if (t.handle) dlclose(t.handle);
+    t.handle = nullptr;
+    t.lm = nullptr;
+    t.table = nullptr;
+    t.own_table.reset();
+    memset(&t.image, 0, sizeof(t.image));
+    t.state = TARGET_REMOVED;
+    return true;
+}
+
+size_t DecryptRegistry::resolve()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return resolve_locked();
+}
+
+size_t DecryptRegistry::resolve_locked()
+{
+    ResolveContext ctx;
+    ctx.first = true;
+    ctx.resolved = 0;
+    for (auto& t : m_targets) {
+        if (t->state != TARGET_PENDING && t->state != TARGET_NOT_FOUND) continue;
+        t->state = TARGET_PENDING;
+        if (t->lm) {
+            ctx.by_name[t->lm->l_name].push_back(t.get());
+        } else {
+            ctx.by_addr.push_back(std::make_pair(t->addr, t.get()));
+        }
+    }
+    if (ctx.by_name.empty() && ctx.by_addr.empty()) return 0;
+    std::sort(ctx.by_addr.begin(), ctx.by_addr.end());
+
+    dl_iterate_phdr(resolve_callback, &ctx);
+
+    for (auto& t : m_targets) {
+        // 按地址解析到的目标：此后同样持有镜像引用
+        if (t->state == TARGET_RESOLVED && !t->handle) {
+            t->handle = pin_address(t->addr, t->lm);
+            if (!t->handle) {
+                t->state = TARGET_NOT_FOUND;
+                ctx.resolved--;
+            }
+            continue;
+        }
+        if (t->state != TARGET_PENDING) continue;
+        // dl_iterate_phdr 只遍历调用者所在的命名空间，其他 dlmopen 命名空间的目标直接从 link_map 解析
+        if (t->lm && ImageLocator::fromLinkMap(t->lm, t->image)) {
+            t->state = TARGET_RESOLVED;
+            ctx.resolved++;
+        } else {
+            t->state = TARGET_NOT_FOUND;
+        }
+    }
+    return ctx.resolved;
+}
+
+bool DecryptRegistry::load_table_locked(TargetImage& t)
+{
+    if (t.table) return !t.table->empty();
+
+    // 解密器自身所在镜像：与 Decryptor 的按函数解密共享同一张表
+    ImageInfo self;
+    if (ImageLocator::findByAddress((const void*)&EncryptTable::self, self) && self.phdr == t.image.phdr) {
+        t.table = &EncryptTable::self();
+    } else {
+        t.own_table.reset(new EncryptTable());
+        t.own_table->loadImage(t.image);
+        t.table = t.own_table.get();
+    }
+    return !t.table->empty();
+}
+
+bool DecryptRegistry::decryptAll()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    resolve_locked();
+
+    const uintptr_t page_mask = ~((uintptr_t)sysconf(_SC_PAGESIZE) - 1);
+    std::vector<TargetImage*> work;
+    std::vector<DecryptTarget> ranges;
+    TargetImage* self_target = nullptr;
+    bool ok = true;
+
+    for (auto& tp : m_targets) {
+        TargetImage& t = *tp;
+        if (t.state == TARGET_NOT_FOUND || t.state == TARGET_FAILED) {
+            ok = false;
+            continue;
+        }
+        if (t.state != TARGET_RESOLVED) continue;
+        if (!load_table_locked(t)) {
+            DECRYPT_LOG_ERROR("[DecryptRegistry] No encrypt descriptor in %s\n", t.image.path);
+            t.state = TARGET_NO_DESCRIPTOR;
+            ok = false;
+            continue;
+        }
+        if (t.table->allDecrypted()) {
+            t.state = TARGET_DECRYPTED;
+            continue;
+        }
+        if (t.table == &EncryptTable::self()) {
+            self_target = &t;
+            continue;
+        }
+
+        uintptr_t start = 0;
+        size_t size = 0;
+        t.table->extent(start, size);
+        work.push_back(&t);
+        ranges.push_back(DecryptTarget{start, size, chunk_decrypt, t.table});
+    }
+    std::unique_ptr<CheckCtx[]> checks(new CheckCtx[work.size()]);
+    for (size_t i = 0; i < work.size(); i++) {
+        checks[i].table = work[i]->table;
+        if (work[i]->table->hasChecksums()) {
+            ranges[i].fn = chunk_decrypt_checked;
+            ranges[i].ctx = &checks[i];
+        }
+    }
+    // 解密器自身所在镜像经 Decryptor 解密：与按函数解密、decrypt()/decryptAsync() 共用 g_func_mutex 与状态机
+    if (self_target) {
+        const Decryptor::DecryptError err = Decryptor::decryptSelf();
+        if (err == Decryptor::DECRYPT_OK) {
+            self_target->state = TARGET_DECRYPTED;
+        } else {
+            DECRYPT_LOG_ERROR("[DecryptRegistry] Failed to decrypt %s\n", self_target->image.path);
+            self_target->state = err == Decryptor::DECRYPT_ERR_INTEGRITY ? TARGET_BAD_CHECKSUM : TARGET_FAILED;
+            ok = false;
+        }
+    }
+    if (work.empty()) return ok;
+
+    // 按地址排序后把重叠或首尾相接的页区间合并，每个合并区间只做一次 mprotect RWX / 缓存同步 / mprotect RX；
+    // 不相接的区间之间可能是未映射的空洞或其他映射，不能跨过去
+    std::vector<size_t> order(work.size());
+    for (size_t i = 0; i < order.size(); i++) order[i] = i;
+    std::sort(order.begin(), order.end(), [&ranges](size_t a, size_t b) {
+        return ranges[a].sec_addr < ranges[b].sec_addr;
+    });
+    std::vector<Span> spans;
+    std::vector<size_t> span_of(work.size());
+    for (size_t i : order) {
+        const uintptr_t page_start = ranges[i].sec_addr & page_mask;
+        const uintptr_t page_end = (ranges[i].sec_addr + ranges[i].sec_size + ~page_mask) & page_mask;
+        if (spans.empty() || page_start > spans.back().page_end) {
+            spans.push_back(Span{page_start, page_end, ranges[i].sec_addr, ranges[i].sec_addr + ranges[i].sec_size, true});
+        } else {
+            Span& s = spans.back();
+            s.page_end = std::max(s.page_end, page_end);
+            s.sec_end = std::max(s.sec_end, ranges[i].sec_addr + ranges[i].sec_size);
+        }
+        span_of[i] = spans.size() - 1;
+    }
+
+    for (Span& s : spans) {
+        if (mprotect((void*)s.page_start, s.page_end - s.page_start, PROT_READ | PROT_WRITE | PROT_EXEC) != 0) {
+            DECRYPT_LOG_ERROR("[DecryptRegistry] Failed to set RWX at 0x%lx: %s\n",
+                              (unsigned long)s.page_start, strerror(errno));
+            s.writable = false;
+            ok = false;
+        }
+    }
+    std::vector<DecryptTarget> writable;
+    writable.reserve(ranges.size());
+    for (size_t i = 0; i < work.size(); i++) {
+        if (spans[span_of[i]].writable) {
+            writable.push_back(ranges[i]);
+        } else {
+            work[i]->state = TARGET_FAILED;
+        }
+    }
+
+    // 所有目标一次分块并行解密
+    if (!writable.empty()) ParallelDecryptor::run(writable.data(), writable.size());
+
+    // 逐目标校验明文：不符的目标用同一密钥流再异或一次恢复为密文，其余目标不受影响
+    std::vector<DecryptTarget> rollback;
+    for (size_t i = 0; i < work.size(); i++) {
+        if (work[i]->state == TARGET_FAILED || ranges[i].ctx != &checks[i]) continue;
+        size_t bad = 0;
+        if (checks[i].sums.verify(*work[i]->table, bad)) continue;
+        const EncryptBlock& b = work[i]->table->block(bad);
+        DECRYPT_LOG_ERROR("[DecryptRegistry] Plaintext CRC32C mismatch in %s block %zu at 0x%lx (%zu bytes)\n",
+                          work[i]->image.path, bad, (unsigned long)b.sec_addr, b.sec_size);
+        work[i]->state = TARGET_BAD_CHECKSUM;
+        rollback.push_back(DecryptTarget{ranges[i].sec_addr, ranges[i].sec_size, chunk_decrypt, work[i]->table});
+        ok = false;
+    }
+    if (!rollback.empty()) ParallelDecryptor::run(rollback.data(), rollback.size());
+
+    for (Span& s : spans) {
+        if (!s.writable) continue;
+        flush_cache((uint8_t*)s.sec_start, s.sec_end - s.sec_start);
+        if (mprotect((void*)s.page_start, s.page_end - s.page_start, PROT_READ | PROT_EXEC) != 0) {
+            DECRYPT_LOG_ERROR("[DecryptRegistry] mprotect RX at 0x%lx failed: %s\n",
+                              (unsigned long)s.page_start, strerror(errno));
+            s.writable = false;
+            ok = false;
+        }
+    }
+    size_t decrypted = 0;
+    for (size_t i = 0; i < work.size(); i++) {
+        TargetImage& t = *work[i];
+        if (t.state == TARGET_FAILED || t.state == TARGET_BAD_CHECKSUM) continue;
+        // 已解密但没能恢复 RX 的目标仍标记已解密，避免再次异或
+        t.table->markAllDecrypted();
+        if (!spans[span_of[i]].writable) {
+            DECRYPT_LOG_ERROR("[DecryptRegistry] Failed to restore RX for %s\n", t.image.path);
+            t.state = TARGET_FAILED;
+            continue;
+        }
+        t.state = TARGET_DECRYPTED;
+        decrypted++;
+    }
+    DECRYPT_LOG_INFO("[DecryptRegistry] Decrypted %zu targets in %zu ranges (%zu threads)\n", decrypted, spans.size(),
+                     ParallelDecryptor::lastThreads());
+    return ok;
+}
+
+TargetState DecryptRegistry::state(int id) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return (id >= 0 && (size_t)id < m_targets.size()) ? m_targets[id]->state : TARGET_NOT_FOUND;
+}
+
+const TargetImage* DecryptRegistry::target(int id) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return (id >= 0 && (size_t)id < m_targets.size()) ? m_targets[id].get() : nullptr;
+}
+
+const char* DecryptRegistry::stateName(TargetState state)
+{
+    switch (state) {
+        case TARGET_PENDING:        return "pending";
+        case TARGET_RESOLVED:       return "resolved";
+        case TARGET_DECRYPTED:      return "decrypted";
+        case TARGET_NOT_FOUND:      return "not-found";
+        case TARGET_NO_DESCRIPTOR:  return "no-descriptor";
+        case TARGET_FAILED:         return "failed";
+        case TARGET_REMOVED:        return "removed";
+        case TARGET_BAD_CHECKSUM:   return "bad-checksum";
+    }
+    return "unknown";
+}
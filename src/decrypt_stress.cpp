@@ -0,0 +1,134 @@
+#include "decryptor_linux.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <sched.h>
+#include <sys/wait.h>
+
+// ===================== decrypt() 并发压力测试 =====================
+// 每轮在新进程中启动 threads 个线程，全部就绪后同时调用 Decryptor::decrypt()，
+// 随后立即执行加密载荷中的成员函数并与明文实现比对；部分线程不调用 decrypt()，
+// 只在 isDecrypted() 变为 true 后执行加密函数。任何一次重复异或都会导致结果错误或崩溃。
+// 用法：decrypt_stress [rounds] [threads]
+
+class StressWorker {
+public:
+    explicit StressWorker(uint64_t seed);
+    uint64_t step(uint64_t x);
+    uint64_t value() const;
+
+private:
+    uint64_t m_acc;
+};
+
+// 与加密载荷相同的明文实现
+static uint64_t reference_run(uint64_t seed)
+{
+    uint64_t acc = seed ^ 0x9E3779B97F4A7C15ull;
+    for (uint64_t i = 0; i < 16; i++) {
+        acc ^= i + (acc << 6) + (acc >> 2);
+        acc *= 0xFF51AFD7ED558CCDull;
+    }
+    return acc ^ (acc >> 33);
+}
+
+static uint64_t encrypted_run(uint64_t seed)
+{
+    StressWorker w(seed);
+    for (uint64_t i = 0; i < 16; i++) {
+        w.step(i);
+    }
+    return w.value();
+}
+
+static inline uint64_t now_ns()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+struct RoundResult {
+    uint32_t failures;
+    uint32_t decrypt_false;
+    uint32_t raced;             // 调用 decrypt() 时解密已在进行中的线程数
+    uint64_t elapsed_ns;
+};
+
+static int run_round(size_t thread_count, int out_fd)
+{
+    Decryptor::setTargetInfo(Decryptor::TYPE_STATIC_A, nullptr);
+
+    std::atomic<size_t> ready(0);
+    std::atomic<bool> go(false);
+    std::atomic<uint32_t> failures(0), decrypt_false(0), raced(0);
+
+    std::vector<std::thread> threads;
+    threads.reserve(thread_count);
+    for (size_t t = 0; t < thread_count; t++) {
+        threads.emplace_back([&, t] {
+            ready.fetch_add(1, std::memory_order_relaxed);
+            while (!go.load(std::memory_order_acquire)) sched_yield();
+
+            // 每 8 个线程中有 1 个只轮询 isDecrypted()
+            if (t % 8 == 7) {
+                while (!Decryptor::isDecrypted()) sched_yield();
+            } else {
+                if (Decryptor::state() == Decryptor::STATE_IN_PROGRESS) raced.fetch_add(1, std::memory_order_relaxed);
+                if (!Decryptor::decrypt()) decrypt_false.fetch_add(1, std::memory_order_relaxed);
+                if (!Decryptor::isDecrypted()) failures.fetch_add(1, std::memory_order_relaxed);
+            }
+            if (encrypted_run(t) != reference_run(t)) failures.fetch_add(1, std::memory_order_relaxed);
+        });
+    }
+    while (ready.load(std::memory_order_relaxed) < thread_count) sched_yield();
+
+    const uint64_t t0 = now_ns();
+    go.store(true, std::memory_order_release);
+    for (std::thread& th : threads) th.join();
+
+    RoundResult r = {failures.load(), decrypt_false.load(), raced.load(), now_ns() - t0};
+    return write(out_fd, &r, sizeof(r)) == (ssize_t)sizeof(r) ? 0 : 2;
+}
+
+int main(int argc, char* argv[])
+{
+    const size_t rounds = argc > 1 ? strtoul(argv[1], nullptr, 10) : 20;
+    const size_t thread_count = argc > 2 ? strtoul(argv[2], nullptr, 10) : 256;
+    printf("decrypt() race: %zu rounds x %zu threads (1/8 only poll isDecrypted())\n", rounds, thread_count);
+    printf("%6s %10s %8s %8s %8s\n", "round", "time(ms)", "raced", "false", "errors");
+
+    size_t bad_rounds = 0;
+    for (size_t i = 0; i < rounds; i++) {
+        int fds[2];
+        if (pipe(fds) != 0) return 1;
+        fflush(stdout);
+        const pid_t pid = fork();
+        if (pid == 0) {
+            close(fds[0]);
+            // 子进程中每个线程都会输出 decrypt() 日志，丢弃
+            if (!freopen("/dev/null", "w", stdout)) _exit(3);
+            _exit(run_round(thread_count, fds[1]));
+        }
+        close(fds[1]);
+        RoundResult r;
+        const bool got = read(fds[0], &r, sizeof(r)) == (ssize_t)sizeof(r);
+        close(fds[0]);
+        int status = 0;
+        waitpid(pid, &status, 0);
+
+        if (!got || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            printf("%6zu   crashed (status 0x%x)\n", i, status);
+            bad_rounds++;
+            continue;
+        }
+        printf("%6zu %10.2f %8u %8u %8u\n", i, r.elapsed_ns / 1e6, r.raced, r.decrypt_false, r.failures);
+        if (r.failures || r.decrypt_false) bad_rounds++;
+    }
+    printf("%s: %zu/%zu rounds clean\n", bad_rounds ? "FAILED" : "OK", rounds - bad_rounds, rounds);
+    return bad_rounds ? 1 : 0;
+}
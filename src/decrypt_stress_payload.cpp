@@ -0,0 +1,37 @@
+#include "decryptor_linux.h"
+
+// ========== decrypt_stress 加密载荷（构建时由 encrypt_tool 加密） ==========
+// 一个带加密成员函数的类 + 4MB 冷函数，拉长整段解密时间，让并发的 decrypt() 调用真正重叠
+
+__asm__(".pushsection .encrypt_text,\"ax\",@progbits\n"
+        ".p2align 4\n"
+        ".type stress_cold,@function\n"
+        "stress_cold:\n"
+        ".fill 4194304,1,0x90\n"
+        "ret\n"
+        ".size stress_cold,.-stress_cold\n"
+        ".popsection\n");
+
+class StressWorker {
+public:
+    explicit StressWorker(uint64_t seed);
+    uint64_t step(uint64_t x);
+    uint64_t value() const;
+
+private:
+    uint64_t m_acc;
+};
+
+CRYPT_FUNC StressWorker::StressWorker(uint64_t seed) : m_acc(seed ^ 0x9E3779B97F4A7C15ull) {}
+
+CRYPT_FUNC __attribute__((noinline)) uint64_t StressWorker::step(uint64_t x)
+{
+    m_acc ^= x + (m_acc << 6) + (m_acc >> 2);
+    m_acc *= 0xFF51AFD7ED558CCDull;
+    return m_acc;
+}
+
+CRYPT_FUNC __attribute__((noinline)) uint64_t StressWorker::value() const
+{
+    return m_acc ^ (m_acc >> 33);
+}
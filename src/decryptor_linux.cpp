@@ -1,4 +1,12 @@
 #include "decryptor_linux.h"
+#include "lazy_decrypt.h"
+#include "encrypt_table.h"
+#include "parallel_decrypt.h"
+#include "image_locator.h"
+#include "huge_text.h"
+#include "memfd_text.h"
+#include "shared_text_cache.h"
+#include "decrypt_log.h"
 #include <cstdio>
 #include <fcntl.h>
 #include <sys/mman.h>
@@ -11,8 +19,15 @@
 #include <stdlib.h>
 #include <sys/syscall.h>
 #include <sys/ptrace.h>
+#include <linux/futex.h>
 #include <algorithm>
-#include <cpuid.h>  // x86_64缓存刷新依赖
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <time.h>
+#include <sys/resource.h>
 
 // ===================== ptrace反调试函数（保留，注释核心逻辑） =====================
 void ptrace_anti_debug_check(void) {
@@ -31,9 +46,314 @@ void ptrace_anti_debug_check(void) {
 Decryptor::TargetType Decryptor::g_target_type = Decryptor::TYPE_SO;
 uintptr_t Decryptor::g_base_addr = 0;
 char Decryptor::TARGET_NAME[PATH_MAX] = {0};
-bool Decryptor::g_is_decrypted = false;
+std::atomic<uint32_t> Decryptor::g_state(Decryptor::STATE_IDLE);
 char Decryptor::g_target_path[PATH_MAX] = {0};
 bool Decryptor::g_target_loaded = false;
+Decryptor::DecryptMode Decryptor::g_decrypt_mode = Decryptor::MODE_EAGER;
+bool Decryptor::g_huge_pages = false;
+Decryptor::DecryptEngine Decryptor::g_decrypt_engine = Decryptor::ENGINE_MPROTECT;
+
+// 共享明文缓存目录，空串表示不使用
+static char g_shared_cache_dir[PATH_MAX] = {0};
+
+// 按函数解密与整段解密互斥（函数状态在锁内修改）
+static std::mutex g_func_mutex;
+
+// 进行中状态上的等待者标志：完成方只在有等待者时才发 FUTEX_WAKE
+static const uint32_t STATE_WAITERS = 0x100;
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "futex word layout");
+
+static void futex_wait(std::atomic<uint32_t>* word, uint32_t expected)
+{
+    syscall(SYS_futex, (uint32_t*)word, FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+}
+
+static void futex_wake_all(std::atomic<uint32_t>* word)
+{
+    syscall(SYS_futex, (uint32_t*)word, FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+}
+
+// 启动画像：载入的解密顺序 / 记录中的各函数首次调用时间（0 表示未调用）
+static std::vector<long> g_profile_order;
+static char g_profile_record_path[PATH_MAX] = {0};
+static std::unique_ptr<std::atomic<uint64_t>[]> g_first_call_ns;
+static std::atomic<bool> g_recording(false);
+static uint64_t g_record_start_ns = 0;
+
+static uint64_t monotonic_ns()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+// 最近一次 decrypt() 的统计（run_decrypt 开始时清零，只由持有解密权的线程写）；
+// 解密字节数由分块并行解密的各线程累加，结束时汇总
+static Decryptor::Stats g_stats;
+static std::atomic<uint64_t> g_bytes_decrypted(0);
+
+// 把 [start, 现在) 计入 phase，返回现在（作为下一阶段起点）
+static uint64_t phase_end(Decryptor::DecryptPhase phase, uint64_t start)
+{
+    const uint64_t now = monotonic_ns();
+    g_stats.phase_ns[phase] += now - start;
+    return now;
+}
+
+static int counted_mprotect(uintptr_t addr, size_t len, int prot)
+{
+    g_stats.mprotect_calls++;
+    return mprotect((void*)addr, len, prot);
+}
+
+#ifndef MADV_POPULATE_READ
+#define MADV_POPULATE_READ 22   // Linux 5.14+
+#endif
+#ifndef MADV_POPULATE_WRITE
+#define MADV_POPULATE_WRITE 23
+#endif
+
+// 一次 madvise 预先建立 [page_start, page_start+page_len) 的页表（write 时按写缺页处理，私有映射完成写时复制），
+// 代替逐页触碰；区间含未映射或不可访问的页时返回 false。
+// 内核不支持 MADV_POPULATE_*（EINVAL）时退回 MADV_WILLNEED，只预读页缓存
+static bool prefault_range(uintptr_t page_start, size_t page_len, bool write)
+{
+    if (page_start == 0 || page_len == 0) return false;
+    if (madvise((void*)page_start, page_len, write ? MADV_POPULATE_WRITE : MADV_POPULATE_READ) == 0) return true;
+    if (errno == EINVAL) {
+        return madvise((void*)page_start, page_len, MADV_WILLNEED) == 0 || errno != ENOMEM;
+    }
+    DECRYPT_LOG_ERROR("[Decryptor] Prefault 0x%lx (%zu bytes) failed: %s\n",
+                      (unsigned long)page_start, page_len, strerror(errno));
+    return false;
+}
+
+// 目标镜像（find_* 填写）及其加密表（目标不是解密器自身所在镜像时使用）
+static ImageInfo g_target_image;
+static bool g_target_image_valid = false;
+static EncryptTable g_target_table;
+
+// 加密表是否描述该段（表只覆盖链接了解密器的镜像，目标为其他SO时退回整段异或）
+static EncryptTable* table_for_section(uintptr_t sec_addr, size_t sec_size)
+{
+    EncryptTable& table = EncryptTable::self();
+    if (table.empty()) return nullptr;
+    const EncryptBlock& b = table.block(0);
+    if (b.sec_addr < sec_addr || b.sec_addr + b.sec_size > sec_addr + sec_size) return nullptr;
+    return &table;
+}
+
+// ===================== 加密表密钥 =====================
+const CipherKey& runtime_cipher_key()
+{
+    static const CipherKey key = [] {
+        // 各实现的分发状态在这里定下来，缺页处理函数里的解密不再经过任何首次初始化
+        AesCtrPolicy::activeIsa();
+        XorKernel::activeIsa();
+        uint8_t warm[128] = {0};
+        XOR_CIPHER.apply(warm, sizeof(warm));
+        return CipherKey{&XOR_CIPHER, &AES128_CIPHER, &AES256_CIPHER};
+    }();
+    return key;
+}
+
+// 惰性模式区间回调：按加密表跳过重定位空洞与挂起前已按函数解密的函数
+// （挂起后区间内的函数不再单独解密，同一页再调用一次仍能恢复密文）
+static void lazy_table_decrypt(uintptr_t start, size_t len, uintptr_t, void* ctx)
+{
+    ((const EncryptTable*)ctx)->decryptPending(start, len, runtime_cipher_key());
+}
+
+// 分块并行解密回调：按表解密时跳过已单独解密的函数；无表时整段异或
+static void chunk_table_decrypt(uintptr_t start, size_t len, uintptr_t, void* ctx)
+{
+    const size_t n = ((const EncryptTable*)ctx)->decryptPending(start, len, runtime_cipher_key());
+    g_bytes_decrypted.fetch_add(n, std::memory_order_relaxed);
+}
+
+// 分块并行解密并校验明文：ctx 为 TableCheckCtx
+struct TableCheckCtx {
+    const EncryptTable* table;
+    PlainChecksum* sums;
+};
+
+static void chunk_table_decrypt_checked(uintptr_t start, size_t len, uintptr_t, void* ctx)
+{
+    const TableCheckCtx& c = *(const TableCheckCtx*)ctx;
+    const size_t n = c.table->decryptPendingChecked(start, len, runtime_cipher_key(), *c.sums);
+    g_bytes_decrypted.fetch_add(n, std::memory_order_relaxed);
+}
+
+static std::atomic<bool> g_integrity_failed(false);
+static std::atomic<uint32_t> g_last_error(Decryptor::DECRYPT_OK);
+
+// 合并各分块的 CRC 片段并与描述符比较；不符时记录原因
+static bool plaintext_ok(const EncryptTable& table, const PlainChecksum& sums)
+{
+    size_t bad = 0;
+    if (sums.verify(table, bad)) return true;
+    const EncryptBlock& b = table.block(bad);
+    DECRYPT_LOG_ERROR("[Decryptor] Plaintext CRC32C mismatch in block %zu at 0x%lx (%zu bytes): "
+                      "wrong key, encrypted twice or corrupted file\n",
+                      bad, (unsigned long)b.sec_addr, b.sec_size);
+    g_integrity_failed.store(true, std::memory_order_relaxed);
+    return false;
+}
+
+// 按表分块并行解密 [start, start+len) 中尚未解密的部分；带校验和时校验明文，不符则用同一密钥流
+// 再异或一次回滚为密文（单独解密过的函数本次未改动）。调用方已设好可写权限并持有 g_func_mutex
+static bool table_decrypt_verified(EncryptTable& table, uintptr_t start, size_t len)
+{
+    if (table.allDecrypted()) return true;
+    if (!table.hasChecksums()) {
+        DecryptTarget target = {start, len, chunk_table_decrypt, &table};
+        ParallelDecryptor::run(&target, 1);
+        table.markAllDecrypted();
+        return true;
+    }
+    PlainChecksum sums;
+    TableCheckCtx ctx = {&table, &sums};
+    DecryptTarget target = {start, len, chunk_table_decrypt_checked, &ctx};
+    ParallelDecryptor::run(&target, 1);
+    if (!plaintext_ok(table, sums)) {
+        target.fn = chunk_table_decrypt;
+        target.ctx = &table;
+        ParallelDecryptor::run(&target, 1);
+        return false;
+    }
+    table.markAllDecrypted();
+    return true;
+}
+
+static void record_last_error(bool ok)
+{
+    g_last_error.store(ok ? Decryptor::DECRYPT_OK
+                          : g_integrity_failed.load(std::memory_order_relaxed) ? Decryptor::DECRYPT_ERR_INTEGRITY
+                                                                               : Decryptor::DECRYPT_ERR_FAILED,
+                       std::memory_order_relaxed);
+}
+
+static void chunk_xor_decrypt(uintptr_t start, size_t len, uintptr_t sec_start, void*)
+{
+    XOR_CIPHER.apply((uint8_t*)start, len, 0, start - sec_start);
+    g_bytes_decrypted.fetch_add(len, std::memory_order_relaxed);
+}
+
+// memfd 引擎 / 共享缓存分块回调的上下文：明文写进 view（文件中对应 page_start 的区间的可写映射）
+struct MemfdFillCtx {
+    const EncryptTable* table;      // 为空时整段异或
+    uintptr_t sec_addr;
+    size_t sec_size;
+    uintptr_t page_start;
+    size_t page_len;
+    uint8_t* view;
+    PlainChecksum* sums;            // 非空时顺带计算明文校验和
+};
+
+static const size_t MEMFD_BOUNCE_SIZE = (size_t)16 << 10;
+
+// out 中已有 [live, live+n) 的密文副本：就地解密（原加密页不动），返回经过密钥流的字节数
+static size_t decrypt_at(const MemfdFillCtx& c, uintptr_t live, size_t n, uint8_t* out)
+{
+    if (c.table) {
+        const intptr_t delta = (intptr_t)((uintptr_t)out - live);
+        return c.sums ? c.table->decryptPendingChecked(live, n, runtime_cipher_key(), *c.sums, delta)
+                      : c.table->decryptPending(live, n, runtime_cipher_key(), delta);
+    }
+    const uintptr_t lo = std::max(live, c.sec_addr);
+    const uintptr_t hi = std::min(live + n, c.sec_addr + c.sec_size);
+    if (hi <= lo) return 0;
+    XOR_CIPHER.apply(out + (lo - live), hi - lo, 0, lo - c.sec_addr);
+    return hi - lo;
+}
+
+// 把 [live, live+n) 的现有内容复制到 out 后解密
+static size_t decrypt_copy(const MemfdFillCtx& c, uintptr_t live, size_t n, uint8_t* out)
+{
+    memcpy(out, (const void*)live, n);
+    return decrypt_at(c, live, n, out);
+}
+
+// 分块就地解密映射中的密文副本
+static void chunk_memfd_fill(uintptr_t start, size_t len, uintptr_t, void* ctx)
+{
+    MemfdFillCtx& c = *(MemfdFillCtx*)ctx;
+    const size_t bytes = decrypt_at(c, start, len, c.view + (start - c.page_start));
+    g_bytes_decrypted.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+// 整页范围解密写进 fd 中 offset 起的区间：先一次 pwrite 把密文复制进文件（内核直接分配页缓存页并写入，
+// 不像先建映射再写那样多一遍清零），再以 MAP_POPULATE 的共享可写映射就地解密；系统调用数与区间大小无关。
+// 返回前解除映射，之后才能加写封印
+static bool fill_mapped(MemfdFillCtx& c, int fd, off_t offset)
+{
+    for (size_t done = 0; done < c.page_len;) {
+        const ssize_t n = pwrite(fd, (const void*)(c.page_start + done), c.page_len - done, offset + (off_t)done);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) {
+            DECRYPT_LOG_ERROR("[Decryptor] Cannot copy %zu bytes into file: %s\n", c.page_len,
+                              n < 0 ? strerror(errno) : "short write");
+            return false;
+        }
+        done += (size_t)n;
+    }
+    void* view = mmap(nullptr, c.page_len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, offset);
+    if (view == MAP_FAILED) {
+        DECRYPT_LOG_ERROR("[Decryptor] Cannot map %zu bytes for writing: %s\n", c.page_len, strerror(errno));
+        return false;
+    }
+    c.view = (uint8_t*)view;
+    DecryptTarget target = {c.page_start, c.page_len, chunk_memfd_fill, &c};
+    ParallelDecryptor::run(&target, 1);
+    munmap(view, c.page_len);
+    c.view = nullptr;
+    return true;
+}
+
+// 共享缓存未命中：整页范围解密写入条目文件；明文校验不通过时不发布
+static bool shared_cache_fill(int fd, off_t offset, void* ctx)
+{
+    MemfdFillCtx& c = *(MemfdFillCtx*)ctx;
+    PlainChecksum sums;
+    c.sums = c.table && c.table->hasChecksums() ? &sums : nullptr;
+    const bool ok = fill_mapped(c, fd, offset) && (!c.sums || plaintext_ok(*c.table, sums));
+    c.sums = nullptr;
+    return ok;
+}
+
+// 共享缓存条目抽查：首、中、尾三页与本进程现场解密的结果逐字节比较
+static bool shared_cache_verify(const uint8_t* plain, void* ctx)
+{
+    const MemfdFillCtx& c = *(const MemfdFillCtx*)ctx;
+    const size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+    const size_t pages = c.page_len / page_size;
+    const size_t samples[3] = {0, pages / 2, pages - 1};
+    alignas(64) uint8_t bounce[MEMFD_BOUNCE_SIZE];
+    for (size_t idx : samples) {
+        const size_t off = idx * page_size;
+        decrypt_copy(c, c.page_start + off, page_size, bounce);
+        if (memcmp(bounce, plain + off, page_size) != 0) return false;
+    }
+    return true;
+}
+
+// 共享缓存键中的密钥指纹：用 AES-256 密钥对异或密钥与描述符格式做 CBC-MAC，不暴露任一密钥
+static uint64_t cipher_key_fingerprint()
+{
+    uint8_t msg[(sizeof(cipher_keys::XOR_KEY) + 8 + AES_BLOCK_SIZE - 1) / AES_BLOCK_SIZE * AES_BLOCK_SIZE] = {0};
+    const uint32_t format[2] = {ENCRYPT_TABLE_VERSION, ENCRYPT_NOTE_TYPE};
+    memcpy(msg, cipher_keys::XOR_KEY, sizeof(cipher_keys::XOR_KEY));
+    memcpy(msg + sizeof(cipher_keys::XOR_KEY), format, sizeof(format));
+    uint8_t mac[AES_BLOCK_SIZE] = {0};
+    for (size_t off = 0; off < sizeof(msg); off += AES_BLOCK_SIZE) {
+        uint8_t in[AES_BLOCK_SIZE];
+        for (size_t i = 0; i < AES_BLOCK_SIZE; i++) in[i] = mac[i] ^ msg[off + i];
+        AesCtrPolicy::encryptBlock<32>(AES256_CIPHER.schedule(), in, mac);
+    }
+    uint64_t fp = 0;
+    memcpy(&fp, mac, sizeof(fp));
+    return fp;
+}
 
 // ===================== Decryptor 核心实现 =====================
 Decryptor& Decryptor::getInstance() {
@@ -41,21 +361,105 @@ Decryptor& Decryptor::getInstance() {
     return instance;
 }
 
+// ===================== 解密状态机 =====================
+// 获得解密权（IDLE/FAILED -> IN_PROGRESS）返回 true；否则 result 为已有的结果。
+// wait 为 true 时遇到进行中的解密先在 futex 上等待它结束；等到的是失败结果时不再重试，直接返回失败
+bool Decryptor::begin_decrypt(bool wait, bool& result) {
+    bool waited = false;
+    uint32_t s = g_state.load(std::memory_order_acquire);
+    for (;;) {
+        if (s == STATE_DONE || (s == STATE_FAILED && waited)) {
+            result = (s == STATE_DONE);
+            return false;
+        }
+        if (s == STATE_IDLE || s == STATE_FAILED) {
+            if (g_state.compare_exchange_weak(s, STATE_IN_PROGRESS, std::memory_order_acquire,
+                                              std::memory_order_acquire)) {
+                return true;
+            }
+            continue;
+        }
+        // 进行中
+        if (!wait) {
+            result = false;
+            return false;
+        }
+        if (!(s & STATE_WAITERS) &&
+            !g_state.compare_exchange_weak(s, s | STATE_WAITERS, std::memory_order_acquire,
+                                           std::memory_order_acquire)) {
+            continue;
+        }
+        futex_wait(&g_state, STATE_IN_PROGRESS | STATE_WAITERS);
+        waited = true;
+        s = g_state.load(std::memory_order_acquire);
+    }
+}
+
+// 发布结果（release：解密写入的代码对 acquire 读到 DONE 的线程可见），有等待者时唤醒
+void Decryptor::end_decrypt(bool ok) {
+    const uint32_t old = g_state.exchange(ok ? STATE_DONE : STATE_FAILED, std::memory_order_release);
+    if (old & STATE_WAITERS) {
+        futex_wake_all(&g_state);
+    }
+}
+
+// 等待进行中的解密结束（不发起解密），返回是否已解密
+bool Decryptor::wait_decrypt() {
+    uint32_t s = g_state.load(std::memory_order_acquire);
+    while ((s & ~STATE_WAITERS) == STATE_IN_PROGRESS) {
+        if (!(s & STATE_WAITERS) &&
+            !g_state.compare_exchange_weak(s, s | STATE_WAITERS, std::memory_order_acquire,
+                                           std::memory_order_acquire)) {
+            continue;
+        }
+        futex_wait(&g_state, STATE_IN_PROGRESS | STATE_WAITERS);
+        s = g_state.load(std::memory_order_acquire);
+    }
+    return s == STATE_DONE;
+}
+
+Decryptor::DecryptError Decryptor::lastError() {
+    return (DecryptError)g_last_error.load(std::memory_order_relaxed);
+}
+
+Decryptor::DecryptState Decryptor::state() {
+    return (DecryptState)(g_state.load(std::memory_order_acquire) & ~STATE_WAITERS);
+}
+
 bool Decryptor::decrypt() {
     ptrace_anti_debug_check();
 
-    Decryptor& instance = getInstance();
-    if (g_is_decrypted) {
-        printf("[Decryptor] Already decrypted\n");
+    if (isDecrypted()) {
+        DECRYPT_LOG_INFO("[Decryptor] Already decrypted\n");
         return true;
     }
 
+    bool result = false;
+    if (!begin_decrypt(true, result)) {
+        DECRYPT_LOG_INFO("[Decryptor] Decrypted by another thread: %s\n", result ? "success" : "failed");
+        return result;
+    }
+    const bool ret = run_decrypt();
+    end_decrypt(ret);
+    return ret;
+}
+
+// 实际解密流程，调用方已通过 begin_decrypt() 获得解密权（目标路径/基址等静态变量只在这里改写）
+bool Decryptor::run_decrypt() {
+    Decryptor& instance = getInstance();
+
     if (g_target_type == TYPE_SO && strlen(TARGET_NAME) == 0) {
-        fprintf(stderr, "[Decryptor] Error: TYPE_SO need target name\n");
+        DECRYPT_LOG_ERROR("[Decryptor] Error: TYPE_SO need target name\n");
         return false;
     }
 
-    printf("[Decryptor] Start decrypt (type: %d, name: %s)\n", g_target_type, TARGET_NAME);
+    DECRYPT_LOG_INFO("[Decryptor] Start decrypt (type: %d, name: %s)\n", g_target_type, TARGET_NAME);
+    memset(&g_stats, 0, sizeof(g_stats));
+    g_bytes_decrypted.store(0, std::memory_order_relaxed);
+    g_integrity_failed.store(false, std::memory_order_relaxed);
+    struct rusage ru_start;
+    getrusage(RUSAGE_SELF, &ru_start);
+    const uint64_t t0 = monotonic_ns();
     g_target_loaded = false;
     memset(g_target_path, 0, sizeof(g_target_path));
     g_base_addr = 0;
@@ -67,23 +471,35 @@ bool Decryptor::decrypt() {
         ret = instance.decrypt_executable_section_impl();
     }
 
+    g_stats.total_ns = monotonic_ns() - t0;
+    struct rusage ru_end;
+    getrusage(RUSAGE_SELF, &ru_end);
+    g_stats.minor_faults = (uint64_t)(ru_end.ru_minflt - ru_start.ru_minflt);
+    g_stats.major_faults = (uint64_t)(ru_end.ru_majflt - ru_start.ru_majflt);
+    g_stats.bytes_decrypted += g_bytes_decrypted.load(std::memory_order_relaxed);
+
+    record_last_error(ret);
     if (ret) {
-        g_is_decrypted = true;
-        printf("[Decryptor] Decrypt success!\n");
+        DECRYPT_LOG_INFO("[Decryptor] Decrypt success!\n");
         MEM_BAR();
     } else {
-        fprintf(stderr, "[Decryptor] Decrypt failed!\n");
+        DECRYPT_LOG_ERROR("[Decryptor] Decrypt failed!\n");
     }
     return ret;
 }
 
-bool Decryptor::isDecrypted() { 
-    return g_is_decrypted; 
-}
 
 void Decryptor::setTargetInfo(TargetType type, const char* name) {
+    // 解密进行中不允许切换目标；否则回到 IDLE，下一次 decrypt() 针对新目标
+    uint32_t s = g_state.load(std::memory_order_acquire);
+    do {
+        if ((s & ~STATE_WAITERS) == STATE_IN_PROGRESS) {
+            DECRYPT_LOG_ERROR("[Decryptor] setTargetInfo ignored: decrypt in progress\n");
+            return;
+        }
+    } while (!g_state.compare_exchange_weak(s, STATE_IDLE, std::memory_order_acq_rel, std::memory_order_acquire));
+
     g_target_type = type;
-    g_is_decrypted = false;
     g_target_loaded = false;
     memset(g_target_path, 0, sizeof(g_target_path));
     g_base_addr = 0;
@@ -93,26 +509,358 @@ void Decryptor::setTargetInfo(TargetType type, const char* name) {
         strncpy(TARGET_NAME, name, sizeof(TARGET_NAME)-1);
     }
     
-    printf("[DEBUG] Set target: type=%d, name=%s\n", type, TARGET_NAME);
+    DECRYPT_LOG_DEBUG("[Decryptor] Set target: type=%d, name=%s\n", type, TARGET_NAME);
 }
 
-bool Decryptor::is_address_accessible(uintptr_t addr, size_t len) {
-    const long page_size = sysconf(_SC_PAGESIZE);
-    if (page_size <= 0 || addr == 0 || len == 0) return false;
-    
-    // 避免访问内核空间等非法地址
-    if (addr >= (uintptr_t)0x7fffffffffff) return false;
-    
-    for (size_t i = 0; i < len; i += page_size) {
-        volatile uint8_t* p = (volatile uint8_t*)(addr + i);
-        uint8_t val = 0;
-        errno = 0;
-        // 显式转换volatile指针，解决memcpy类型错误
-        memcpy(&val, (const void*)p, 1);
-        if (errno != 0) return false;
-        (void)val;
+void Decryptor::setDecryptMode(DecryptMode mode) {
+    g_decrypt_mode = mode;
+    DECRYPT_LOG_DEBUG("[Decryptor] Decrypt mode: %s\n", mode == MODE_LAZY ? "lazy" : "eager");
+}
+
+size_t Decryptor::lazyPagesDecrypted() {
+    return LazyDecryptor::pagesDecrypted();
+}
+
+size_t Decryptor::lazyPagesTotal() {
+    return LazyDecryptor::pagesTotal();
+}
+
+uint64_t Decryptor::phaseNs(DecryptPhase phase) {
+    return (phase >= 0 && phase < PHASE_COUNT) ? g_stats.phase_ns[phase] : 0;
+}
+
+Decryptor::Stats Decryptor::stats() {
+    return g_stats;
+}
+
+const char* Decryptor::phaseName(DecryptPhase phase) {
+    static const char* const names[PHASE_COUNT] = {
+        "base_discovery", "file_map", "section_lookup", "probe",
+        "mprotect_rwx", "decrypt", "cache_flush", "mprotect_rx"
+    };
+    return (phase >= 0 && phase < PHASE_COUNT) ? names[phase] : "unknown";
+}
+
+bool Decryptor::setCacheSync(CacheSyncKind kind) {
+    if (!CacheSync::select(kind)) {
+        DECRYPT_LOG_ERROR("[Decryptor] Cache sync strategy %d not available, keep %s\n",
+                          (int)kind, CacheSync::current().name());
+        return false;
     }
-    
+    DECRYPT_LOG_DEBUG("[Decryptor] Cache sync strategy: %s\n", CacheSync::current().name());
+    return true;
+}
+
+void Decryptor::setParallelDecrypt(size_t threads, size_t threshold) {
+    ParallelDecryptor::setThreads(threads);
+    ParallelDecryptor::setThreshold(threshold);
+    DECRYPT_LOG_DEBUG("[Decryptor] Parallel decrypt: threads=%zu, threshold=%zu bytes\n",
+                      ParallelDecryptor::threads(), ParallelDecryptor::threshold());
+}
+
+void Decryptor::setDecryptEngine(DecryptEngine engine) {
+    g_decrypt_engine = engine;
+    DECRYPT_LOG_DEBUG("[Decryptor] Decrypt engine: %s\n", engine == ENGINE_MEMFD ? "memfd" : "mprotect");
+}
+
+void Decryptor::setSharedCache(const char* dir) {
+    memset(g_shared_cache_dir, 0, sizeof(g_shared_cache_dir));
+    if (dir) strncpy(g_shared_cache_dir, dir, sizeof(g_shared_cache_dir) - 1);
+    DECRYPT_LOG_DEBUG("[Decryptor] Shared cache: %s\n", g_shared_cache_dir[0] ? g_shared_cache_dir : "off");
+}
+
+void Decryptor::setHugePages(bool enable) {
+    g_huge_pages = enable;
+    DECRYPT_LOG_DEBUG("[Decryptor] Huge pages after decrypt: %s\n", enable ? "on" : "off");
+}
+
+bool Decryptor::decryptFunction(const void* fn) {
+    return decryptFunctions(&fn, 1);
+}
+
+bool Decryptor::decryptFunctions(const void* const* fns, size_t count) {
+    if (!fns || count == 0) return false;
+
+    EncryptTable& table = EncryptTable::self();
+    if (table.empty()) {
+        DECRYPT_LOG_ERROR("[Decryptor] No encrypt descriptor in image, per-function decrypt unavailable\n");
+        return false;
+    }
+
+    std::vector<long> idx;
+    idx.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        const long k = table.findFunction((uintptr_t)fns[i]);
+        if (k < 0) {
+            DECRYPT_LOG_ERROR("[Decryptor] %p is not an encrypted function\n", fns[i]);
+            return false;
+        }
+        if (table.funcState(k).load(std::memory_order_acquire) != FUNC_DECRYPTED) {
+            idx.push_back(k);
+        }
+    }
+    if (idx.empty()) return true;
+
+    std::lock_guard<std::mutex> lock(g_func_mutex);
+    if (g_decrypt_mode == MODE_LAZY) {
+        // 已挂起惰性解密的函数交给缺页处理；decrypt() 尚未挂起（或挂起的是其他镜像）时照常解密
+        idx.erase(std::remove_if(idx.begin(), idx.end(), [&table](long k) {
+            return LazyDecryptor::armed(table.func(k).addr);
+        }), idx.end());
+        if (idx.empty()) return true;
+    } else if (isDecrypted()) {
+        return true;
+    }
+    return decrypt_function_indices(idx.data(), idx.size());
+}
+
+// 调用方持有 g_func_mutex
+bool Decryptor::decrypt_function_indices(long* idx, size_t count) {
+    EncryptTable& table = EncryptTable::self();
+    const uintptr_t page_mask = ~((uintptr_t)sysconf(_SC_PAGESIZE) - 1);
+    const uintptr_t page_size = ~page_mask + 1;
+
+    std::sort(idx, idx + count, [&table](long a, long b) {
+        return table.func(a).addr < table.func(b).addr;
+    });
+
+    size_t i = 0;
+    while (i < count) {
+        // 合并页区间相交或相邻的函数
+        uintptr_t page_start = table.func(idx[i]).addr & page_mask;
+        uintptr_t page_end = (table.func(idx[i]).addr + table.func(idx[i]).size + page_size - 1) & page_mask;
+        size_t j = i + 1;
+        while (j < count && (table.func(idx[j]).addr & page_mask) <= page_end) {
+            const EncryptFunc& f = table.func(idx[j]);
+            page_end = std::max(page_end, (f.addr + f.size + page_size - 1) & page_mask);
+            j++;
+        }
+
+        if (mprotect((void*)page_start, page_end - page_start, PROT_READ | PROT_WRITE | PROT_EXEC) != 0) {
+            DECRYPT_LOG_ERROR("[Decryptor] Failed to set RWX permissions at 0x%lx: %s\n",
+                              (unsigned long)page_start, strerror(errno));
+            return false;
+        }
+        for (size_t k = i; k < j; k++) {
+            const EncryptFunc& f = table.func(idx[k]);
+            if (table.funcState(idx[k]).load(std::memory_order_relaxed) == FUNC_DECRYPTED) continue;
+            if (k > i && idx[k] == idx[k - 1]) continue;
+            table.funcState(idx[k]).store(FUNC_DECRYPTING, std::memory_order_relaxed);
+            table.decryptRange(f.addr, f.size, runtime_cipher_key());
+            flush_cache((uint8_t*)f.addr, f.size);
+        }
+        MEM_BAR();
+        if (mprotect((void*)page_start, page_end - page_start, PROT_READ | PROT_EXEC) != 0) {
+            DECRYPT_LOG_ERROR("[Decryptor] Failed to restore RX permissions at 0x%lx: %s\n",
+                              (unsigned long)page_start, strerror(errno));
+            return false;
+        }
+        for (size_t k = i; k < j; k++) {
+            table.funcState(idx[k]).store(FUNC_DECRYPTED, std::memory_order_release);
+        }
+        i = j;
+    }
+    return true;
+}
+
+// 整表剩余部分（函数间隙 + 未单独解密的函数），不依赖镜像路径与基址；明文校验不符时已回滚为密文
+Decryptor::DecryptError Decryptor::decrypt_table_remaining() {
+    EncryptTable& table = EncryptTable::self();
+    if (table.empty()) return DECRYPT_ERR_FAILED;
+
+    uintptr_t lo = 0;
+    size_t size = 0;
+    table.extent(lo, size);
+    const uintptr_t hi = lo + size;
+    const uintptr_t page_mask = ~((uintptr_t)sysconf(_SC_PAGESIZE) - 1);
+    const uintptr_t page_start = lo & page_mask;
+    const uintptr_t page_end = (hi + ~page_mask) & page_mask;
+
+    std::lock_guard<std::mutex> lock(g_func_mutex);
+    if (mprotect((void*)page_start, page_end - page_start, PROT_READ | PROT_WRITE | PROT_EXEC) != 0) {
+        DECRYPT_LOG_ERROR("[Decryptor] Failed to set RWX permissions at 0x%lx: %s\n",
+                          (unsigned long)page_start, strerror(errno));
+        return DECRYPT_ERR_FAILED;
+    }
+    const bool verified = table_decrypt_verified(table, lo, hi - lo);
+    flush_cache((uint8_t*)lo, hi - lo);
+    MEM_BAR();
+    if (mprotect((void*)page_start, page_end - page_start, PROT_READ | PROT_EXEC) != 0) {
+        DECRYPT_LOG_ERROR("[Decryptor] Failed to restore RX permissions at 0x%lx: %s\n",
+                          (unsigned long)page_start, strerror(errno));
+        return DECRYPT_ERR_FAILED;
+    }
+    return verified ? DECRYPT_OK : DECRYPT_ERR_INTEGRITY;
+}
+
+Decryptor::DecryptError Decryptor::decryptSelf() {
+    if (EncryptTable::self().empty()) return DECRYPT_ERR_FAILED;
+    // 状态机描述的是其他目标：只经 g_func_mutex 与按函数解密 / 整段解密互斥
+    if (g_target_type != TYPE_STATIC_A) return decrypt_table_remaining();
+
+    bool result = false;
+    if (!begin_decrypt(true, result)) return result ? DECRYPT_OK : lastError();
+    g_integrity_failed.store(false, std::memory_order_relaxed);
+    const DecryptError err = decrypt_table_remaining();
+    record_last_error(err == DECRYPT_OK);
+    end_decrypt(err == DECRYPT_OK);
+    return err;
+}
+
+bool Decryptor::decrypt_async_worker() {
+    EncryptTable& table = EncryptTable::self();
+
+    // 无加密表、目标为其他SO或惰性模式：退回整段解密流程
+    if (table.empty() || g_target_type != TYPE_STATIC_A || g_decrypt_mode == MODE_LAZY) {
+        return run_decrypt();
+    }
+
+    // 画像中的函数优先，其余按表顺序；每个函数单独持锁，门控线程可随时插队
+    std::vector<long> order(g_profile_order);
+    std::vector<uint8_t> queued(table.funcCount(), 0);
+    for (long k : order) queued[k] = 1;
+    for (size_t k = 0; k < table.funcCount(); k++) {
+        if (!queued[k]) order.push_back((long)k);
+    }
+
+    // 多线程可用时，画像以外的函数交给分块并行解密，不再逐个处理
+    size_t table_bytes = 0;
+    for (size_t i = 0; i < table.blockCount(); i++) {
+        table_bytes += table.block(i).sec_size;
+    }
+    if (ParallelDecryptor::threads() > 1 && table_bytes >= ParallelDecryptor::threshold()) {
+        order.resize(g_profile_order.size());
+    }
+
+    for (long k : order) {
+        if (table.funcState(k).load(std::memory_order_acquire) == FUNC_DECRYPTED) continue;
+        std::lock_guard<std::mutex> lock(g_func_mutex);
+        if (!decrypt_function_indices(&k, 1)) return false;
+    }
+
+    if (decrypt_table_remaining() != DECRYPT_OK) return false;
+    DECRYPT_LOG_INFO("[Decryptor] Background decrypt done (%zu functions, %zu from profile)\n",
+                     table.funcCount(), g_profile_order.size());
+    return true;
+}
+
+std::future<bool> Decryptor::decryptAsync() {
+    std::promise<bool> done;
+    std::future<bool> result = done.get_future();
+
+    // 与 decrypt() 共用状态机：后台线程持有解密权，期间调用 decrypt() 的线程等待它完成
+    bool decrypted = false;
+    if (!begin_decrypt(false, decrypted)) {
+        DECRYPT_LOG_ERROR("[Decryptor] decryptAsync: %s\n", decrypted ? "already decrypted" : "already running");
+        done.set_value(decrypted);
+        return result;
+    }
+    EncryptTable::self();
+
+    // 分离线程 + promise：std::async 返回的 future 析构时会等待线程，调用方丢弃返回值就会退化为同步
+    std::thread([](std::promise<bool> p) {
+        g_integrity_failed.store(false, std::memory_order_relaxed);
+        const bool ok = decrypt_async_worker();
+        record_last_error(ok);
+        end_decrypt(ok);
+        p.set_value(ok);
+    }, std::move(done)).detach();
+
+    return result;
+}
+
+bool Decryptor::waitFunction(const void* fn) {
+    if (g_recording.load(std::memory_order_relaxed)) {
+        const long k = EncryptTable::self().findFunction((uintptr_t)fn);
+        uint64_t expected = 0;
+        if (k >= 0) {
+            g_first_call_ns[k].compare_exchange_strong(expected, monotonic_ns() - g_record_start_ns + 1,
+                                                       std::memory_order_relaxed);
+        }
+    }
+    if (isDecrypted()) return true;
+
+    EncryptTable& table = EncryptTable::self();
+    const long k = table.findFunction((uintptr_t)fn);
+    if (k >= 0) {
+        if (table.funcState(k).load(std::memory_order_acquire) == FUNC_DECRYPTED) return true;
+        return decryptFunctions(&fn, 1);
+    }
+
+    // 不在加密表中（无表或目标为其他SO）：只能等待进行中的整体解密结束
+    return wait_decrypt();
+}
+
+bool Decryptor::setProfile(const char* path) {
+    FILE* f = path ? fopen(path, "r") : nullptr;
+    if (!f) {
+        DECRYPT_LOG_ERROR("[Decryptor] Failed to open profile %s: %s\n", path ? path : "(null)", strerror(errno));
+        return false;
+    }
+
+    EncryptTable& table = EncryptTable::self();
+    std::vector<std::pair<uint64_t, long>> entries;
+    std::vector<uint8_t> seen(table.funcCount(), 0);
+    char line[256];
+    while (fgets(line, sizeof(line), f)) {
+        if (line[0] == '#' || line[0] == '\n') continue;
+        unsigned long idx = 0, size = 0;
+        unsigned long long ns = 0;
+        if (sscanf(line, "%lu %lu %llu", &idx, &size, &ns) != 3) continue;
+        // 画像与当前镜像不一致（重新编译过）的条目丢弃
+        if (idx >= table.funcCount() || table.func(idx).size != size || seen[idx]) continue;
+        seen[idx] = 1;
+        entries.push_back(std::make_pair((uint64_t)ns, (long)idx));
+    }
+    fclose(f);
+
+    std::sort(entries.begin(), entries.end());
+    g_profile_order.clear();
+    for (const auto& e : entries) {
+        g_profile_order.push_back(e.second);
+    }
+    DECRYPT_LOG_DEBUG("[Decryptor] Loaded profile %s (%zu functions)\n", path, g_profile_order.size());
+    return true;
+}
+
+bool Decryptor::startProfileRecording(const char* path) {
+    EncryptTable& table = EncryptTable::self();
+    if (!path || table.empty()) {
+        DECRYPT_LOG_ERROR("[Decryptor] Profile recording needs an encrypt descriptor table and an output path\n");
+        return false;
+    }
+    strncpy(g_profile_record_path, path, sizeof(g_profile_record_path) - 1);
+    g_first_call_ns.reset(new std::atomic<uint64_t>[table.funcCount()]);
+    for (size_t i = 0; i < table.funcCount(); i++) {
+        g_first_call_ns[i].store(0, std::memory_order_relaxed);
+    }
+    g_record_start_ns = monotonic_ns();
+    g_recording.store(true, std::memory_order_release);
+    return true;
+}
+
+bool Decryptor::saveProfile() {
+    if (!g_recording.load(std::memory_order_acquire)) return false;
+
+    EncryptTable& table = EncryptTable::self();
+    std::vector<std::pair<uint64_t, size_t>> called;
+    for (size_t i = 0; i < table.funcCount(); i++) {
+        const uint64_t ns = g_first_call_ns[i].load(std::memory_order_relaxed);
+        if (ns) called.push_back(std::make_pair(ns - 1, i));
+    }
+    std::sort(called.begin(), called.end());
+
+    FILE* f = fopen(g_profile_record_path, "w");
+    if (!f) {
+        DECRYPT_LOG_ERROR("[Decryptor] Failed to write profile %s: %s\n", g_profile_record_path, strerror(errno));
+        return false;
+    }
+    fprintf(f, "# encrypt startup profile: <func_index> <size> <first_call_ns>\n");
+    for (const auto& c : called) {
+        fprintf(f, "%zu %u %llu\n", c.second, table.func(c.second).size, (unsigned long long)c.first);
+    }
+    fclose(f);
+    DECRYPT_LOG_DEBUG("[Decryptor] Saved profile %s (%zu functions)\n", g_profile_record_path, called.size());
     return true;
 }
 
@@ -127,16 +875,24 @@ bool Decryptor::find_target_so_path() {
     memset(g_target_path, 0, sizeof(g_target_path)); 
     g_base_addr = 0;
     
-    dl_iterate_phdr(dl_callback_wrapper, this);
-    
-    if (!g_target_loaded) {
+    g_target_image_valid = false;
+    ImageInfo image;
+    if (ImageLocator::findByName(TARGET_NAME, image)) {
+        strncpy(g_target_path, image.path, sizeof(g_target_path)-1);
+        g_base_addr = image.load_bias;
+        g_target_loaded = true;
+        g_target_image = image;
+        g_target_image_valid = true;
+    } else {
+        // 路径中不含目标名（如按soname加载）：由动态链接器解析，再取 link_map
         void* so_handle = dlopen(TARGET_NAME, RTLD_LAZY | RTLD_NOLOAD);
         if (so_handle) {
-            Dl_info dl_info;
-            if (dladdr(so_handle, &dl_info) && dl_info.dli_fname) {
-                strncpy(g_target_path, dl_info.dli_fname, sizeof(g_target_path)-1);
-                g_base_addr = (uintptr_t)dl_info.dli_fbase;
+            struct link_map* lm = nullptr;
+            if (dlinfo(so_handle, RTLD_DI_LINKMAP, &lm) == 0 && lm && lm->l_name) {
+                strncpy(g_target_path, lm->l_name, sizeof(g_target_path)-1);
+                g_base_addr = (uintptr_t)lm->l_addr;
                 g_target_loaded = true;
+                g_target_image_valid = ImageLocator::findByAddress((const void*)lm->l_ld, g_target_image);
             }
             dlclose(so_handle);
         }
@@ -150,106 +906,99 @@ bool Decryptor::find_executable_path() {
     memset(g_target_path, 0, sizeof(g_target_path));
     g_base_addr = 0;
 
-    const bool has_target_name = (strlen(TARGET_NAME) > 0);
-
-    FILE* f = fopen("/proc/self/maps", "r");
-    if (!f) {
-        fprintf(stderr, "[Decryptor] Failed to open /proc/self/maps: %s\n", strerror(errno));
-        return false;
-    }
-
-    char line[1024];
-    while (fgets(line, sizeof(line), f)) {
-        if (strstr(line, " r-xp ") == nullptr) continue;
-
-        char* p_path = strchr(line, '/');
-        if (!p_path) continue;
-
-        char pathbuf[PATH_MAX] = {0};
-        if (sscanf(p_path, "%s", pathbuf) != 1) continue;
-        if (pathbuf[0] == '[') continue;
-
-        if (has_target_name && strstr(pathbuf, TARGET_NAME) == nullptr) {
-            continue;
-        }
+    // 指定了名字按名字找，否则找解密器自身所在的镜像（静态库链接进的可执行文件或SO）
+    g_target_image_valid = false;
+    ImageInfo image;
+    const bool found = (strlen(TARGET_NAME) > 0)
+        ? ImageLocator::findByName(TARGET_NAME, image)
+        : ImageLocator::findByAddress((const void*)&Decryptor::decrypt, image);
 
-        uintptr_t addr = 0;
-        if (sscanf(line, "%lx-", &addr) != 1 || addr == 0) continue;
-
-        strncpy(g_target_path, pathbuf, sizeof(g_target_path) - 1);
-        g_base_addr = addr;
+    if (found && strlen(image.path)) {
+        strncpy(g_target_path, image.path, sizeof(g_target_path) - 1);
+        g_base_addr = image.load_bias;
         g_target_loaded = true;
-        break;
-    }
-
-    fclose(f);
-
-    if (g_target_loaded && g_base_addr != 0 && strlen(g_target_path)) {
-        printf("[Decryptor] Found executable: %s base=0x%lx\n", g_target_path, (unsigned long)g_base_addr);
+        g_target_image = image;
+        g_target_image_valid = true;
+        DECRYPT_LOG_DEBUG("[Decryptor] Found executable: %s load_bias=0x%lx\n", g_target_path, (unsigned long)g_base_addr);
         return true;
     }
 
-    fprintf(stderr, "[Decryptor] find_executable_path failed\n");
+    DECRYPT_LOG_ERROR("[Decryptor] find_executable_path failed\n");
     return false;
 }
 
-int Decryptor::dl_callback_wrapper(struct dl_phdr_info* info, size_t size, void* data) {
-    return data ? static_cast<Decryptor*>(data)->dl_callback(info, size) : 0;
-}
+// 从镜像 PT_NOTE 中的加密描述符取得加密区间与函数表，不读文件、不依赖段头表
+bool Decryptor::decrypt_from_descriptor(bool& found) {
+    found = false;
+    if (!g_target_image_valid) return false;
+    const uint64_t t0 = monotonic_ns();
 
-int Decryptor::dl_callback(struct dl_phdr_info* info, size_t size) const {
-    (void)size;
-    
-    if (!info || !info->dlpi_name || strlen(info->dlpi_name) == 0) {
-        return 0;
-    }
-    
-    bool is_match = false;
-    if (g_target_type == TYPE_SO) {
-        is_match = strstr(info->dlpi_name, TARGET_NAME) != nullptr;
-    } else {
-        char base_path[PATH_MAX];
-        strncpy(base_path, g_target_path, sizeof(base_path));
-        char* base = basename(base_path);
-        is_match = strstr(info->dlpi_name, base) != nullptr;
+    // 目标就是解密器所在镜像时复用 self()，按函数解密的状态与整段解密共享
+    EncryptTable* table = &EncryptTable::self();
+    ImageInfo self_image;
+    if (!ImageLocator::findByAddress((const void*)&Decryptor::decrypt, self_image) ||
+        self_image.phdr != g_target_image.phdr) {
+        g_target_table.loadImage(g_target_image);
+        table = &g_target_table;
     }
-    
-    if (is_match && info->dlpi_addr != 0) {
-        strncpy(g_target_path, info->dlpi_name, sizeof(g_target_path)-1);
-        g_target_loaded = true;
-        g_base_addr = (uintptr_t)info->dlpi_addr;
-        return 1;
+
+    // 有加密 note 但描述符不可用（新版格式/算法、损坏）：绝不退回整段异或，否则会把代码再扰乱一遍
+    if (table->rejectedCount()) {
+        phase_end(PHASE_SECTION_LOOKUP, t0);
+        found = true;
+        DECRYPT_LOG_ERROR("[Decryptor] Encrypt descriptor present but unusable, not falling back to legacy XOR\n");
+        return false;
     }
-    
-    return 0;
+
+    uintptr_t sec_real_addr = 0;
+    size_t sec_size = 0;
+    const bool has_extent = table->extent(sec_real_addr, sec_size);
+    phase_end(PHASE_SECTION_LOOKUP, t0);
+    if (!has_extent) return false;
+    found = true;
+
+    DECRYPT_LOG_INFO("[Decryptor] Found encrypt descriptor in PT_NOTE: %zu objects, %zu functions\n",
+                     table->blockCount(), table->funcCount());
+    DECRYPT_LOG_DEBUG("[Decryptor]   - Encrypted range: 0x%lx-0x%lx (%zu bytes)\n",
+                      (unsigned long)sec_real_addr, (unsigned long)(sec_real_addr + sec_size), sec_size);
+    return decrypt_section_range(sec_real_addr, sec_size, table);
 }
 
 bool Decryptor::decrypt_so_section_impl() {
-    if (!find_target_so_path() || g_base_addr == 0) return false;
-    
+    uint64_t t = monotonic_ns();
+    if (!find_target_so_path()) return false;
+    phase_end(PHASE_BASE_DISCOVERY, t);
+
+    bool found = false;
+    const bool ok = decrypt_from_descriptor(found);
+    if (found) return ok;
+
+    // 旧版 encrypt_tool 加密的镜像没有描述符：读取文件段头定位 .encrypt_text
+    t = monotonic_ns();
     int fd = open(g_target_path, O_RDONLY);
     if (fd < 0) {
-        fprintf(stderr, "[Decryptor] Open SO failed: %s\n", strerror(errno));
+        DECRYPT_LOG_ERROR("[Decryptor] Open SO failed: %s\n", strerror(errno));
         return false;
     }
     
     struct stat st; 
     if (fstat(fd, &st) < 0) { 
-        fprintf(stderr, "[Decryptor] Fstat SO failed: %s\n", strerror(errno));
+        DECRYPT_LOG_ERROR("[Decryptor] Fstat SO failed: %s\n", strerror(errno));
         close(fd); 
         return false; 
     }
     
     uint8_t* so_file = (uint8_t*)mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
     if (so_file == MAP_FAILED) { 
-        fprintf(stderr, "[Decryptor] Mmap SO failed: %s\n", strerror(errno));
+        DECRYPT_LOG_ERROR("[Decryptor] Mmap SO failed: %s\n", strerror(errno));
         close(fd); 
         return false; 
     }
+    t = phase_end(PHASE_FILE_MAP, t);
     
     Elf64_Ehdr* elf_hdr = (Elf64_Ehdr*)so_file;
     if (memcmp(elf_hdr->e_ident, ELFMAG, SELFMAG) != 0) { 
-        fprintf(stderr, "[Decryptor] Not ELF file\n");
+        DECRYPT_LOG_ERROR("[Decryptor] Not ELF file\n");
         munmap(so_file, st.st_size); 
         close(fd); 
         return false; 
@@ -261,104 +1010,78 @@ bool Decryptor::decrypt_so_section_impl() {
     Elf64_Shdr* encrypt_sec = nullptr; 
     uint64_t sec_vaddr = 0, sec_size = 0;
     
-    // 打印所有段 + 定位加密段
-    printf("[Decryptor] Start scanning ELF sections (total: %d)\n", elf_hdr->e_shnum);
+    // 定位加密段
+    DECRYPT_LOG_DEBUG("[Decryptor] Start scanning ELF sections (total: %d)\n", elf_hdr->e_shnum);
     for(int i = 0; i < elf_hdr->e_shnum; i++) { 
         const char* sec_name = sec_names + sec_hdr[i].sh_name;
         if (strcmp(sec_name, ".encrypt_text") == 0) { 
             encrypt_sec = &sec_hdr[i]; 
             sec_vaddr = sec_hdr[i].sh_addr; 
             sec_size = sec_hdr[i].sh_size; 
-            // 加密段详细信息打印
-            printf("[Decryptor] ✅ Found encrypt section: .encrypt_text\n");
-            printf("[Decryptor]   - Virtual Address (sh_addr): 0x%lx\n", (unsigned long)sec_vaddr);
-            printf("[Decryptor]   - Section Size: 0x%lx (%lu bytes)\n", (unsigned long)sec_size, sec_size);
-            printf("[Decryptor]   - File Offset (sh_offset): 0x%lx\n", (unsigned long)sec_hdr[i].sh_offset);
-            printf("[Decryptor]   - Section Index: %d\n", i);
+            DECRYPT_LOG_DEBUG("[Decryptor] Found .encrypt_text: index=%d sh_addr=0x%lx size=%lu sh_offset=0x%lx\n",
+                              i, (unsigned long)sec_vaddr, (unsigned long)sec_size,
+                              (unsigned long)sec_hdr[i].sh_offset);
             break; 
         }
     }
     
     if (!encrypt_sec || sec_size == 0) { 
-        fprintf(stderr, "[Decryptor] ❌ Cannot find .encrypt_text section!\n");
+        DECRYPT_LOG_ERROR("[Decryptor] Cannot find .encrypt_text section!\n");
         munmap(so_file, st.st_size); 
         close(fd); 
         return false; 
     }
     
+    t = phase_end(PHASE_SECTION_LOOKUP, t);
     munmap(so_file, st.st_size); 
     close(fd);
+    phase_end(PHASE_FILE_MAP, t);
 
-    const long page_size = sysconf(_SC_PAGESIZE);
     uintptr_t sec_real_addr = g_base_addr + sec_vaddr;
 
-    printf("[Decryptor] ELF type=%d sec_vaddr=0x%lx g_base=0x%lx sec_real=0x%lx size=0x%lx\n",
-           elf_hdr->e_type, (unsigned long)sec_vaddr, (unsigned long)g_base_addr,
-           (unsigned long)sec_real_addr, (unsigned long)sec_size);
-
-    // 正确计算内存页范围，避免越界
-    uintptr_t page_start = sec_real_addr & ~((uintptr_t)page_size - 1);
-    uintptr_t sec_end = sec_real_addr + sec_size;
-    uintptr_t page_end = (sec_end + page_size - 1) & ~((uintptr_t)page_size - 1);
-    size_t page_len = page_end - page_start;
-    
-    if (!is_address_accessible(sec_real_addr, sec_size)) {
-        fprintf(stderr, "[Decryptor] ❌ Encrypt section address 0x%lx is not accessible!\n", (unsigned long)sec_real_addr);
-        return false;
-    }
-
-    // 设置内存权限为RWX
-    if (mprotect((void*)page_start, page_len, PROT_READ | PROT_WRITE | PROT_EXEC) != 0) {
-        fprintf(stderr, "[Decryptor] Failed to set RWX permissions at 0x%lx: %s\n", 
-                (unsigned long)page_start, strerror(errno));
-        fprintf(stderr, "[Decryptor] Hint: Try 'sudo sysctl -w vm.mmap_min_addr=0' or disable W^X\n");
-        return false;
-    }
-
-    // 核心修改：替换为极简异或解密
-    printf("[Decryptor] Start decrypting .encrypt_text section at 0x%lx (size: %lu bytes)\n", 
-           (unsigned long)sec_real_addr, sec_size);
-    DecryptTool::simpleXorDecrypt((uint8_t*)sec_real_addr, sec_size);
-    flush_cache((uint8_t*)sec_real_addr, sec_size);
-    MEM_BAR();
+    DECRYPT_LOG_DEBUG("[Decryptor] ELF type=%d sec_vaddr=0x%lx g_base=0x%lx sec_real=0x%lx size=0x%lx\n",
+                      elf_hdr->e_type, (unsigned long)sec_vaddr, (unsigned long)g_base_addr,
+                      (unsigned long)sec_real_addr, (unsigned long)sec_size);
 
-    // 恢复为RX权限
-    if (mprotect((void*)page_start, page_len, PROT_READ | PROT_EXEC) != 0) {
-        fprintf(stderr, "[Decryptor] Failed to restore RX permissions at 0x%lx: %s\n", 
-                (unsigned long)page_start, strerror(errno));
-        return false;
-    }
-
-    printf("[Decryptor] ✅ Decrypted .encrypt_text section successfully!\n");
-    return true;
+    return decrypt_section_range(sec_real_addr, sec_size, table_for_section(sec_real_addr, sec_size));
 }
 
 bool Decryptor::decrypt_executable_section_impl() {
-    if (!find_executable_path() || g_base_addr == 0) return false;
-    
+    // ET_EXEC 的装载偏移为 0，不能再用 g_base_addr == 0 判断失败
+    uint64_t t = monotonic_ns();
+    if (!find_executable_path()) return false;
+    phase_end(PHASE_BASE_DISCOVERY, t);
+
+    bool found = false;
+    const bool ok = decrypt_from_descriptor(found);
+    if (found) return ok;
+
+    // 旧版 encrypt_tool 加密的镜像没有描述符：读取文件段头定位 .encrypt_text
+    t = monotonic_ns();
     int fd = open(g_target_path, O_RDONLY);
     if (fd < 0) {
-        fprintf(stderr, "[Decryptor] Open executable failed: %s\n", strerror(errno));
+        DECRYPT_LOG_ERROR("[Decryptor] Open executable failed: %s\n", strerror(errno));
         return false;
     }
     
     struct stat st; 
     if (fstat(fd, &st) < 0) { 
-        fprintf(stderr, "[Decryptor] Fstat executable failed: %s\n", strerror(errno));
+        DECRYPT_LOG_ERROR("[Decryptor] Fstat executable failed: %s\n", strerror(errno));
         close(fd); 
         return false; 
     }
     
     uint8_t* elf_file = (uint8_t*)mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
     if (elf_file == MAP_FAILED) { 
-        fprintf(stderr, "[Decryptor] Mmap executable failed: %s\n", strerror(errno));
+        DECRYPT_LOG_ERROR("[Decryptor] Mmap executable failed: %s\n", strerror(errno));
         close(fd); 
         return false; 
     }
+    t = phase_end(PHASE_FILE_MAP, t);
     
     Elf64_Ehdr* elf_hdr = (Elf64_Ehdr*)elf_file;
     if (memcmp(elf_hdr->e_ident, ELFMAG, SELFMAG) != 0) { 
-        fprintf(stderr, "[Decryptor] Not ELF executable\n");
+        DECRYPT_LOG_ERROR("[Decryptor] Not ELF executable\n");
         munmap(elf_file, st.st_size); 
         close(fd); 
         return false; 
@@ -371,70 +1094,226 @@ bool Decryptor::decrypt_executable_section_impl() {
     uint64_t sec_vaddr = 0;
     size_t sec_size = 0;
     
-    // 打印可执行文件加密段信息
-    printf("[Decryptor] Start scanning executable ELF sections (total: %d)\n", elf_hdr->e_shnum);
+    // 定位可执行文件加密段
+    DECRYPT_LOG_DEBUG("[Decryptor] Start scanning executable ELF sections (total: %d)\n", elf_hdr->e_shnum);
     for(int i = 0; i < elf_hdr->e_shnum; i++) { 
         const char* sec_name = sec_names + sec_hdr[i].sh_name;
         if (strcmp(sec_name, ".encrypt_text") == 0) { 
             encrypt_sec = &sec_hdr[i]; 
             sec_vaddr = sec_hdr[i].sh_addr; 
             sec_size = sec_hdr[i].sh_size; 
-            printf("[Decryptor] ✅ Found encrypt section: .encrypt_text\n");
-            printf("[Decryptor]   - Virtual Address (sh_addr): 0x%lx\n", (unsigned long)sec_vaddr);
-            printf("[Decryptor]   - Section Size: 0x%lx (%lu bytes)\n", (unsigned long)sec_size, sec_size);
-            printf("[Decryptor]   - File Offset (sh_offset): 0x%lx\n", (unsigned long)sec_hdr[i].sh_offset);
-            printf("[Decryptor]   - Section Index: %d\n", i);
+            DECRYPT_LOG_DEBUG("[Decryptor] Found .encrypt_text: index=%d sh_addr=0x%lx size=%lu sh_offset=0x%lx\n",
+                              i, (unsigned long)sec_vaddr, (unsigned long)sec_size,
+                              (unsigned long)sec_hdr[i].sh_offset);
             break; 
         }
     }
     
     if (!encrypt_sec || sec_size == 0) { 
-        fprintf(stderr, "[Decryptor] ❌ Cannot find .encrypt_text section in executable!\n");
+        DECRYPT_LOG_ERROR("[Decryptor] Cannot find .encrypt_text section in executable!\n");
         munmap(elf_file, st.st_size); 
         close(fd); 
         return false; 
     }
     
+    t = phase_end(PHASE_SECTION_LOOKUP, t);
     munmap(elf_file, st.st_size); 
     close(fd);
+    phase_end(PHASE_FILE_MAP, t);
 
-    const long page_size = sysconf(_SC_PAGESIZE);
     uintptr_t sec_real_addr = g_base_addr + sec_vaddr;
     
+    return decrypt_section_range(sec_real_addr, sec_size, table_for_section(sec_real_addr, sec_size));
+}
+
+bool Decryptor::decrypt_section_range(uintptr_t sec_real_addr, size_t sec_size, EncryptTable* table) {
+    const long page_size = sysconf(_SC_PAGESIZE);
+
     // 正确计算内存页范围，避免越界
     uintptr_t page_start = sec_real_addr & ~((uintptr_t)page_size - 1);
     uintptr_t sec_end = sec_real_addr + sec_size;
     uintptr_t page_end = (sec_end + page_size - 1) & ~((uintptr_t)page_size - 1);
     size_t page_len = page_end - page_start;
     
-    if (!is_address_accessible(sec_real_addr, sec_size)) {
-        fprintf(stderr, "[Decryptor] ❌ Executable encrypt section address 0x%lx is not accessible!\n", (unsigned long)sec_real_addr);
+    // 装载时已被 LD_AUDIT 模块自动解密（或此前已整段解密）
+    if (table && table->allDecrypted()) {
+        DECRYPT_LOG_INFO("[Decryptor] .encrypt_text already decrypted at load time, nothing to do\n");
+        return true;
+    }
+
+    // 惰性模式：整页保持不可访问，首次执行时按页解密；不预读整段，只有被执行到的页才读入
+    // （区间不可访问时 arm() 的 mprotect 会失败）
+    if (g_decrypt_mode == MODE_LAZY) {
+        DECRYPT_LOG_INFO("[Decryptor] Lazy decrypt .encrypt_text section at 0x%lx (size: %lu bytes)\n", 
+                         (unsigned long)sec_real_addr, (unsigned long)sec_size);
+        // 持锁复查：DecryptRegistry 可能已经通过 decryptSelf() 解密了同一张表
+        std::lock_guard<std::mutex> lock(g_func_mutex);
+        if (table && table->allDecrypted()) return true;
+        const size_t lazy_bytes = LazyDecryptor::bytesDecrypted();
+        bool armed = false;
+        if (table) {
+            runtime_cipher_key();
+            armed = LazyDecryptor::arm(sec_real_addr, sec_size, lazy_table_decrypt, table);
+        } else {
+            armed = LazyDecryptor::arm(sec_real_addr, sec_size, cipher_keys::XOR_KEY, sizeof(cipher_keys::XOR_KEY));
+        }
+        g_stats.bytes_decrypted += LazyDecryptor::bytesDecrypted() - lazy_bytes;
+        return armed;
+    }
+
+    uint64_t t = monotonic_ns();
+    if (!prefault_range(page_start, page_len, false)) {
+        DECRYPT_LOG_ERROR("[Decryptor] Encrypt section address 0x%lx is not accessible!\n", (unsigned long)sec_real_addr);
         return false;
     }
+    phase_end(PHASE_PROBE, t);
+
+    std::lock_guard<std::mutex> lock(g_func_mutex);
+    if (table && table->allDecrypted()) return true;
+
+    if (g_shared_cache_dir[0] && decrypt_section_shared(page_start, page_len, sec_real_addr, sec_size, table)) {
+        return true;
+    }
+
+    if (g_decrypt_engine == ENGINE_MEMFD) {
+        return decrypt_section_memfd(page_start, page_len, sec_real_addr, sec_size, table);
+    }
 
     // 设置内存权限为RWX
-    if (mprotect((void*)page_start, page_len, PROT_READ | PROT_WRITE | PROT_EXEC) != 0) {
-        fprintf(stderr, "[Decryptor] Failed to set RWX permissions at 0x%lx: %s\n", 
-                (unsigned long)page_start, strerror(errno));
-        fprintf(stderr, "[Decryptor] Hint: Try 'sudo sysctl -w vm.mmap_min_addr=0' or disable W^X\n");
+    t = monotonic_ns();
+    if (counted_mprotect(page_start, page_len, PROT_READ | PROT_WRITE | PROT_EXEC) != 0) {
+        DECRYPT_LOG_ERROR("[Decryptor] Failed to set RWX permissions at 0x%lx: %s\n", 
+                          (unsigned long)page_start, strerror(errno));
+        DECRYPT_LOG_ERROR("[Decryptor] Hint: Try 'sudo sysctl -w vm.mmap_min_addr=0' or disable W^X\n");
         return false;
     }
+    // 写时复制一次做完，解密时不再逐页写缺页
+    if (!prefault_range(page_start, page_len, true)) {
+        counted_mprotect(page_start, page_len, PROT_READ | PROT_EXEC);
+        return false;
+    }
+    phase_end(PHASE_MPROTECT_RWX, t);
+    g_stats.pages_touched = page_len / page_size;
 
     // 核心修改：替换为极简异或解密
-    printf("[Decryptor] Start decrypting executable .encrypt_text section at 0x%lx (size: %lu bytes)\n", 
-           (unsigned long)sec_real_addr, sec_size);
-    DecryptTool::simpleXorDecrypt((uint8_t*)sec_real_addr, sec_size);
+    DECRYPT_LOG_INFO("[Decryptor] Start decrypting .encrypt_text section at 0x%lx (size: %lu bytes)\n", 
+                     (unsigned long)sec_real_addr, (unsigned long)sec_size);
+    if (table) {
+        // 按表解密：跳过重定位空洞与已按函数解密的部分
+        DECRYPT_LOG_DEBUG("[Decryptor] Using encrypt descriptor table (%zu objects, %zu functions)\n",
+                          table->blockCount(), table->funcCount());
+        t = monotonic_ns();
+        if (!table_decrypt_verified(*table, sec_real_addr, sec_size)) {
+            phase_end(PHASE_DECRYPT, t);
+            flush_cache((uint8_t*)sec_real_addr, sec_size);
+            MEM_BAR();
+            counted_mprotect(page_start, page_len, PROT_READ | PROT_EXEC);
+            return false;
+        }
+    } else {
+        t = monotonic_ns();
+        DecryptTarget target = {sec_real_addr, sec_size, chunk_xor_decrypt, nullptr};
+        ParallelDecryptor::run(&target, 1);
+    }
+    phase_end(PHASE_DECRYPT, t);
+    if (ParallelDecryptor::lastThreads() > 1) {
+        DECRYPT_LOG_DEBUG("[Decryptor] Parallel decrypt: %zu threads, %zu steals\n",
+                          ParallelDecryptor::lastThreads(), ParallelDecryptor::lastSteals());
+    }
+    t = monotonic_ns();
     flush_cache((uint8_t*)sec_real_addr, sec_size);
-    __sync_synchronize();
     MEM_BAR();
+    t = phase_end(PHASE_CACHE_FLUSH, t);
 
     // 恢复为RX权限
-    if (mprotect((void*)page_start, page_len, PROT_READ | PROT_EXEC) != 0) {
-        fprintf(stderr, "[Decryptor] Failed to restore RX permissions at 0x%lx: %s\n", 
-                (unsigned long)page_start, strerror(errno));
+    if (counted_mprotect(page_start, page_len, PROT_READ | PROT_EXEC) != 0) {
+        DECRYPT_LOG_ERROR("[Decryptor] Failed to restore RX permissions at 0x%lx: %s\n", 
+                          (unsigned long)page_start, strerror(errno));
         return false;
     }
+    phase_end(PHASE_MPROTECT_RX, t);
+
+    if (g_huge_pages) {
+        g_stats.huge_page_bytes = HugeText::promote(page_start, page_len);
+    }
+
+    DECRYPT_LOG_INFO("[Decryptor] Decrypted .encrypt_text section successfully!\n");
+    return true;
+}
+
+// 共享缓存：命中时映射已有明文，未命中时解密写入条目后映射；不可用时返回 false，由调用方照常解密。
+// 调用方已持有 g_func_mutex
+bool Decryptor::decrypt_section_shared(uintptr_t page_start, size_t page_len,
+                                       uintptr_t sec_real_addr, size_t sec_size, EncryptTable* table) {
+    char image_key[129];
+    if (!g_target_image_valid || !SharedTextCache::imageKey(g_target_image, image_key, sizeof(image_key))) {
+        DECRYPT_LOG_INFO("[Decryptor] Target has no build-id or has text relocations, shared cache not used\n");
+        return false;
+    }
+
+    uint64_t t = monotonic_ns();
+    MemfdFillCtx ctx = {table, sec_real_addr, sec_size, page_start, page_len, nullptr, nullptr};
+    const SharedTextCache::Result result =
+        SharedTextCache::attach(g_shared_cache_dir, image_key, cipher_key_fingerprint(), g_target_image,
+                                page_start, page_len, shared_cache_fill, shared_cache_verify, &ctx);
+    phase_end(PHASE_DECRYPT, t);
+    g_stats.shared_cache = result;
+    if (result == SharedTextCache::CACHE_UNAVAILABLE) return false;
+    if (result == SharedTextCache::CACHE_PUBLISHED) {
+        g_stats.pages_touched = page_len / sysconf(_SC_PAGESIZE);
+    }
+    if (table) table->markAllDecrypted();
+
+    t = monotonic_ns();
+    flush_cache((uint8_t*)sec_real_addr, sec_size);
+    MEM_BAR();
+    phase_end(PHASE_CACHE_FLUSH, t);
+
+    // 换成匿名大页会变回每个进程一份私有副本
+    if (g_huge_pages) {
+        DECRYPT_LOG_DEBUG("[Decryptor] Huge pages skipped: .encrypt_text is mapped from the shared cache\n");
+    }
+    DECRYPT_LOG_INFO("[Decryptor] Mapped .encrypt_text from shared cache (%s)\n",
+                     result == SharedTextCache::CACHE_HIT ? "hit" : "published");
+    return true;
+}
+
+// memfd 引擎：原加密页始终只读，明文只写进 memfd，封印后整体换入；调用方已持有 g_func_mutex
+bool Decryptor::decrypt_section_memfd(uintptr_t page_start, size_t page_len,
+                                      uintptr_t sec_real_addr, size_t sec_size, EncryptTable* table) {
+    const long page_size = sysconf(_SC_PAGESIZE);
+
+    uint64_t t = monotonic_ns();
+    MemfdText text;
+    if (!text.create(page_len)) return false;
+    phase_end(PHASE_MPROTECT_RWX, t);
+    g_stats.pages_touched = page_len / page_size;
+
+    DECRYPT_LOG_INFO("[Decryptor] Start decrypting .encrypt_text section at 0x%lx (size: %lu bytes) into memfd\n",
+                     (unsigned long)sec_real_addr, (unsigned long)sec_size);
+    t = monotonic_ns();
+    // 整页范围都写进 memfd：边界页上段外的字节原样复制
+    // 校验不通过时不换入，原加密页从未改动，无需回滚
+    PlainChecksum sums;
+    MemfdFillCtx ctx = {table, sec_real_addr, sec_size, page_start, page_len, nullptr,
+                        table && table->hasChecksums() ? &sums : nullptr};
+    const bool filled = fill_mapped(ctx, text.fd(), 0) && (!ctx.sums || plaintext_ok(*table, sums));
+    phase_end(PHASE_DECRYPT, t);
+    if (!filled) return false;
+
+    t = monotonic_ns();
+    if (!text.commit(page_start)) return false;
+    if (table) table->markAllDecrypted();
+    t = phase_end(PHASE_MPROTECT_RX, t);
+
+    flush_cache((uint8_t*)sec_real_addr, sec_size);
+    MEM_BAR();
+    phase_end(PHASE_CACHE_FLUSH, t);
+
+    if (g_huge_pages) {
+        g_stats.huge_page_bytes = HugeText::promote(page_start, page_len);
+    }
 
-    printf("[Decryptor] ✅ Decrypted executable .encrypt_text section successfully!\n");
+    DECRYPT_LOG_INFO("[Decryptor] Decrypted .encrypt_text section successfully (memfd, sealed)!\n");
     return true;
 }
@@ -13,21 +13,6 @@
 #include <stdlib.h>
 #include <dlfcn.h>
 
-// ✅ 与加密端完全一致的固定16位密钥，一字不差
-const uint8_t DecryptTool::XOR_KEY[16] = {0x12,0x34,0x56,0x78,0x9A,0xBC,0xDE,0xF0,0xFE,0xDC,0xBA,0x98,0x76,0x54,0x32,0x10};
-const size_t  DecryptTool::XOR_KEY_LEN = sizeof(DecryptTool::XOR_KEY)/sizeof(DecryptTool::XOR_KEY[0]);
-
-// ✅ 纯净极简异或解密，加密解密通用，无任何printf日志
-void DecryptTool::simple_xor_crypt(uint8_t* data, size_t len)
-{
-    if (!data || len == 0) return;
-    for (size_t i = 0; i < len; ++i)
-    {
-        volatile uint8_t* p = &data[i];
-        *p = *p ^ XOR_KEY[i % XOR_KEY_LEN];
-    }
-}
-
 // ===================== Decryptor 静态成员初始化 =====================
 Decryptor::TargetType Decryptor::g_target_type = Decryptor::TYPE_SO;
 uintptr_t Decryptor::g_base_addr = 0;
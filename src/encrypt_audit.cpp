@@ -0,0 +1,34 @@
+#include "auto_decrypt.h"
+#include "decrypt_log.h"
+#include <cstdio>
+#include <cstdlib>
+#include <link.h>
+
+// ===================== LD_AUDIT 自动解密模块 =====================
+// 用法：LD_AUDIT=/path/to/libencrypt_audit.so ./app
+// 每个对象（主程序、依赖库、dlopen/dlmopen 的插件）映射后、构造函数执行前整段解密，
+// 应用无需调用 setTargetInfo()/decrypt()。设置 ENCRYPT_AUDIT_VERBOSE 输出每个加密对象的处理结果。
+
+extern "C" unsigned int la_version(unsigned int version)
+{
+    return version < LAV_CURRENT ? version : LAV_CURRENT;
+}
+
+extern "C" unsigned int la_objopen(struct link_map* map, Lmid_t lmid, uintptr_t* cookie)
+{
+    (void)lmid;
+    (void)cookie;
+
+    ImageInfo image;
+    if (!ImageLocator::fromLinkMap(map, image)) return 0;
+
+    const AutoDecryptResult result = AutoDecrypt::decryptImage(image);
+    static const bool verbose = getenv("ENCRYPT_AUDIT_VERBOSE") != nullptr;
+    if (result == AUTO_FAILED || result == AUTO_BAD_CHECKSUM || (verbose && result != AUTO_NOT_ENCRYPTED)) {
+        // 审计模块在独立命名空间中有自己的 stdio，stderr 无缓冲，输出不会丢失
+        DECRYPT_LOG_ERROR("[EncryptAudit] %s: %s\n", image.path[0] ? image.path : "<main>",
+                          AutoDecrypt::resultName(result));
+    }
+    // 不请求符号绑定回调（LA_FLG_BINDTO/BINDFROM），不影响符号解析性能
+    return 0;
+}
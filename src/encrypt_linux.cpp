@@ -14,14 +14,24 @@
 #include <limits.h>
 #include <cstdint>
 #include <algorithm>
+#include <cstddef>
+#include <cstdarg>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <memory>
+#include <time.h>
+#include <ar.h>
+#include "cipher.h"
+#include "encrypt_format.h"
+#include "crc32c.h"
 
 // ===================== 全局常量配置区（与解密端100%一致） =====================
 const char* const ENCRYPT_SECTION_NAME = ".encrypt_text";
-// ✅ 核心：极简异或密钥（与解密端完全一致）
-static const uint8_t XOR_KEY[] = {0x12, 0x34, 0x56, 0x78, 0x90, 0xAB, 0xCD, 0xEF};
-static const size_t XOR_KEY_LEN = sizeof(XOR_KEY) / sizeof(XOR_KEY[0]);
+// ✅ 密钥与算法实例定义在 cipher.h（与解密端共用唯一一份）
 
-// ===================== 加密工具类（极简异或版，与解密端严格对称） =====================
+// ===================== 加密工具类（异或 / AES-CTR，与解密端严格对称） =====================
 class CryptoTool {
 public:
     static CryptoTool& getInstance() {
@@ -35,27 +45,266 @@ public:
     // ✅ 核心入口：极简异或加密（与解密端完全对称）
     void simpleXorEncrypt(uint8_t* data, size_t len) {
         if (!data || len == 0) return;
-        // 循环异或密钥，100%可逆，无任何分段/位操作问题
-        for (size_t i = 0; i < len; i++) {
-            data[i] ^= XOR_KEY[i % XOR_KEY_LEN];
+        // 与解密端共用同一算法实例
+        XOR_CIPHER.apply(data, len);
+    }
+
+    // 描述符中记录的算法（ENCRYPT_CIPHER_*），须在加密任何文件之前设置
+    void setCipher(uint8_t cipher) { m_cipher = cipher; }
+    uint8_t cipher() const { return m_cipher; }
+
+    static const char* cipherName(uint8_t cipher) {
+        switch (cipher) {
+            case ENCRYPT_CIPHER_XOR:        return "xor";
+            case ENCRYPT_CIPHER_AES128_CTR: return "aes128";
+            case ENCRYPT_CIPHER_AES256_CTR: return "aes256";
+        }
+        return "unknown";
+    }
+
+    // ✅ 跳过重定位空洞加密：空洞字节由链接器改写，必须保持明文（解密端同样跳过）
+    void encryptSkippingHoles(uint8_t* data, size_t len, const std::vector<EncryptHole>& holes, uint64_t nonce) {
+        size_t cursor = 0;
+        for (const EncryptHole& h : holes) {
+            if (h.offset > cursor) {
+                applyKeystream(data + cursor, h.offset - cursor, cursor, nonce);
+            }
+            cursor = std::max(cursor, (size_t)h.offset + h.size);
+        }
+        if (cursor < len) {
+            applyKeystream(data + cursor, len - cursor, cursor, nonce);
         }
     }
 
+    // 明文 CRC32C：与加密相同的方式跳过空洞（运行时解密后按同样规则计算比较）
+    static uint32_t plainCrc(const uint8_t* data, size_t len, const std::vector<EncryptHole>& holes) {
+        uint32_t crc = 0;
+        size_t cursor = 0;
+        for (const EncryptHole& h : holes) {
+            if (h.offset > cursor) {
+                crc = Crc32c::update(crc, data + cursor, h.offset - cursor);
+            }
+            cursor = std::max(cursor, (size_t)h.offset + h.size);
+        }
+        if (cursor < len) {
+            crc = Crc32c::update(crc, data + cursor, len - cursor);
+        }
+        return crc;
+    }
+
     // ✅ 调试用 - 打印异或密钥（用于和解密端对比）
     void printXorKey() {
         printf("[CryptoTool] XOR key (for debug):\n");
-        for (int i = 0; i < XOR_KEY_LEN; i++) {
-            printf("%02X ", XOR_KEY[i]);
+        for (size_t i = 0; i < sizeof(cipher_keys::XOR_KEY); i++) {
+            printf("%02X ", cipher_keys::XOR_KEY[i]);
         }
         printf("\n");
+        printf("[CryptoTool] Cipher: %s (AES impl: %s)\n", cipherName(m_cipher),
+               AesCtrPolicy::isaName(AesCtrPolicy::activeIsa()));
     }
 
 private:
-    CryptoTool() = default;
+    CryptoTool() : m_cipher(ENCRYPT_CIPHER_XOR) {}
     ~CryptoTool() = default;
+
+    // 密钥流均按段内偏移寻址（与解密端逐函数/逐页解密一致）
+    void applyKeystream(uint8_t* data, size_t len, size_t offset, uint64_t nonce) {
+        switch (m_cipher) {
+            case ENCRYPT_CIPHER_AES128_CTR:
+                AES128_CIPHER.apply(data, len, nonce, offset);
+                break;
+            case ENCRYPT_CIPHER_AES256_CTR:
+                AES256_CIPHER.apply(data, len, nonce, offset);
+                break;
+            default:
+                XOR_CIPHER.apply(data, len, nonce, offset);
+                break;
+        }
+    }
+
+    uint8_t m_cipher;
+};
+
+// ===================== 逐文件日志 =====================
+// 并行加密时每个文件的输出先写入各自的缓冲，处理完后由主线程按文件列表顺序输出，
+// 与串行模式的输出完全一致；当前线程没有绑定日志时直接打印
+class FileLog {
+public:
+    // 在作用域内把当前线程的输出重定向到 log
+    class Scope {
+    public:
+        explicit Scope(FileLog* log) : m_prev(t_current) { t_current = log; }
+        ~Scope() { t_current = m_prev; }
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    private:
+        FileLog* m_prev;
+    };
+
+    static void out(const char* fmt, ...) __attribute__((format(printf, 1, 2))) {
+        va_list ap;
+        va_start(ap, fmt);
+        write(false, fmt, ap);
+        va_end(ap);
+    }
+
+    static void err(const char* fmt, ...) __attribute__((format(printf, 1, 2))) {
+        va_list ap;
+        va_start(ap, fmt);
+        write(true, fmt, ap);
+        va_end(ap);
+    }
+
+    // 按记录顺序输出到 stdout/stderr
+    void flush() const {
+        for (const Line& line : m_lines) {
+            if (line.is_err) {
+                fflush(stdout);
+                fputs(line.text.c_str(), stderr);
+            } else {
+                fputs(line.text.c_str(), stdout);
+            }
+        }
+    }
+
+private:
+    struct Line {
+        bool is_err;
+        std::string text;
+    };
+
+    static void write(bool is_err, const char* fmt, va_list ap) {
+        if (!t_current) {
+            vfprintf(is_err ? stderr : stdout, fmt, ap);
+            return;
+        }
+        char buf[1024];
+        va_list copy;
+        va_copy(copy, ap);
+        const int n = vsnprintf(buf, sizeof(buf), fmt, ap);
+        std::string text;
+        if (n >= (int)sizeof(buf)) {
+            text.resize(n + 1);
+            vsnprintf(&text[0], n + 1, fmt, copy);
+            text.resize(n);
+        } else if (n > 0) {
+            text.assign(buf, n);
+        }
+        va_end(copy);
+        t_current->m_lines.push_back(Line{is_err, std::move(text)});
+    }
+
+    static thread_local FileLog* t_current;
+    std::vector<Line> m_lines;
 };
 
-// ===================== 文件工具类（保留，无修改） =====================
+thread_local FileLog* FileLog::t_current = nullptr;
+
+// ===================== MD5（RFC 1321） =====================
+// 用于文件校验与加密缓存的内容键，不用于安全用途
+class Md5 {
+public:
+    Md5() { reset(); }
+
+    void reset() {
+        m_state[0] = 0x67452301;
+        m_state[1] = 0xEFCDAB89;
+        m_state[2] = 0x98BADCFE;
+        m_state[3] = 0x10325476;
+        m_length = 0;
+        m_buffered = 0;
+    }
+
+    void update(const void* data, size_t len) {
+        const uint8_t* p = (const uint8_t*)data;
+        m_length += len;
+        if (m_buffered) {
+            const size_t n = std::min(len, sizeof(m_buffer) - m_buffered);
+            memcpy(m_buffer + m_buffered, p, n);
+            m_buffered += n;
+            p += n;
+            len -= n;
+            if (m_buffered < sizeof(m_buffer)) return;
+            transform(m_buffer);
+            m_buffered = 0;
+        }
+        for (; len >= sizeof(m_buffer); p += sizeof(m_buffer), len -= sizeof(m_buffer)) {
+            transform(p);
+        }
+        memcpy(m_buffer, p, len);
+        m_buffered = len;
+    }
+
+    // 32 位小写十六进制摘要；调用后需 reset() 才能复用
+    std::string hexDigest() {
+        const uint64_t bits = m_length * 8;
+        static const uint8_t pad[64] = {0x80};
+        update(pad, 1 + (119 - m_buffered) % 64);
+        uint8_t lenBytes[8];
+        for (int i = 0; i < 8; i++) lenBytes[i] = (uint8_t)(bits >> (8 * i));
+        update(lenBytes, sizeof(lenBytes));
+
+        char hex[33];
+        for (int i = 0; i < 16; i++) {
+            snprintf(hex + 2 * i, 3, "%02x", (unsigned)((m_state[i / 4] >> (8 * (i % 4))) & 0xFF));
+        }
+        return std::string(hex, 32);
+    }
+
+    static std::string of(const void* data, size_t len) {
+        Md5 md5;
+        md5.update(data, len);
+        return md5.hexDigest();
+    }
+
+private:
+    static uint32_t rotl(uint32_t x, int c) { return (x << c) | (x >> (32 - c)); }
+
+    void transform(const uint8_t* block) {
+        static const uint32_t K[64] = {
+            0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee, 0xf57c0faf, 0x4787c62a, 0xa8304613, 0xfd469501,
+            0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be, 0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821,
+            0xf61e2562, 0xc040b340, 0x265e5a51, 0xe9b6c7aa, 0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
+            0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed, 0xa9e3e905, 0xfcefa3f8, 0x676f02d9, 0x8d2a4c8a,
+            0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c, 0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70,
+            0x289b7ec6, 0xeaa127fa, 0xd4ef3085, 0x04881d05, 0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
+            0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039, 0x655b59c3, 0x8f0ccc92, 0xffeff47d, 0x85845dd1,
+            0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1, 0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391};
+        static const int R[16] = {7, 12, 17, 22, 5, 9, 14, 20, 4, 11, 16, 23, 6, 10, 15, 21};
+
+        uint32_t M[16];
+        for (int i = 0; i < 16; i++) {
+            M[i] = block[4 * i] | (block[4 * i + 1] << 8) | (block[4 * i + 2] << 16) | ((uint32_t)block[4 * i + 3] << 24);
+        }
+        uint32_t a = m_state[0], b = m_state[1], c = m_state[2], d = m_state[3];
+        for (int i = 0; i < 64; i++) {
+            uint32_t f;
+            int g;
+            switch (i / 16) {
+                case 0: f = (b & c) | (~b & d); g = i; break;
+                case 1: f = (d & b) | (~d & c); g = (5 * i + 1) % 16; break;
+                case 2: f = b ^ c ^ d; g = (3 * i + 5) % 16; break;
+                default: f = c ^ (b | ~d); g = (7 * i) % 16; break;
+            }
+            const uint32_t tmp = d;
+            d = c;
+            c = b;
+            b = b + rotl(a + f + K[i] + M[g], R[(i / 16) * 4 + i % 4]);
+            a = tmp;
+        }
+        m_state[0] += a;
+        m_state[1] += b;
+        m_state[2] += c;
+        m_state[3] += d;
+    }
+
+    uint32_t m_state[4];
+    uint64_t m_length;
+    uint8_t m_buffer[64];
+    size_t m_buffered;
+};
+
+// ===================== 文件工具类 =====================
 class FileHelper {
 public:
     static std::string getExeDir(int argc, char** argv) {
@@ -79,35 +328,14 @@ public:
         return (pos == std::string::npos) ? "." : path.substr(0, pos);
     }
 
-    static std::vector<std::string> listFiles(const std::string& dir, const std::string& suffix) {
+    // 列出目录下指定后缀的普通文件（含指向普通文件的符号链接），结果按路径排序；
+    // recursive 时递归子目录（不跟随指向目录的符号链接）。优先用 d_type，仅在文件系统不提供时 fstatat
+    static std::vector<std::string> listFiles(const std::string& dir, const std::string& suffix, bool recursive = false) {
         std::vector<std::string> files;
-        DIR* dp = opendir(dir.c_str());
-        
-        if (!dp) {
-            fprintf(stderr, "[FileHelper] Failed to open directory: %s\n", dir.c_str());
+        if (!walkDir(dir, suffix, recursive, files, true)) {
             return files;
         }
-        
-        dirent* entry = nullptr;
-        while ((entry = readdir(dp)) != nullptr) {
-            if (strcmp(entry->d_name, ".") == 0 || strcmp(entry->d_name, "..") == 0) {
-                continue;
-            }
-            
-            std::string fullPath = dir + "/" + entry->d_name;
-            struct stat fileStat;
-            
-            if (stat(fullPath.c_str(), &fileStat) != 0 || !S_ISREG(fileStat.st_mode)) {
-                continue;
-            }
-            
-            if (fullPath.size() >= suffix.size() && 
-                fullPath.substr(fullPath.size() - suffix.size()) == suffix) {
-                files.push_back(fullPath);
-            }
-        }
-        
-        closedir(dp);
+        std::sort(files.begin(), files.end());
         return files;
     }
 
@@ -134,160 +362,1436 @@ public:
         return false;
     }
 
+private:
+    static bool walkDir(const std::string& dir, const std::string& suffix, bool recursive,
+                        std::vector<std::string>& files, bool top) {
+        DIR* dp = opendir(dir.c_str());
+        if (!dp) {
+            if (top) {
+                fprintf(stderr, "[FileHelper] Failed to open directory: %s\n", dir.c_str());
+            } else {
+                fprintf(stderr, "[FileHelper] WARN: skip unreadable directory: %s\n", dir.c_str());
+            }
+            return false;
+        }
+
+        const std::string prefix = (!dir.empty() && dir.back() == '/') ? dir : dir + "/";
+        dirent* entry = nullptr;
+        while ((entry = readdir(dp)) != nullptr) {
+            const char* name = entry->d_name;
+            if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'))) {
+                continue;
+            }
+
+            unsigned char type = entry->d_type;
+            if (type == DT_UNKNOWN || type == DT_LNK) {
+                // 符号链接按目标判断是否为普通文件，但不进入链接的目录（避免环）
+                struct stat st;
+                const int flags = (type == DT_LNK) ? 0 : AT_SYMLINK_NOFOLLOW;
+                if (fstatat(dirfd(dp), name, &st, flags) != 0) continue;
+                type = S_ISREG(st.st_mode) ? DT_REG : (S_ISDIR(st.st_mode) && entry->d_type != DT_LNK) ? DT_DIR : DT_UNKNOWN;
+            }
+
+            if (type == DT_DIR) {
+                if (recursive) {
+                    walkDir(prefix + name, suffix, recursive, files, false);
+                }
+            } else if (type == DT_REG) {
+                const size_t len = strlen(name);
+                if (len >= suffix.size() && memcmp(name + len - suffix.size(), suffix.c_str(), suffix.size()) == 0) {
+                    files.push_back(prefix + name);
+                }
+            }
+        }
+
+        closedir(dp);
+        return true;
+    }
+
+public:
     static off_t getFileSize(const std::string& filePath) {
         struct stat st;
         return stat(filePath.c_str(), &st) == 0 ? st.st_size : -1;
     }
 
-    // 验证文件完整性（加密前后MD5，可选）
+    // 验证文件完整性（加密前后MD5，可选）；读取失败返回空串
     static std::string getFileMD5(const std::string& filePath) {
-        // 可选：实现MD5计算，用于验证加密后文件未损坏
-        return "unimplemented";
+        int fd = open(filePath.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return "";
+        }
+        Md5 md5;
+        uint8_t buf[65536];
+        ssize_t n;
+        while ((n = read(fd, buf, sizeof(buf))) > 0 || (n < 0 && errno == EINTR)) {
+            if (n > 0) md5.update(buf, n);
+        }
+        close(fd);
+        return n < 0 ? "" : md5.hexDigest();
     }
 };
 
-// ===================== 核心加密函数（替换为异或加密） =====================
-static bool encryptElfObjectFile(const std::string& objFilePath, CryptoTool& crypto) {
-    off_t fileSize = FileHelper::getFileSize(objFilePath);
-    if (fileSize <= 0) {
-        fprintf(stderr, "[OBJ_ENC] ERROR: File empty or not exist! %s\n", objFilePath.c_str());
+// ===================== 重定位空洞与函数表 =====================
+// 链接器按重定位改写 .encrypt_text 中的字节（含松弛时改写的操作码），这些字节不能加密
+class RelocHoles {
+public:
+    // 重定位类型 -> 链接器可能改写的区间 [r_offset - before, r_offset + after)
+    static void patchRange(uint32_t type, uint32_t& before, uint32_t& after) {
+        before = 0;
+        switch (type) {
+            case R_X86_64_NONE:
+                after = 0; break;
+            case R_X86_64_8: case R_X86_64_PC8:
+                after = 1; break;
+            case R_X86_64_16: case R_X86_64_PC16:
+                after = 2; break;
+            case R_X86_64_PC32: case R_X86_64_GOT32: case R_X86_64_PLT32: case R_X86_64_32:
+            case R_X86_64_32S: case R_X86_64_GOTPCREL: case R_X86_64_DTPOFF32: case R_X86_64_TPOFF32:
+            case R_X86_64_GOTPC32: case R_X86_64_SIZE32:
+                after = 4; break;
+            case R_X86_64_64: case R_X86_64_PC64: case R_X86_64_GOTOFF64: case R_X86_64_GOTPC64:
+            case R_X86_64_GOT64: case R_X86_64_GOTPCREL64: case R_X86_64_GOTPLT64: case R_X86_64_PLTOFF64:
+            case R_X86_64_SIZE64: case R_X86_64_DTPMOD64: case R_X86_64_DTPOFF64: case R_X86_64_TPOFF64:
+                after = 8; break;
+            // 可松弛的GOT访问：mov->lea、call/jmp *GOT->直接调用，会改写REX/操作码/ModRM
+            case R_X86_64_GOTPCRELX: case R_X86_64_REX_GOTPCRELX:
+            case R_X86_64_GOTTPOFF: case R_X86_64_GOTPC32_TLSDESC:
+                before = 3; after = 4; break;
+            // TLS GD/LD -> IE/LE 会改写整个指令序列
+            case R_X86_64_TLSGD:
+                before = 4; after = 12; break;
+            case R_X86_64_TLSLD:
+                before = 3; after = 10; break;
+            case R_X86_64_TLSDESC_CALL:
+                after = 2; break;
+            default:
+                FileLog::err("[OBJ_ENC] WARN: unknown relocation type %u, keep 11 bytes plain\n", type);
+                before = 3; after = 8; break;
+        }
+    }
+
+    // 收集所有作用于 secIdx 的重定位，返回排序合并后的空洞
+    static std::vector<EncryptHole> collect(const uint8_t* image, const Elf64_Shdr* shdr, int shnum,
+                                            int secIdx, size_t secSize) {
+        std::vector<EncryptHole> holes;
+        for (int i = 0; i < shnum; ++i) {
+            if (shdr[i].sh_type != SHT_RELA || (int)shdr[i].sh_info != secIdx) continue;
+            const Elf64_Rela* rela = (const Elf64_Rela*)(image + shdr[i].sh_offset);
+            const size_t count = shdr[i].sh_size / sizeof(Elf64_Rela);
+            for (size_t r = 0; r < count; ++r) {
+                uint32_t before = 0, after = 0;
+                patchRange(ELF64_R_TYPE(rela[r].r_info), before, after);
+                if (after == 0 && before == 0) continue;
+                uint64_t lo = rela[r].r_offset >= before ? rela[r].r_offset - before : 0;
+                uint64_t hi = std::min<uint64_t>(rela[r].r_offset + after, secSize);
+                if (hi > lo) {
+                    holes.push_back(EncryptHole{(uint32_t)lo, (uint32_t)(hi - lo)});
+                }
+            }
+        }
+
+        std::sort(holes.begin(), holes.end(), [](const EncryptHole& a, const EncryptHole& b) {
+            return a.offset < b.offset;
+        });
+        std::vector<EncryptHole> merged;
+        for (const EncryptHole& h : holes) {
+            if (!merged.empty() && h.offset <= merged.back().offset + merged.back().size) {
+                uint32_t end = std::max(merged.back().offset + merged.back().size, h.offset + h.size);
+                merged.back().size = end - merged.back().offset;
+            } else {
+                merged.push_back(h);
+            }
+        }
+        return merged;
+    }
+};
+
+struct EncryptFuncSym {
+    uint64_t offset;
+    uint64_t size;
+    std::string name;
+};
+
+// 从符号表收集 .encrypt_text 内的 STT_FUNC 符号，并选出用于重定位的锚点符号（优先段符号）
+static bool collectEncryptFuncs(const uint8_t* image, const Elf64_Shdr* shdr, int shnum, int secIdx,
+                                std::vector<EncryptFuncSym>& funcs, uint32_t& symtabIdx,
+                                uint32_t& anchorSym, uint64_t& anchorValue) {
+    symtabIdx = 0;
+    for (int i = 0; i < shnum; ++i) {
+        if (shdr[i].sh_type == SHT_SYMTAB) {
+            symtabIdx = i;
+            break;
+        }
+    }
+    if (symtabIdx == 0) return false;
+
+    const Elf64_Sym* syms = (const Elf64_Sym*)(image + shdr[symtabIdx].sh_offset);
+    const size_t symCount = shdr[symtabIdx].sh_size / sizeof(Elf64_Sym);
+    const char* strtab = (const char*)(image + shdr[shdr[symtabIdx].sh_link].sh_offset);
+
+    bool haveAnchor = false;
+    bool anchorIsLocal = false;
+    for (size_t i = 1; i < symCount; ++i) {
+        if (syms[i].st_shndx != secIdx) continue;
+        const unsigned type = ELF64_ST_TYPE(syms[i].st_info);
+        const bool local = ELF64_ST_BIND(syms[i].st_info) == STB_LOCAL;
+
+        if (type == STT_SECTION) {
+            anchorSym = (uint32_t)i;
+            anchorValue = syms[i].st_value;
+            haveAnchor = true;
+            anchorIsLocal = true;
+        } else if (!haveAnchor || (!anchorIsLocal && local)) {
+            // 没有段符号时退而使用局部符号，最后才用全局符号（SO中全局符号可能被抢占）
+            anchorSym = (uint32_t)i;
+            anchorValue = syms[i].st_value;
+            haveAnchor = true;
+            anchorIsLocal = local;
+        }
+
+        if ((type == STT_FUNC || type == STT_GNU_IFUNC) && syms[i].st_size > 0) {
+            funcs.push_back(EncryptFuncSym{syms[i].st_value, syms[i].st_size, strtab + syms[i].st_name});
+        }
+    }
+
+    // 按偏移排序，同址别名（如C1/C2构造函数）只保留一个
+    std::sort(funcs.begin(), funcs.end(), [](const EncryptFuncSym& a, const EncryptFuncSym& b) {
+        return a.offset != b.offset ? a.offset < b.offset : a.size > b.size;
+    });
+    funcs.erase(std::unique(funcs.begin(), funcs.end(), [](const EncryptFuncSym& a, const EncryptFuncSym& b) {
+        return a.offset == b.offset;
+    }), funcs.end());
+
+    return haveAnchor;
+}
+
+// ===================== 目标文件追加段 =====================
+struct AppendSection {
+    std::string name;
+    uint32_t type;
+    uint64_t flags;
+    uint64_t align;
+    uint64_t entsize;
+    uint32_t link;
+    uint32_t info;      // 对 .rela 段：目标段为本批第几个追加段（相对下标）
+    bool infoIsAppended;
+    std::vector<uint8_t> data;
+};
+
+class ElfAppender {
+public:
+    // 构造追加到镜像尾部的数据（新段数据 + 新段名表 + 新段头表）与改写后的ELF头；原段头表/段名表成为死数据
+    static bool buildTail(const uint8_t* image, size_t fileSize, std::vector<AppendSection>& secs,
+                          std::vector<uint8_t>& tail, Elf64_Ehdr& newEhdr) {
+        const Elf64_Ehdr* ehdr = (const Elf64_Ehdr*)image;
+        const Elf64_Shdr* oldShdr = (const Elf64_Shdr*)(image + ehdr->e_shoff);
+        const int oldShnum = ehdr->e_shnum;
+        if (oldShnum == 0 || ehdr->e_shstrndx == SHN_UNDEF || ehdr->e_shstrndx >= oldShnum) {
+            FileLog::err("[OBJ_ENC] Unsupported section header layout (extended numbering)\n");
+            return false;
+        }
+
+        const Elf64_Shdr& oldStr = oldShdr[ehdr->e_shstrndx];
+        std::vector<uint8_t> shstr(image + oldStr.sh_offset, image + oldStr.sh_offset + oldStr.sh_size);
+
+        std::vector<Elf64_Shdr> shdrs(oldShdr, oldShdr + oldShnum);
+        tail.clear();
+        const size_t base = alignUp(fileSize, 8);
+        tail.resize(base - fileSize, 0);
+
+        for (size_t i = 0; i < secs.size(); ++i) {
+            AppendSection& a = secs[i];
+            padTo(tail, base, a.align);
+
+            Elf64_Shdr sh;
+            memset(&sh, 0, sizeof(sh));
+            sh.sh_name = (uint32_t)shstr.size();
+            shstr.insert(shstr.end(), a.name.begin(), a.name.end());
+            shstr.push_back(0);
+            sh.sh_type = a.type;
+            sh.sh_flags = a.flags;
+            sh.sh_offset = base + tail.size();
+            sh.sh_size = a.data.size();
+            sh.sh_link = a.link;
+            sh.sh_info = a.infoIsAppended ? (uint32_t)(oldShnum + a.info) : a.info;
+            sh.sh_addralign = a.align;
+            sh.sh_entsize = a.entsize;
+            shdrs.push_back(sh);
+            tail.insert(tail.end(), a.data.begin(), a.data.end());
+        }
+
+        // 新段名表
+        shdrs[ehdr->e_shstrndx].sh_offset = base + tail.size();
+        shdrs[ehdr->e_shstrndx].sh_size = shstr.size();
+        tail.insert(tail.end(), shstr.begin(), shstr.end());
+
+        // 新段头表
+        padTo(tail, base, 8);
+        const uint64_t newShoff = base + tail.size();
+        const uint8_t* shBytes = (const uint8_t*)shdrs.data();
+        tail.insert(tail.end(), shBytes, shBytes + shdrs.size() * sizeof(Elf64_Shdr));
+
+        newEhdr = *ehdr;
+        newEhdr.e_shoff = newShoff;
+        newEhdr.e_shnum = (Elf64_Half)shdrs.size();
+        return true;
+    }
+
+private:
+    static size_t alignUp(size_t v, size_t a) { return a > 1 ? (v + a - 1) & ~(a - 1) : v; }
+    static void padTo(std::vector<uint8_t>& tail, size_t base, size_t align) {
+        tail.resize(alignUp(base + tail.size(), align) - base, 0);
+    }
+};
+
+// 构造 .note.encrypt_text（desc 为加密表块）及其 .rela 段（格式见 encrypt_format.h）
+static void buildEncryptTable(const std::vector<EncryptFuncSym>& funcs, const std::vector<EncryptHole>& holes,
+                              size_t secSize, uint32_t symtabIdx, uint32_t anchorSym, uint64_t anchorValue,
+                              uint8_t cipher, uint64_t nonce, uint32_t plainCrc, std::vector<AppendSection>& out) {
+    const size_t blockSize = sizeof(EncryptTableHeader) + funcs.size() * sizeof(EncryptFuncEntry)
+                           + holes.size() * sizeof(EncryptHole);
+
+    // note 头 + 名字（9字节补齐到12），desc 从第24字节开始
+    static const char owner[] = ENCRYPT_NOTE_OWNER;
+    const size_t descOffset = sizeof(Elf64_Nhdr) + ((sizeof(owner) + 3) & ~(size_t)3);
+
+    AppendSection table;
+    table.name = ENCRYPT_NOTE_SECTION;
+    table.type = SHT_NOTE;
+    table.flags = SHF_ALLOC;
+    table.align = 8;
+    table.entsize = 0;
+    table.link = 0;
+    table.info = 0;
+    table.infoIsAppended = false;
+    table.data.assign(descOffset + blockSize, 0);
+
+    Elf64_Nhdr* nhdr = (Elf64_Nhdr*)table.data.data();
+    nhdr->n_namesz = sizeof(owner);
+    nhdr->n_descsz = (Elf64_Word)blockSize;
+    nhdr->n_type = ENCRYPT_NOTE_TYPE;
+    memcpy(table.data.data() + sizeof(Elf64_Nhdr), owner, sizeof(owner));
+
+    AppendSection rela;
+    rela.name = std::string(".rela") + ENCRYPT_NOTE_SECTION;
+    rela.type = SHT_RELA;
+    rela.flags = SHF_INFO_LINK;
+    rela.align = 8;
+    rela.entsize = sizeof(Elf64_Rela);
+    rela.link = symtabIdx;
+    rela.info = 0;              // 指向本批第0个追加段（.note.encrypt_text）
+    rela.infoIsAppended = true;
+
+    auto addPc64 = [&](size_t fieldOffset, uint64_t targetOffset) {
+        Elf64_Rela r;
+        r.r_offset = descOffset + fieldOffset;
+        r.r_info = ELF64_R_INFO(anchorSym, R_X86_64_PC64);
+        r.r_addend = (int64_t)(targetOffset - anchorValue);
+        const uint8_t* b = (const uint8_t*)&r;
+        rela.data.insert(rela.data.end(), b, b + sizeof(r));
+    };
+
+    EncryptTableHeader* hdr = (EncryptTableHeader*)(table.data.data() + descOffset);
+    hdr->magic = ENCRYPT_TABLE_MAGIC;
+    hdr->version = ENCRYPT_TABLE_VERSION;
+    hdr->flags = ENCRYPT_TABLE_FLAG_ENCRYPTED | ENCRYPT_TABLE_FLAG_CRC;
+    hdr->block_size = (uint32_t)blockSize;
+    hdr->func_count = (uint32_t)funcs.size();
+    hdr->section_size = (uint32_t)secSize;
+    hdr->hole_count = (uint32_t)holes.size();
+    hdr->cipher = cipher;
+    hdr->plain_crc = plainCrc;
+    hdr->nonce = nonce;
+    addPc64(offsetof(EncryptTableHeader, rel_section), 0);
+
+    EncryptFuncEntry* entries = (EncryptFuncEntry*)(hdr + 1);
+    for (size_t i = 0; i < funcs.size(); ++i) {
+        entries[i].size = (uint32_t)funcs[i].size;
+        entries[i].key_offset = (uint32_t)funcs[i].offset;
+
+        // 落在函数内的空洞区间
+        auto first = std::lower_bound(holes.begin(), holes.end(), funcs[i].offset,
+            [](const EncryptHole& h, uint64_t off) { return h.offset + h.size <= off; });
+        auto last = first;
+        while (last != holes.end() && last->offset < funcs[i].offset + funcs[i].size) ++last;
+        entries[i].hole_first = (uint32_t)(first - holes.begin());
+        entries[i].hole_count = (uint32_t)(last - first);
+
+        addPc64(sizeof(EncryptTableHeader) + i * sizeof(EncryptFuncEntry) + offsetof(EncryptFuncEntry, rel_addr),
+                funcs[i].offset);
+    }
+
+    if (!holes.empty()) {
+        memcpy(entries + funcs.size(), holes.data(), holes.size() * sizeof(EncryptHole));
+    }
+
+    out.push_back(std::move(table));
+    out.push_back(std::move(rela));
+}
+
+// ===================== 核心加密函数（异或加密 + 函数表） =====================
+enum ObjEncryptStatus {
+    OBJ_ENC_FAILED = 0,
+    OBJ_ENC_DONE,           // 已加密，需写回 newEhdr 并追加 tail
+    OBJ_ENC_SKIPPED,        // 没有（或为空的）.encrypt_text，镜像未改动
+    OBJ_ENC_ALREADY         // 已有加密描述符段（已加密过），镜像未改动
+};
+
+// 按名字查找段，名字偏移越界或未终止视为不匹配；找不到返回 -1
+static int findSection(const uint8_t* image, const Elf64_Shdr* shdr, int shnum, int shstrndx, const char* name) {
+    const Elf64_Shdr& str = shdr[shstrndx];
+    const char* shstrtab = (const char*)(image + str.sh_offset);
+    for (int i = 0; i < shnum; ++i) {
+        const size_t off = shdr[i].sh_name;
+        if (off < str.sh_size && strnlen(shstrtab + off, str.sh_size - off) < str.sh_size - off &&
+            strcmp(shstrtab + off, name) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// 在内存中的目标文件镜像上原地加密 .encrypt_text，并构造函数表等追加数据。
+// 目标文件（mmap）与静态库成员（内存副本）共用；name 只用于日志
+static ObjEncryptStatus encryptElfImage(uint8_t* image, size_t fileSize, const std::string& name, CryptoTool& crypto,
+                                        std::vector<uint8_t>& tail, Elf64_Ehdr& newEhdr) {
+    // Linux ELF解析（保留原有校验逻辑）
+    Elf64_Ehdr* elfHdr = (Elf64_Ehdr*)image;
+    if (fileSize < sizeof(Elf64_Ehdr) || memcmp(elfHdr->e_ident, ELFMAG, SELFMAG) != 0) {
+        FileLog::err("[OBJ_ENC] Not a valid ELF file: %s\n", name.c_str());
+        return OBJ_ENC_FAILED;
+    }
+
+    // 校验ELF位数（仅支持64位）
+    if (elfHdr->e_ident[EI_CLASS] != ELFCLASS64) {
+        FileLog::err("[OBJ_ENC] Only 64-bit ELF supported: %s\n", name.c_str());
+        return OBJ_ENC_FAILED;
+    }
+
+    // 函数表依赖链接期重定位，仅支持可重定位目标文件
+    if (elfHdr->e_type != ET_REL) {
+        FileLog::err("[OBJ_ENC] Only relocatable objects (ET_REL) supported: %s\n", name.c_str());
+        return OBJ_ENC_FAILED;
+    }
+
+    if (elfHdr->e_shoff == 0 || elfHdr->e_shoff + (uint64_t)elfHdr->e_shnum * sizeof(Elf64_Shdr) > fileSize ||
+        elfHdr->e_shstrndx >= elfHdr->e_shnum) {
+        FileLog::err("[OBJ_ENC] Truncated or corrupted section header table: %s\n", name.c_str());
+        return OBJ_ENC_FAILED;
+    }
+
+    Elf64_Shdr* shdr = (Elf64_Shdr*)(image + elfHdr->e_shoff);
+    if (shdr[elfHdr->e_shstrndx].sh_offset + shdr[elfHdr->e_shstrndx].sh_size > fileSize) {
+        FileLog::err("[OBJ_ENC] Section name table exceeds file size: %s\n", name.c_str());
+        return OBJ_ENC_FAILED;
+    }
+    // 加密时追加的描述符段即“已加密”标记：再处理一次会把代码异或回明文
+    if (findSection(image, shdr, elfHdr->e_shnum, elfHdr->e_shstrndx, ENCRYPT_NOTE_SECTION) >= 0) {
+        FileLog::out("[OBJ_ENC] Already encrypted (%s present), skipped: %s\n", ENCRYPT_NOTE_SECTION, name.c_str());
+        return OBJ_ENC_ALREADY;
+    }
+
+    const int secIdx = findSection(image, shdr, elfHdr->e_shnum, elfHdr->e_shstrndx, ENCRYPT_SECTION_NAME);
+    if (secIdx < 0) {
+        FileLog::err("[OBJ_ENC] WARN: %s not found in %s\n", 
+                ENCRYPT_SECTION_NAME, name.c_str());
+        return OBJ_ENC_SKIPPED;
+    }
+
+    const size_t secSize = shdr[secIdx].sh_size;
+    if (secSize == 0) {
+        FileLog::out("[OBJ_ENC] WARN: %s section is empty in %s\n", ENCRYPT_SECTION_NAME, name.c_str());
+        return OBJ_ENC_SKIPPED;
+    }
+    if (shdr[secIdx].sh_offset + secSize > fileSize) {
+        FileLog::err("[OBJ_ENC] %s exceeds file size in %s\n", ENCRYPT_SECTION_NAME, name.c_str());
+        return OBJ_ENC_FAILED;
+    }
+
+    std::vector<EncryptFuncSym> funcs;
+    uint32_t symtabIdx = 0, anchorSym = 0;
+    uint64_t anchorValue = 0;
+    if (!collectEncryptFuncs(image, shdr, elfHdr->e_shnum, secIdx, funcs, symtabIdx, anchorSym, anchorValue)) {
+        FileLog::err("[OBJ_ENC] No symbol in %s of %s, cannot emit function table\n",
+                ENCRYPT_SECTION_NAME, name.c_str());
+        return OBJ_ENC_FAILED;
+    }
+    std::vector<EncryptHole> holes = RelocHoles::collect(image, shdr, elfHdr->e_shnum, secIdx, secSize);
+
+    // AES-CTR 的 nonce 取明文段 MD5 的前8字节：同一输入总得到同一输出（加密缓存、重复构建可比对），
+    // 不同内容的段几乎不会共用计数器序列
+    const uint8_t* secData = image + shdr[secIdx].sh_offset;
+    const uint64_t nonce = crypto.cipher() == ENCRYPT_CIPHER_XOR ? 0 :
+        strtoull(Md5::of(secData, secSize).substr(0, 16).c_str(), nullptr, 16);
+
+    // 构造函数表（需在改写前从镜像中读取原始段头）
+    std::vector<AppendSection> appendSecs;
+    const uint32_t plainCrc = CryptoTool::plainCrc(secData, secSize, holes);
+    buildEncryptTable(funcs, holes, secSize, symtabIdx, anchorSym, anchorValue, crypto.cipher(), nonce, plainCrc,
+                      appendSecs);
+    if (!ElfAppender::buildTail(image, fileSize, appendSecs, tail, newEhdr)) {
+        return OBJ_ENC_FAILED;
+    }
+
+    FileLog::out("[OBJ_ENC] Encrypting %s: offset=0x%lx, size=0x%lx, funcs=%zu, reloc holes=%zu [%s]\n", 
+           ENCRYPT_SECTION_NAME, (unsigned long)shdr[secIdx].sh_offset, (unsigned long)secSize,
+           funcs.size(), holes.size(), CryptoTool::cipherName(crypto.cipher()));
+    for (const EncryptFuncSym& f : funcs) {
+        FileLog::out("[OBJ_ENC]   func offset=0x%06lx size=0x%05lx %s\n",
+               (unsigned long)f.offset, (unsigned long)f.size, f.name.c_str());
+    }
+
+    // ✅ 核心：跳过重定位空洞加密
+    crypto.encryptSkippingHoles(image + shdr[secIdx].sh_offset, secSize, holes, nonce);
+    return OBJ_ENC_DONE;
+}
+
+// ===================== 目标文件 I/O 方式 =====================
+enum ObjIoMode {
+    OBJ_IO_PREAD = 0,       // 只 pread/pwrite 加密涉及的区间（默认）
+    OBJ_IO_MMAP             // 整文件 MAP_SHARED 映射，逐文件 msync(MS_SYNC)
+};
+
+enum ObjSyncMode {
+    OBJ_SYNC_SYNCFS = 0,    // 全部文件处理完后对目标所在文件系统 syncfs 一次（默认）
+    OBJ_SYNC_FSYNC,         // 每个文件写完后 fsync
+    OBJ_SYNC_NONE           // 交给内核回写
+};
+
+struct ObjIoStats {
+    off_t inputSize = 0;        // 加密前的文件大小（用于吞吐统计）
+    uint64_t bytesRead = 0;     // pread 模式实际读取的字节数；mmap 模式按整文件计
+    uint64_t bytesWritten = 0;     // pwrite 写入的字节数（mmap 模式不含经映射写回的段数据）
+};
+
+static bool preadFull(int fd, void* buf, size_t len, off_t off) {
+    size_t done = 0;
+    while (done < len) {
+        const ssize_t n = pread(fd, (uint8_t*)buf + done, len - done, off + done);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        done += n;
+    }
+    return true;
+}
+
+static bool pwriteFull(int fd, const void* buf, size_t len, off_t off) {
+    size_t done = 0;
+    while (done < len) {
+        const ssize_t n = pwrite(fd, (const uint8_t*)buf + done, len - done, off + done);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        done += n;
+    }
+    return true;
+}
+
+// 按需读取：在与文件等大的匿名映射中，只把加密用到的区间 pread 到各自的文件偏移处
+// （ELF头、段头表、段名表、符号表及其字符串表、作用于 .encrypt_text 的 RELA、.encrypt_text 本身），
+// 其余页从不触碰也不分配，.debug_* 等大段不产生任何 I/O。encryptElfImage 因而无需区分镜像来源。
+// 非 ELF64 等无法继续解析的情况只读入ELF头，由 encryptElfImage 报错
+class SparseImage {
+public:
+    SparseImage() = delete;
+    ~SparseImage() = delete;
+
+    // 找到 .encrypt_text 时 secOffset/secSize 为其文件区间，否则 secSize 为 0；
+    // 已有加密标记时 marked 为 true，只读到段名表为止
+    static bool load(int fd, size_t fileSize, uint8_t* image, size_t& secOffset, size_t& secSize,
+                     bool& marked, uint64_t& bytesRead) {
+        secOffset = secSize = 0;
+        marked = false;
+        bytesRead = 0;
+        if (!readRange(fd, fileSize, image, 0, std::min(fileSize, sizeof(Elf64_Ehdr)), bytesRead)) return false;
+
+        const Elf64_Ehdr* ehdr = (const Elf64_Ehdr*)image;
+        if (fileSize < sizeof(Elf64_Ehdr) || memcmp(ehdr->e_ident, ELFMAG, SELFMAG) != 0 ||
+            ehdr->e_ident[EI_CLASS] != ELFCLASS64 || ehdr->e_type != ET_REL || ehdr->e_shoff == 0 ||
+            ehdr->e_shoff + (uint64_t)ehdr->e_shnum * sizeof(Elf64_Shdr) > fileSize ||
+            ehdr->e_shstrndx >= ehdr->e_shnum) {
+            return true;
+        }
+
+        const int shnum = ehdr->e_shnum;
+        if (!readRange(fd, fileSize, image, ehdr->e_shoff, shnum * sizeof(Elf64_Shdr), bytesRead)) return false;
+        const Elf64_Shdr* shdr = (const Elf64_Shdr*)(image + ehdr->e_shoff);
+        const Elf64_Shdr& str = shdr[ehdr->e_shstrndx];
+        if (!readSection(fd, fileSize, image, str, bytesRead)) return false;
+
+        marked = findSection(image, shdr, shnum, ehdr->e_shstrndx, ENCRYPT_NOTE_SECTION) >= 0;
+        const int secIdx = findSection(image, shdr, shnum, ehdr->e_shstrndx, ENCRYPT_SECTION_NAME);
+        if (marked || secIdx < 0) return true;
+
+        for (int i = 0; i < shnum; ++i) {
+            const bool need = i == secIdx ||
+                (shdr[i].sh_type == SHT_SYMTAB) ||
+                (shdr[i].sh_type == SHT_RELA && (int)shdr[i].sh_info == secIdx);
+            if (need && !readSection(fd, fileSize, image, shdr[i], bytesRead)) return false;
+            if (shdr[i].sh_type == SHT_SYMTAB &&
+                (shdr[i].sh_link >= (uint32_t)shnum || !readSection(fd, fileSize, image, shdr[shdr[i].sh_link], bytesRead))) {
+                return false;
+            }
+        }
+        secOffset = shdr[secIdx].sh_offset;
+        secSize = shdr[secIdx].sh_size;
+        return true;
+    }
+
+private:
+    static bool readSection(int fd, size_t fileSize, uint8_t* image, const Elf64_Shdr& sh, uint64_t& bytesRead) {
+        return sh.sh_type == SHT_NOBITS || readRange(fd, fileSize, image, sh.sh_offset, sh.sh_size, bytesRead);
+    }
+
+    static bool readRange(int fd, size_t fileSize, uint8_t* image, uint64_t off, uint64_t len, uint64_t& bytesRead) {
+        if (off > fileSize || len > fileSize - off) {
+            FileLog::err("[OBJ_ENC] Range 0x%lx+0x%lx exceeds file size 0x%zx\n",
+                         (unsigned long)off, (unsigned long)len, fileSize);
+            return false;
+        }
+        if (!preadFull(fd, image + off, len, off)) {
+            FileLog::err("[OBJ_ENC] Read fail at 0x%lx: %s\n", (unsigned long)off, strerror(errno));
+            return false;
+        }
+        bytesRead += len;
+        return true;
+    }
+};
+
+// ===================== 加密结果缓存 =====================
+// 键为明文目标文件内容的 MD5 加上密钥/描述符格式指纹，值为完整的加密后目标文件。
+// 增量构建中内容未变的目标文件（如 ar 重新打包出的明文成员）直接取缓存，跳过解析与加密。
+// 以整个目标文件而非 .encrypt_text 为键：追加的函数表还依赖符号表与重定位。
+// 条目先写临时文件再 rename，多线程/多进程并发写同一个键也只会看到完整文件
+class EncryptCache {
+public:
+    explicit EncryptCache(const std::string& dir) : m_dir(dir) {
+        Md5 md5;
+        // 含 FLAG_CRC：不带明文校验和的旧缓存条目不再命中
+        const uint32_t format[4] = {ENCRYPT_TABLE_VERSION, ENCRYPT_NOTE_TYPE, CryptoTool::getInstance().cipher(),
+                                    ENCRYPT_TABLE_FLAG_CRC};
+        md5.update(cipher_keys::XOR_KEY, sizeof(cipher_keys::XOR_KEY));
+        md5.update(cipher_keys::AES_KEY, sizeof(cipher_keys::AES_KEY));
+        md5.update(format, sizeof(format));
+        m_fingerprint = md5.hexDigest().substr(0, 8);
+    }
+
+    const std::string& dir() const { return m_dir; }
+    size_t hits() const { return m_hits.load(std::memory_order_relaxed); }
+    size_t misses() const { return m_misses.load(std::memory_order_relaxed); }
+
+    std::string key(const uint8_t* data, size_t size) const {
+        return Md5::of(data, size) + "-" + m_fingerprint;
+    }
+
+    // 命中且条目完整（ELF、大于明文且与旁边 .md5 记录的摘要一致）时返回 true；
+    // 摘要不符（截断、损坏）的条目删除，按未命中处理，由调用方重新加密并写回
+    bool load(const std::string& key, size_t plainSize, std::vector<uint8_t>& out) {
+        const std::string path = entryPath(key);
+        int fd = open(path.c_str(), O_RDONLY);
+        struct stat st;
+        bool ok = fd >= 0 && fstat(fd, &st) == 0 && (size_t)st.st_size > plainSize;
+        if (ok) {
+            out.resize(st.st_size);
+            ok = preadFull(fd, out.data(), out.size(), 0) && memcmp(out.data(), ELFMAG, SELFMAG) == 0;
+        }
+        if (fd >= 0) close(fd);
+        if (ok) {
+            char digest[32];
+            fd = open((path + ".md5").c_str(), O_RDONLY);
+            ok = fd >= 0 && preadFull(fd, digest, sizeof(digest), 0) &&
+                 Md5::of(out.data(), out.size()).compare(0, sizeof(digest), digest, sizeof(digest)) == 0;
+            if (fd >= 0) close(fd);
+            if (!ok) {
+                FileLog::err("[EncryptCache] WARN: %s fails its MD5 check, dropping it\n", path.c_str());
+                unlink(path.c_str());
+                unlink((path + ".md5").c_str());
+            }
+        }
+        (ok ? m_hits : m_misses).fetch_add(1, std::memory_order_relaxed);
+        return ok;
+    }
+
+    // 先写条目再写摘要：只有条目、还没有摘要时读者按未命中处理
+    void store(const std::string& key, const std::vector<uint8_t>& data) {
+        const std::string path = entryPath(key);
+        const std::string digest = Md5::of(data.data(), data.size());
+        if (writeAtomic(path, data.data(), data.size())) {
+            writeAtomic(path + ".md5", digest.data(), digest.size());
+        }
+    }
+
+private:
+    std::string entryPath(const std::string& key) const { return m_dir + "/" + key + ".o"; }
+
+    // 写临时文件后 rename，读者看不到写了一半的文件
+    static bool writeAtomic(const std::string& path, const void* data, size_t size) {
+        std::string tmp = path + ".XXXXXX";
+        int fd = mkstemp(&tmp[0]);
+        if (fd < 0) {
+            FileLog::err("[EncryptCache] WARN: cannot create %s: %s\n", tmp.c_str(), strerror(errno));
+            return false;
+        }
+        const bool ok = pwriteFull(fd, data, size, 0) && fchmod(fd, 0644) == 0;
+        close(fd);
+        if (!ok || rename(tmp.c_str(), path.c_str()) != 0) {
+            FileLog::err("[EncryptCache] WARN: cannot store %s: %s\n", path.c_str(), strerror(errno));
+            unlink(tmp.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    std::string m_dir;
+    std::string m_fingerprint;
+    std::atomic<size_t> m_hits{0};
+    std::atomic<size_t> m_misses{0};
+};
+
+// 镜像是否需要加密（合法的可重定位 ELF64、有非空 .encrypt_text 且没有加密标记）；
+// 不需要的镜像不计算哈希也不进缓存，由 encryptElfImage 给出具体的跳过/失败原因
+static bool needsEncryption(const uint8_t* image, size_t fileSize) {
+    const Elf64_Ehdr* ehdr = (const Elf64_Ehdr*)image;
+    if (fileSize < sizeof(Elf64_Ehdr) || memcmp(ehdr->e_ident, ELFMAG, SELFMAG) != 0 ||
+        ehdr->e_ident[EI_CLASS] != ELFCLASS64 || ehdr->e_type != ET_REL || ehdr->e_shoff == 0 ||
+        ehdr->e_shoff + (uint64_t)ehdr->e_shnum * sizeof(Elf64_Shdr) > fileSize || ehdr->e_shstrndx >= ehdr->e_shnum) {
         return false;
     }
+    const Elf64_Shdr* shdr = (const Elf64_Shdr*)(image + ehdr->e_shoff);
+    const Elf64_Shdr& str = shdr[ehdr->e_shstrndx];
+    if (str.sh_offset + str.sh_size > fileSize ||
+        findSection(image, shdr, ehdr->e_shnum, ehdr->e_shstrndx, ENCRYPT_NOTE_SECTION) >= 0) {
+        return false;
+    }
+    const int secIdx = findSection(image, shdr, ehdr->e_shnum, ehdr->e_shstrndx, ENCRYPT_SECTION_NAME);
+    return secIdx >= 0 && shdr[secIdx].sh_size > 0;
+}
+
+// 加密内存中的完整明文镜像：DONE 时 image 被替换为完整的加密结果（已改写ELF头并追加 tail）。
+// cache 为空时不使用缓存；命中时 fromCache 为 true
+static ObjEncryptStatus encryptImageCached(std::vector<uint8_t>& image, const std::string& name, CryptoTool& crypto,
+                                           EncryptCache* cache, bool& fromCache) {
+    fromCache = false;
+    std::string key;
+    if (cache && needsEncryption(image.data(), image.size())) {
+        key = cache->key(image.data(), image.size());
+        std::vector<uint8_t> cached;
+        if (cache->load(key, image.size(), cached)) {
+            FileLog::out("[OBJ_ENC] Cache hit: %s (%s)\n", name.c_str(), key.c_str());
+            image.swap(cached);
+            fromCache = true;
+            return OBJ_ENC_DONE;
+        }
+    }
 
+    std::vector<uint8_t> tail;
+    Elf64_Ehdr newEhdr;
+    const ObjEncryptStatus status = encryptElfImage(image.data(), image.size(), name, crypto, tail, newEhdr);
+    if (status != OBJ_ENC_DONE) {
+        return status;
+    }
+    memcpy(image.data(), &newEhdr, sizeof(newEhdr));
+    image.insert(image.end(), tail.begin(), tail.end());
+    if (!key.empty()) {
+        cache->store(key, image);
+    }
+    return OBJ_ENC_DONE;
+}
+
+// 缓存模式：整文件读入后经缓存加密，整体写回（结果不短于原文件，无需截断）
+static ObjEncryptStatus encryptObjectViaCache(int fd, off_t fileSize, const std::string& objFilePath,
+                                              CryptoTool& crypto, EncryptCache& cache, ObjSyncMode syncMode,
+                                              ObjIoStats& stats) {
+    std::vector<uint8_t> image(fileSize);
+    if (!preadFull(fd, image.data(), image.size(), 0)) {
+        FileLog::err("[OBJ_ENC] Read fail: %s %s\n", objFilePath.c_str(), strerror(errno));
+        return OBJ_ENC_FAILED;
+    }
+    stats.bytesRead = fileSize;
+
+    bool fromCache = false;
+    const ObjEncryptStatus status = encryptImageCached(image, objFilePath, crypto, &cache, fromCache);
+    if (status != OBJ_ENC_DONE) {
+        return status;
+    }
+    if (!pwriteFull(fd, image.data(), image.size(), 0)) {
+        FileLog::err("[OBJ_ENC] Write fail: %s %s\n", objFilePath.c_str(), strerror(errno));
+        return OBJ_ENC_FAILED;
+    }
+    stats.bytesWritten = image.size();
+    if (syncMode == OBJ_SYNC_FSYNC && fsync(fd) != 0) {
+        FileLog::err("[OBJ_ENC] Fsync fail: %s %s\n", objFilePath.c_str(), strerror(errno));
+        return OBJ_ENC_FAILED;
+    }
+    FileLog::out("[OBJ_ENC] Success! %s (size: %ld -> %zu bytes%s)\n",
+                 objFilePath.c_str(), fileSize, image.size(), fromCache ? ", cached" : "");
+    return OBJ_ENC_DONE;
+}
+
+// cache 为空时不使用缓存
+static ObjEncryptStatus encryptElfObjectFile(const std::string& objFilePath, CryptoTool& crypto, ObjIoMode ioMode,
+                                             ObjSyncMode syncMode, EncryptCache* cache, ObjIoStats& stats) {
+    stats = ObjIoStats();
     int fd = open(objFilePath.c_str(), O_RDWR);
     if (fd < 0) {
-        fprintf(stderr, "[OBJ_ENC] Open fail: %s %s\n", objFilePath.c_str(), strerror(errno));
-        return false;
+        FileLog::err("[OBJ_ENC] Open fail: %s %s\n", objFilePath.c_str(), strerror(errno));
+        return OBJ_ENC_FAILED;
     }
 
-    uint8_t* mapAddr = (uint8_t*)mmap(nullptr, fileSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    struct stat st;
+    const off_t fileSize = fstat(fd, &st) == 0 ? st.st_size : -1;
+    if (fileSize <= 0) {
+        FileLog::err("[OBJ_ENC] ERROR: File empty or not exist! %s\n", objFilePath.c_str());
+        close(fd);
+        return OBJ_ENC_FAILED;
+    }
+    stats.inputSize = fileSize;
+
+    // pread 模式为匿名私有映射（未读入的页不分配），mmap 模式直接映射文件
+    uint8_t* mapAddr = (uint8_t*)mmap(nullptr, fileSize, PROT_READ | PROT_WRITE,
+                                      ioMode == OBJ_IO_MMAP ? MAP_SHARED : MAP_PRIVATE | MAP_ANONYMOUS,
+                                      ioMode == OBJ_IO_MMAP ? fd : -1, 0);
     if (mapAddr == MAP_FAILED) {
-        fprintf(stderr, "[OBJ_ENC] Mmap fail: %s %s\n", objFilePath.c_str(), strerror(errno));
+        FileLog::err("[OBJ_ENC] Mmap fail: %s %s\n", objFilePath.c_str(), strerror(errno));
         close(fd);
-        return false;
+        return OBJ_ENC_FAILED;
     }
 
-    // Linux ELF解析（保留原有校验逻辑）
-    Elf64_Ehdr* elfHdr = (Elf64_Ehdr*)mapAddr;
-    if (memcmp(elfHdr->e_ident, ELFMAG, SELFMAG) != 0) {
-        fprintf(stderr, "[OBJ_ENC] Not a valid ELF file: %s\n", objFilePath.c_str());
+    size_t secOffset = 0, secSize = 0;
+    bool marked = false;
+    if (ioMode == OBJ_IO_PREAD) {
+        if (!SparseImage::load(fd, fileSize, mapAddr, secOffset, secSize, marked, stats.bytesRead)) {
+            FileLog::err("[OBJ_ENC] Failed to read %s\n", objFilePath.c_str());
+            munmap(mapAddr, fileSize);
+            close(fd);
+            return OBJ_ENC_FAILED;
+        }
+    } else {
+        stats.bytesRead = fileSize;
+    }
+
+    // 已加密或没有 .encrypt_text 的文件只读过头部，直接在下面判定跳过，不计算内容哈希
+    if (cache && !marked && (ioMode == OBJ_IO_MMAP || secSize > 0)) {
         munmap(mapAddr, fileSize);
+        const ObjEncryptStatus status = encryptObjectViaCache(fd, fileSize, objFilePath, crypto, *cache, syncMode, stats);
         close(fd);
-        return false;
+        return status;
     }
 
-    // 校验ELF位数（仅支持64位）
-    if (elfHdr->e_ident[EI_CLASS] != ELFCLASS64) {
-        fprintf(stderr, "[OBJ_ENC] Only 64-bit ELF supported: %s\n", objFilePath.c_str());
+    std::vector<uint8_t> tail;
+    Elf64_Ehdr newEhdr;
+    const ObjEncryptStatus status = encryptElfImage(mapAddr, fileSize, objFilePath, crypto, tail, newEhdr);
+    if (status != OBJ_ENC_DONE) {
         munmap(mapAddr, fileSize);
         close(fd);
-        return false;
+        return status;
     }
 
-    Elf64_Shdr* shdr = (Elf64_Shdr*)(mapAddr + elfHdr->e_shoff);
-    const char* shstrtab = (const char*)(mapAddr + shdr[elfHdr->e_shstrndx].sh_offset);
-    bool found = false;
-
-    for (int i = 0; i < elfHdr->e_shnum; ++i) {
-        if (strcmp(shstrtab + shdr[i].sh_name, ENCRYPT_SECTION_NAME) == 0) {
-            uint8_t* secData = mapAddr + shdr[i].sh_offset;
-            size_t secSize = shdr[i].sh_size;
-            
-            if (secSize > 0) {
-                printf("[OBJ_ENC] Encrypting %s: offset=0x%lx, size=0x%lx [极简异或加密]\n", 
-                       ENCRYPT_SECTION_NAME, (unsigned long)shdr[i].sh_offset, (unsigned long)secSize);
-                // ✅ 核心修改：替换为极简异或加密
-                crypto.simpleXorEncrypt(secData, secSize);
-                // 刷新缓存，确保数据写入
-                __sync_synchronize();
-            } else {
-                printf("[OBJ_ENC] WARN: %s section is empty in %s\n", ENCRYPT_SECTION_NAME, objFilePath.c_str());
-            }
-            
-            found = true;
-            break;
-        }
+    bool ok = true;
+    if (ioMode == OBJ_IO_PREAD && !pwriteFull(fd, mapAddr + secOffset, secSize, secOffset)) {
+        FileLog::err("[OBJ_ENC] Write %s failed: %s\n", ENCRYPT_SECTION_NAME, strerror(errno));
+        ok = false;
+    } else if (!pwriteFull(fd, tail.data(), tail.size(), fileSize)) {
+        FileLog::err("[OBJ_ENC] Append sections failed: %s\n", strerror(errno));
+        ok = false;
+    } else if (!pwriteFull(fd, &newEhdr, sizeof(newEhdr), 0)) {
+        FileLog::err("[OBJ_ENC] Rewrite ELF header failed: %s\n", strerror(errno));
+        ok = false;
     }
+    stats.bytesWritten = (ioMode == OBJ_IO_PREAD ? secSize : 0) + tail.size() + sizeof(newEhdr);
+    const size_t newSize = fileSize + tail.size();
 
-    if (!found) {
-        fprintf(stderr, "[OBJ_ENC] WARN: %s not found in %s\n", 
-                ENCRYPT_SECTION_NAME, objFilePath.c_str());
+    off_t afterSize = (off_t)newSize;
+    if (ioMode == OBJ_IO_MMAP) {
+        // 同步到磁盘（确保数据落盘）
+        __sync_synchronize();
+        msync(mapAddr, fileSize, MS_SYNC | MS_INVALIDATE);
+        afterSize = fstat(fd, &st) == 0 ? st.st_size : -1;
+    } else if (ok && syncMode == OBJ_SYNC_FSYNC && fsync(fd) != 0) {
+        FileLog::err("[OBJ_ENC] Fsync fail: %s %s\n", objFilePath.c_str(), strerror(errno));
+        ok = false;
     }
-
-    // 同步到磁盘（确保数据落盘）
-    msync(mapAddr, fileSize, MS_SYNC | MS_INVALIDATE);
     munmap(mapAddr, fileSize);
     close(fd);
+    if (!ok) {
+        return OBJ_ENC_FAILED;
+    }
     
-    // 验证文件大小未变
-    off_t afterSize = FileHelper::getFileSize(objFilePath);
-    if (afterSize == fileSize) {
-        printf("[OBJ_ENC] Success! File size unchanged: %s (size: %ld bytes)\n", 
-               objFilePath.c_str(), afterSize);
-        return true;
+    // 验证文件大小符合预期（原大小 + 追加的函数表）
+    if (afterSize == (off_t)newSize) {
+        FileLog::out("[OBJ_ENC] Success! %s (size: %ld -> %ld bytes)\n", 
+               objFilePath.c_str(), fileSize, afterSize);
+        return OBJ_ENC_DONE;
     } else {
-        fprintf(stderr, "[OBJ_ENC] ERROR: File size changed! before: %ld, after: %ld\n", 
-                fileSize, afterSize);
-        return false;
+        FileLog::err("[OBJ_ENC] ERROR: Unexpected file size! expected: %zu, after: %ld\n", 
+                newSize, afterSize);
+        return OBJ_ENC_FAILED;
     }
 }
 
-// ===================== 批量加密器（保留结构，替换加密调用） =====================
+// ===================== 静态库（ar）解析与重建 =====================
+// GNU ar：全局头 "!<arch>\n"，每个成员 60 字节头 + 数据（奇数长度补一个 '\n'）。
+// 特殊成员："/" 符号索引（大端 32 位计数与成员头偏移 + 符号名）、"/SYM64/"（64 位版本）、
+// "//" 长文件名表（成员名 "/N" 引用表内偏移，条目以 "/\n" 结尾）。
+// 成员加密后会变长，无法在文件内原地改写：在内存中按原顺序重建整个库，
+// 索引与长名表内容不变（大小不变、仍位于最前），只把符号索引中的成员偏移改为新位置
+struct ArMember {
+    enum Kind { SYMTAB32, SYMTAB64, LONG_NAMES, FILE };
+    Kind kind;
+    size_t hdrOffset;       // 原库中成员头偏移（符号索引引用的就是它）
+    size_t dataOffset;
+    size_t size;
+    std::string name;       // 解析长名后的文件名（允许重名）
+};
+
+class ArArchive {
+public:
+    ArArchive() = delete;
+    ~ArArchive() = delete;
+
+    static bool parse(const std::vector<uint8_t>& buf, const std::string& path, std::vector<ArMember>& members) {
+        members.clear();
+        if (buf.size() >= SARMAG && memcmp(buf.data(), "!<thin>\n", SARMAG) == 0) {
+            fprintf(stderr, "[ArEncryptor] Thin archives not supported: %s\n", path.c_str());
+            return false;
+        }
+        if (buf.size() < SARMAG || memcmp(buf.data(), ARMAG, SARMAG) != 0) {
+            fprintf(stderr, "[ArEncryptor] Not an ar archive: %s\n", path.c_str());
+            return false;
+        }
+
+        const char* longNames = nullptr;
+        size_t longNamesSize = 0;
+        size_t off = SARMAG;
+        while (off < buf.size()) {
+            const struct ar_hdr* hdr = (const struct ar_hdr*)(buf.data() + off);
+            if (off + sizeof(struct ar_hdr) > buf.size() || memcmp(hdr->ar_fmag, ARFMAG, sizeof(hdr->ar_fmag)) != 0) {
+                fprintf(stderr, "[ArEncryptor] Corrupted member header at 0x%zx: %s\n", off, path.c_str());
+                return false;
+            }
+            const std::string sizeField(hdr->ar_size, sizeof(hdr->ar_size));
+            char* endp = nullptr;
+            const unsigned long long size = strtoull(sizeField.c_str(), &endp, 10);
+            const size_t dataOffset = off + sizeof(struct ar_hdr);
+            if (endp == sizeField.c_str() || size > buf.size() - dataOffset) {
+                fprintf(stderr, "[ArEncryptor] Bad member size at 0x%zx: %s\n", off, path.c_str());
+                return false;
+            }
+
+            ArMember m;
+            m.kind = ArMember::FILE;
+            m.hdrOffset = off;
+            m.dataOffset = dataOffset;
+            m.size = size;
+            std::string raw(hdr->ar_name, sizeof(hdr->ar_name));
+            raw.erase(raw.find_last_not_of(' ') + 1);
+
+            if (raw == "/") {
+                m.kind = ArMember::SYMTAB32;
+            } else if (raw == "/SYM64/") {
+                m.kind = ArMember::SYMTAB64;
+            } else if (raw == "//") {
+                m.kind = ArMember::LONG_NAMES;
+                longNames = (const char*)buf.data() + dataOffset;
+                longNamesSize = size;
+            } else if (raw.size() > 1 && raw[0] == '/' && raw[1] >= '0' && raw[1] <= '9') {
+                const size_t idx = strtoul(raw.c_str() + 1, nullptr, 10);
+                if (!longNames || idx >= longNamesSize) {
+                    fprintf(stderr, "[ArEncryptor] Bad long name reference %s: %s\n", raw.c_str(), path.c_str());
+                    return false;
+                }
+                const char* name = longNames + idx;
+                const char* end = (const char*)memchr(name, '\n', longNamesSize - idx);
+                m.name.assign(name, end ? end - name : longNamesSize - idx);
+                if (!m.name.empty() && m.name.back() == '/') m.name.pop_back();
+            } else if (raw.compare(0, 3, "#1/") == 0) {
+                fprintf(stderr, "[ArEncryptor] BSD-style archives not supported: %s\n", path.c_str());
+                return false;
+            } else {
+                m.name = raw;
+                if (!m.name.empty() && m.name.back() == '/') m.name.pop_back();
+            }
+            members.push_back(m);
+            off = dataOffset + size + (size & 1);
+        }
+        return true;
+    }
+
+    // 按原顺序输出所有成员；newData[i] 非空时替换成员 i 的数据并改写其大小字段，最后修正符号索引
+    static bool rebuild(const std::vector<uint8_t>& buf, const std::vector<ArMember>& members,
+                        const std::vector<std::vector<uint8_t>>& newData, std::vector<uint8_t>& out,
+                        const std::string& path) {
+        out.assign(ARMAG, ARMAG + SARMAG);
+        std::vector<size_t> newHdrOffset(members.size());
+
+        for (size_t i = 0; i < members.size(); i++) {
+            const ArMember& m = members[i];
+            const bool replaced = !newData[i].empty();
+            const uint8_t* data = replaced ? newData[i].data() : buf.data() + m.dataOffset;
+            const size_t size = replaced ? newData[i].size() : m.size;
+
+            struct ar_hdr hdr;
+            memcpy(&hdr, buf.data() + m.hdrOffset, sizeof(hdr));
+            if (size != m.size) {
+                char field[sizeof(hdr.ar_size) + 1];
+                if (snprintf(field, sizeof(field), "%-10zu", size) != (int)sizeof(hdr.ar_size)) {
+                    fprintf(stderr, "[ArEncryptor] Member too large for ar header: %s(%s)\n",
+                            path.c_str(), m.name.c_str());
+                    return false;
+                }
+                memcpy(hdr.ar_size, field, sizeof(hdr.ar_size));
+            }
+
+            newHdrOffset[i] = out.size();
+            out.insert(out.end(), (const uint8_t*)&hdr, (const uint8_t*)(&hdr + 1));
+            out.insert(out.end(), data, data + size);
+            if (size & 1) out.push_back('\n');
+        }
+
+        for (size_t i = 0; i < members.size(); i++) {
+            if (members[i].kind != ArMember::SYMTAB32 && members[i].kind != ArMember::SYMTAB64) continue;
+            const size_t width = members[i].kind == ArMember::SYMTAB64 ? 8 : 4;
+            uint8_t* p = out.data() + newHdrOffset[i] + sizeof(struct ar_hdr);
+            const size_t size = members[i].size;
+            const uint64_t count = size >= width ? readBE(p, width) : 0;
+            if (size < width || count > (size - width) / width) {
+                fprintf(stderr, "[ArEncryptor] Corrupted symbol index: %s\n", path.c_str());
+                return false;
+            }
+            for (uint64_t k = 0; k < count; k++) {
+                uint8_t* slot = p + width * (k + 1);
+                const uint64_t oldOff = readBE(slot, width);
+                auto it = std::lower_bound(members.begin(), members.end(), oldOff,
+                    [](const ArMember& m, uint64_t off) { return m.hdrOffset < off; });
+                if (it == members.end() || it->hdrOffset != oldOff) {
+                    fprintf(stderr, "[ArEncryptor] Symbol index points to no member (0x%lx): %s\n",
+                            (unsigned long)oldOff, path.c_str());
+                    return false;
+                }
+                const uint64_t newOff = newHdrOffset[it - members.begin()];
+                if (width == 4 && newOff > UINT32_MAX) {
+                    fprintf(stderr, "[ArEncryptor] Archive exceeds 4 GB, 32-bit symbol index overflow: %s\n",
+                            path.c_str());
+                    return false;
+                }
+                writeBE(slot, width, newOff);
+            }
+        }
+        return true;
+    }
+
+private:
+    static uint64_t readBE(const uint8_t* p, size_t width) {
+        uint64_t v = 0;
+        for (size_t i = 0; i < width; i++) v = (v << 8) | p[i];
+        return v;
+    }
+
+    static void writeBE(uint8_t* p, size_t width, uint64_t v) {
+        for (size_t i = width; i-- > 0; v >>= 8) p[i] = (uint8_t)v;
+    }
+};
+
+// ===================== 批量加密器 =====================
 class ObjEncryptor {
 public:
-    ObjEncryptor() : crypto(CryptoTool::getInstance()) {
+    // cacheDir 为空时不使用加密缓存
+    ObjEncryptor(size_t jobs, bool recursive, ObjIoMode ioMode, ObjSyncMode syncMode, const std::string& cacheDir)
+        : crypto(CryptoTool::getInstance()), m_jobs(jobs ? jobs : 1), m_recursive(recursive),
+          m_ioMode(ioMode), m_syncMode(syncMode), m_cache(cacheDir.empty() ? nullptr : new EncryptCache(cacheDir)) {
         // 打印密钥，方便和解密端对比
         crypto.printXorKey();
     }
     
-    int batchEncrypt(const std::string& objDir) {
-        auto objFiles = FileHelper::listFiles(objDir, ".o");
+    // target 为目录时处理其中的 .o 与 .a；也可直接指定单个 .o/.a 文件
+    int batchEncrypt(const std::string& target) {
+        std::vector<std::string> objFiles, archives;
+        struct stat st;
+        if (stat(target.c_str(), &st) == 0 && S_ISREG(st.st_mode)) {
+            (isArchivePath(target) ? archives : objFiles).push_back(target);
+        } else {
+            objFiles = FileHelper::listFiles(target, ".o", m_recursive);
+            archives = FileHelper::listFiles(target, ".a", m_recursive);
+        }
         
-        if (objFiles.empty()) {
-            printf("[ObjEncryptor] No .o files found in %s\n", objDir.c_str());
+        if (objFiles.empty() && archives.empty()) {
+            printf("[ObjEncryptor] No .o/.a files found in %s\n", target.c_str());
             return 0;
         }
 
-        int success = 0;
-        for (const auto& file : objFiles) {
-            printf("\n[ObjEncryptor] Processing: %s\n", file.c_str());
-            if (encryptElfObjectFile(file, crypto)) {
-                success++;
+        std::vector<FileResult> objResults(objFiles.size());
+        std::vector<FileResult> arResults(archives.size());
+        const uint64_t startNs = nowNs();
+
+        runTasks(objFiles.size(), [&](size_t i) {
+            FileLog::out("\n[ObjEncryptor] Processing: %s\n", objFiles[i].c_str());
+            const ObjEncryptStatus status = encryptElfObjectFile(objFiles[i], crypto, m_ioMode, m_syncMode,
+                                                                 m_cache.get(), objResults[i].io);
+            objResults[i].ok = status != OBJ_ENC_FAILED;
+            objResults[i].alreadyEncrypted = status == OBJ_ENC_ALREADY ? 1 : 0;
+        });
+        // 静态库逐个处理，库内成员并行
+        for (size_t i = 0; i < archives.size(); i++) {
+            arResults[i].ok = encryptArchive(archives[i], arResults[i].io, arResults[i].alreadyEncrypted);
+        }
+        // 批量落盘：一次 syncfs 代替逐文件 MS_SYNC/fsync
+        const uint64_t syncStartNs = nowNs();
+        // 落盘失败也先打印汇总，再列出可能未持久化的文件
+        const bool synced = m_syncMode != OBJ_SYNC_SYNCFS || m_ioMode != OBJ_IO_PREAD || syncFileSystem(target);
+        const uint64_t endNs = nowNs();
+        const double seconds = (endNs - startNs) / 1e9;
+
+        const size_t count = objFiles.size() + archives.size();
+        size_t success = 0, alreadyEncrypted = 0;
+        uint64_t totalBytes = 0, bytesRead = 0, bytesWritten = 0;
+        for (const std::vector<FileResult>* results : {&objResults, &arResults}) {
+            for (const FileResult& r : *results) {
+                success += r.ok ? 1 : 0;
+                alreadyEncrypted += r.alreadyEncrypted;
+                totalBytes += r.io.inputSize;
+                bytesRead += r.io.bytesRead;
+                bytesWritten += r.io.bytesWritten;
             }
         }
         
-        printf("\n[ObjEncryptor] Summary: Processed %zu files, %d successful, %zu failed\n",
-               objFiles.size(), success, objFiles.size() - success);
-        
-        return objFiles.size() - success;
+        printf("\n[ObjEncryptor] Summary: Processed %zu files (%zu objects, %zu archives), %zu successful, %zu failed\n",
+               count, objFiles.size(), archives.size(), success, count - success);
+        for (size_t i = 0; i < objFiles.size(); i++) {
+            if (!objResults[i].ok) {
+                printf("[ObjEncryptor]   failed: %s\n", objFiles[i].c_str());
+            }
+        }
+        for (size_t i = 0; i < archives.size(); i++) {
+            if (!arResults[i].ok) {
+                printf("[ObjEncryptor]   failed: %s\n", archives[i].c_str());
+            }
+        }
+        printf("[ObjEncryptor] Already encrypted (skipped): %zu objects/members\n", alreadyEncrypted);
+        if (m_cache) {
+            printf("[ObjEncryptor] Cache: %zu hits, %zu misses (%s)\n",
+                   m_cache->hits(), m_cache->misses(), m_cache->dir().c_str());
+        }
+        printf("[ObjEncryptor] I/O: %s, sync: %s, read %.2f MB, written %.2f MB\n",
+               m_ioMode == OBJ_IO_MMAP ? "mmap" : "pread", syncModeName(),
+               bytesRead / (1024.0 * 1024.0), bytesWritten / (1024.0 * 1024.0));
+        printf("[ObjEncryptor] Throughput: %.1f files/s, %.1f MB/s (%zu jobs, %.1f ms, sync %.1f ms)\n",
+               count / seconds, totalBytes / seconds / (1024.0 * 1024.0), m_jobs, seconds * 1e3,
+               (endNs - syncStartNs) / 1e6);
+
+        if (!synced) {
+            fflush(stdout);
+            fprintf(stderr, "[ObjEncryptor] ERROR: syncfs failed, written files may not be durable:\n");
+            for (size_t i = 0; i < objFiles.size(); i++) {
+                if (objResults[i].io.bytesWritten) fprintf(stderr, "[ObjEncryptor]   %s\n", objFiles[i].c_str());
+            }
+            for (size_t i = 0; i < archives.size(); i++) {
+                if (arResults[i].io.bytesWritten) fprintf(stderr, "[ObjEncryptor]   %s\n", archives[i].c_str());
+            }
+            return (int)count;
+        }
+        return (int)(count - success);
     }
 
 private:
+    struct FileResult {
+        bool ok = false;
+        size_t alreadyEncrypted = 0;    // 目标文件为 0/1，静态库为其中已加密的成员数
+        ObjIoStats io;
+    };
+
+    const char* syncModeName() const {
+        if (m_ioMode == OBJ_IO_MMAP) return "msync";
+        return m_syncMode == OBJ_SYNC_SYNCFS ? "syncfs" : m_syncMode == OBJ_SYNC_FSYNC ? "fsync" : "none";
+    }
+
+    static bool syncFileSystem(const std::string& target) {
+        int fd = open(target.c_str(), O_RDONLY);
+        if (fd < 0 || syncfs(fd) != 0) {
+            fprintf(stderr, "[ObjEncryptor] syncfs fail: %s %s\n", target.c_str(), strerror(errno));
+            if (fd >= 0) close(fd);
+            return false;
+        }
+        close(fd);
+        return true;
+    }
+
+    static bool isArchivePath(const std::string& path) {
+        return path.size() >= 2 && path.compare(path.size() - 2, 2, ".a") == 0;
+    }
+
+    // 用 m_jobs 个线程执行 task(0..count-1)，每个任务的输出先记入各自的 FileLog，
+    // 再由调用线程按下标顺序输出，保证日志与串行执行一致
+    template <typename Task>
+    void runTasks(size_t count, Task task) {
+        std::vector<FileLog> logs(count);
+        const size_t jobs = std::min(m_jobs, count);
+
+        if (jobs <= 1) {
+            for (size_t i = 0; i < count; i++) {
+                {
+                    FileLog::Scope scope(&logs[i]);
+                    task(i);
+                }
+                logs[i].flush();
+            }
+            return;
+        }
+
+        std::unique_ptr<bool[]> done(new bool[count]());
+        std::atomic<size_t> next(0);
+        std::mutex doneMutex;
+        std::condition_variable doneCv;
+        std::vector<std::thread> workers;
+        for (size_t t = 0; t < jobs; t++) {
+            workers.emplace_back([&] {
+                for (size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < count; ) {
+                    {
+                        FileLog::Scope scope(&logs[i]);
+                        task(i);
+                    }
+                    std::lock_guard<std::mutex> lock(doneMutex);
+                    done[i] = true;
+                    doneCv.notify_all();
+                }
+            });
+        }
+        for (size_t i = 0; i < count; i++) {
+            std::unique_lock<std::mutex> lock(doneMutex);
+            doneCv.wait(lock, [&] { return done[i]; });
+            lock.unlock();
+            logs[i].flush();
+        }
+        for (std::thread& w : workers) w.join();
+    }
+
+    // 一次读入整个库，并行加密其中的 ELF 成员，重建后写入同目录临时文件再 rename 替换；
+    // 任一成员失败则保持原库不变
+    bool encryptArchive(const std::string& path, ObjIoStats& io, size_t& alreadyEncrypted) {
+        printf("\n[ArEncryptor] Processing: %s\n", path.c_str());
+        struct stat st;
+        std::vector<uint8_t> buf;
+        if (!readWholeFile(path, buf, st)) {
+            return false;
+        }
+        io.inputSize = st.st_size;
+        io.bytesRead = st.st_size;
+
+        std::vector<ArMember> members;
+        if (!ArArchive::parse(buf, path, members)) {
+            return false;
+        }
+
+        std::vector<size_t> elfMembers;
+        size_t fileMembers = 0;
+        for (size_t i = 0; i < members.size(); i++) {
+            if (members[i].kind != ArMember::FILE) continue;
+            fileMembers++;
+            if (members[i].size >= SELFMAG && memcmp(buf.data() + members[i].dataOffset, ELFMAG, SELFMAG) == 0) {
+                elfMembers.push_back(i);
+            }
+        }
+
+        std::vector<std::vector<uint8_t>> newData(members.size());
+        std::vector<uint8_t> status(members.size(), OBJ_ENC_SKIPPED);
+        runTasks(elfMembers.size(), [&](size_t t) {
+            const ArMember& m = members[elfMembers[t]];
+            const std::string name = path + "(" + m.name + ")";
+            FileLog::out("\n[ArEncryptor] Member: %s\n", name.c_str());
+
+            std::vector<uint8_t> image(buf.begin() + m.dataOffset, buf.begin() + m.dataOffset + m.size);
+            bool fromCache = false;
+            const ObjEncryptStatus result = encryptImageCached(image, name, crypto, m_cache.get(), fromCache);
+            status[elfMembers[t]] = result;
+            if (result != OBJ_ENC_DONE) return;
+
+            FileLog::out("[OBJ_ENC] Success! %s (size: %zu -> %zu bytes%s)\n",
+                         name.c_str(), m.size, image.size(), fromCache ? ", cached" : "");
+            newData[elfMembers[t]].swap(image);
+        });
+
+        size_t encrypted = 0, failed = 0;
+        alreadyEncrypted = 0;
+        for (size_t i : elfMembers) {
+            encrypted += status[i] == OBJ_ENC_DONE ? 1 : 0;
+            failed += status[i] == OBJ_ENC_FAILED ? 1 : 0;
+            alreadyEncrypted += status[i] == OBJ_ENC_ALREADY ? 1 : 0;
+        }
+        printf("[ArEncryptor] %s: %zu members, %zu encrypted, %zu already encrypted, %zu skipped, %zu failed\n",
+               path.c_str(), fileMembers, encrypted, alreadyEncrypted,
+               fileMembers - encrypted - alreadyEncrypted - failed, failed);
+        if (failed) {
+            fprintf(stderr, "[ArEncryptor] Archive left unchanged: %s\n", path.c_str());
+            return false;
+        }
+        if (!encrypted) {
+            return true;
+        }
+
+        std::vector<uint8_t> out;
+        if (!ArArchive::rebuild(buf, members, newData, out, path) ||
+            !replaceFile(path, out, st.st_mode, m_syncMode != OBJ_SYNC_NONE)) {
+            return false;
+        }
+        io.bytesWritten = out.size();
+        printf("[ArEncryptor] Success! %s (size: %ld -> %zu bytes)\n", path.c_str(), (long)st.st_size, out.size());
+        return true;
+    }
+
+    static bool readWholeFile(const std::string& path, std::vector<uint8_t>& buf, struct stat& st) {
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0 || fstat(fd, &st) != 0) {
+            fprintf(stderr, "[ArEncryptor] Open fail: %s %s\n", path.c_str(), strerror(errno));
+            if (fd >= 0) close(fd);
+            return false;
+        }
+        buf.resize(st.st_size);
+        const bool ok = preadFull(fd, buf.data(), buf.size(), 0);
+        if (!ok) {
+            fprintf(stderr, "[ArEncryptor] Read fail: %s %s\n", path.c_str(), strerror(errno));
+        }
+        close(fd);
+        return ok;
+    }
+
+    // 写入同目录临时文件、落盘后 rename 覆盖原文件，中途失败不影响原库（durable 为 false 时不 fsync）
+    static bool replaceFile(const std::string& path, const std::vector<uint8_t>& data, mode_t mode, bool durable) {
+        std::string tmp = path + ".XXXXXX";
+        int fd = mkstemp(&tmp[0]);
+        if (fd < 0) {
+            fprintf(stderr, "[ArEncryptor] Create temp file fail: %s %s\n", tmp.c_str(), strerror(errno));
+            return false;
+        }
+        size_t done = 0;
+        while (done < data.size()) {
+            const ssize_t n = write(fd, data.data() + done, data.size() - done);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                break;
+            }
+            done += n;
+        }
+        const bool ok = done == data.size() && fchmod(fd, mode & 07777) == 0 && (!durable || fsync(fd) == 0);
+        const int savedErrno = errno;
+        close(fd);
+        if (!ok || rename(tmp.c_str(), path.c_str()) != 0) {
+            fprintf(stderr, "[ArEncryptor] Replace fail: %s %s\n", path.c_str(), strerror(ok ? errno : savedErrno));
+            unlink(tmp.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    static uint64_t nowNs() {
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+    }
+
     CryptoTool& crypto;
+    size_t m_jobs;
+    bool m_recursive;
+    ObjIoMode m_ioMode;
+    ObjSyncMode m_syncMode;
+    std::unique_ptr<EncryptCache> m_cache;
 };
 
-// ===================== 主函数（无修改） =====================
+// ===================== 主函数：解析参数并驱动 ObjEncryptor =====================
 int main(int argc, char** argv) {
     printf("========================================\n");
-    printf("Linux ELF Object File Encryptor (极简异或版)\n");
+    printf("Linux ELF Object File Encryptor (XOR / AES-CTR)\n");
     printf("========================================\n");
 
+    // 用法：encrypt_tool [-r] [-j N] [目标目录 | .o/.a 文件]
+    //   -r   递归处理子目录中的 .o/.a（.a 直接在库内加密 ELF 成员，无需 ar x / ar rcs）
+    //   -j N 并行加密的线程数（0 = 在线CPU数，默认 1）
+    //   -m pread|mmap         pread：只读写加密涉及的区间（默认）；mmap：整文件映射
+    //   -s syncfs|fsync|none  落盘方式（pread 模式）：结束时 syncfs 一次（默认）/逐文件 fsync/不主动落盘
+    //   -c DIR                加密缓存目录：内容未变的明文目标文件直接取上次的加密结果
+    //   -a xor|aes128|aes256  加密算法（默认 xor：已部署的解密端与 QNX 端只认异或；AES-CTR 需显式指定）
+    // 已加密（带 .note.encrypt_text）的目标文件/成员总是跳过，重复运行不会把代码异或回明文
+    bool recursive = false;
+    size_t jobs = 1;
+    ObjIoMode ioMode = OBJ_IO_PREAD;
+    ObjSyncMode syncMode = OBJ_SYNC_SYNCFS;
+    std::string cacheDir;
+    uint8_t cipher = ENCRYPT_CIPHER_XOR;
+    int opt;
+    while ((opt = getopt(argc, argv, "rj:m:s:c:a:")) != -1) {
+        switch (opt) {
+            case 'r':
+                recursive = true;
+                break;
+            case 'j':
+                jobs = strtoul(optarg, nullptr, 10);
+                if (jobs == 0) {
+                    jobs = std::max(1L, sysconf(_SC_NPROCESSORS_ONLN));
+                }
+                break;
+            case 'm':
+                if (strcmp(optarg, "pread") == 0) {
+                    ioMode = OBJ_IO_PREAD;
+                } else if (strcmp(optarg, "mmap") == 0) {
+                    ioMode = OBJ_IO_MMAP;
+                } else {
+                    fprintf(stderr, "Unknown I/O mode: %s\n", optarg);
+                    return -1;
+                }
+                break;
+            case 's':
+                if (strcmp(optarg, "syncfs") == 0) {
+                    syncMode = OBJ_SYNC_SYNCFS;
+                } else if (strcmp(optarg, "fsync") == 0) {
+                    syncMode = OBJ_SYNC_FSYNC;
+                } else if (strcmp(optarg, "none") == 0) {
+                    syncMode = OBJ_SYNC_NONE;
+                } else {
+                    fprintf(stderr, "Unknown sync mode: %s\n", optarg);
+                    return -1;
+                }
+                break;
+            case 'c':
+                cacheDir = optarg;
+                break;
+            case 'a':
+                if (strcmp(optarg, "xor") == 0) {
+                    cipher = ENCRYPT_CIPHER_XOR;
+                } else if (strcmp(optarg, "aes128") == 0) {
+                    cipher = ENCRYPT_CIPHER_AES128_CTR;
+                } else if (strcmp(optarg, "aes256") == 0) {
+                    cipher = ENCRYPT_CIPHER_AES256_CTR;
+                } else {
+                    fprintf(stderr, "Unknown cipher: %s\n", optarg);
+                    return -1;
+                }
+                break;
+            default:
+                fprintf(stderr, "Usage: %s [-r] [-j N] [-m pread|mmap] [-s syncfs|fsync|none] [-c cache_dir] "
+                        "[-a xor|aes128|aes256] [dir|file.o|file.a]\n", argv[0]);
+                return -1;
+        }
+    }
+
     // 支持自定义目标目录（参数传入）
     std::string objDir;
-    if (argc >= 2) {
-        objDir = argv[1];
+    if (optind < argc) {
+        objDir = argv[optind];
     } else {
         std::string exeDir = FileHelper::getExeDir(argc, argv);
         objDir = exeDir + "/../lib/";
     }
     
-    printf("[Main] Target directory: %s\n", objDir.c_str());
+    printf("[Main] Target directory: %s%s, jobs: %zu\n", objDir.c_str(), recursive ? " (recursive)" : "", jobs);
     if (!FileHelper::mkdirIfNotExist(objDir)) {
         fprintf(stderr, "Failed to create directory: %s\n", objDir.c_str());
         return -1;
     }
 
-    ObjEncryptor encryptor;
+    if (!cacheDir.empty() && !FileHelper::mkdirIfNotExist(cacheDir)) {
+        fprintf(stderr, "Failed to create cache directory: %s\n", cacheDir.c_str());
+        return -1;
+    }
+
+    CryptoTool::getInstance().setCipher(cipher);
+    ObjEncryptor encryptor(jobs, recursive, ioMode, syncMode, cacheDir);
     int failed = encryptor.batchEncrypt(objDir);
 
     printf("\nEncryption complete. Failed: %d\n", failed);
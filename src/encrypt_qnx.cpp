@@ -13,12 +13,11 @@
 #include <vector>
 #include <dirent.h>
 #include <limits.h>
+#include "cipher.h"
 
 // ===================== 唯一全局常量：加密段名称 + 异或密钥（你可以随便改） =====================
 const char* const ENCRYPT_SECTION_NAME = ".encrypt_text";
-// ✅ 核心：自定义固定异或密钥，16字节（可改成任意长度、任意值）
-const uint8_t XOR_KEY[16] = {0x12,0x34,0x56,0x78,0x9A,0xBC,0xDE,0xF0,0xFE,0xDC,0xBA,0x98,0x76,0x54,0x32,0x10};
-const size_t XOR_KEY_LEN = sizeof(XOR_KEY);
+// ✅ 核心：异或密钥与解密端共用 cipher.h 中的 QNX_XOR_CIPHER（cipher_keys::QNX_XOR_KEY）
 
 // ===================== 极简加密工具类（只有简单异或，无任何多余逻辑） =====================
 class CryptoTool {
@@ -33,10 +32,7 @@ public:
 
     // ✅ 核心功能：简单异或加密（解密时调用同一个函数即可，异或可逆）
     void simpleXorCrypt(uint8_t* data, size_t len) {
-        if (!data || len == 0) return;
-        for (size_t i = 0; i < len; ++i) {
-            data[i] ^= XOR_KEY[i % XOR_KEY_LEN]; // 密钥循环使用
-        }
+        QNX_XOR_CIPHER.apply(data, len); // 密钥循环使用
     }
 
 private:
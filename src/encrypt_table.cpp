@@ -0,0 +1,400 @@
+#include "encrypt_table.h"
+#include "image_locator.h"
+#include "crc32c.h"
+#include "decrypt_log.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+// ===================== EncryptTable 实现 =====================
+EncryptTable& EncryptTable::self()
+{
+    static EncryptTable table;
+    static bool loaded = [] {
+        ImageInfo image;
+        return ImageLocator::findByAddress((const void*)&EncryptTable::self, image) && table.loadImage(image);
+    }();
+    (void)loaded;
+    return table;
+}
+
+bool EncryptTable::loadImage(const ImageInfo& image)
+{
+    return loadNotes(image.phdr, image.phnum, image.load_bias);
+}
+
+bool EncryptTable::loadNotes(const ElfW(Phdr)* phdr, uint16_t phnum, uintptr_t load_bias)
+{
+    static const char owner[] = ENCRYPT_NOTE_OWNER;
+
+    m_blocks.clear();
+    m_funcs.clear();
+    m_by_addr.clear();
+    m_state.reset();
+    m_rejected = 0;
+    m_all_decrypted.store(false, std::memory_order_relaxed);
+
+    for (uint16_t i = 0; phdr && i < phnum; i++) {
+        if (phdr[i].p_type != PT_NOTE) continue;
+        const size_t align = phdr[i].p_align >= 8 ? 8 : 4;
+        const uint8_t* p = (const uint8_t*)(load_bias + phdr[i].p_vaddr);
+        const uint8_t* end = p + phdr[i].p_memsz;
+
+        while (p + sizeof(ElfW(Nhdr)) <= end) {
+            const ElfW(Nhdr)* nhdr = (const ElfW(Nhdr)*)p;
+            const size_t desc_off = (sizeof(ElfW(Nhdr)) + nhdr->n_namesz + align - 1) & ~(align - 1);
+            const size_t note_size = (desc_off + nhdr->n_descsz + align - 1) & ~(align - 1);
+            if (p + desc_off + nhdr->n_descsz > end) break;
+
+            if (nhdr->n_type == ENCRYPT_NOTE_TYPE && nhdr->n_namesz == sizeof(owner) &&
+                memcmp(p + sizeof(ElfW(Nhdr)), owner, sizeof(owner)) == 0) {
+                addBlock(p + desc_off, nhdr->n_descsz);
+            }
+            p += note_size;
+        }
+    }
+
+    // 任何一个描述符不可用时整张表作废：只解密其余块会留下半段密文，
+    // 调用方据 rejectedCount() 报错，而不是当作没有描述符退回整段异或
+    if (m_rejected) {
+        DECRYPT_LOG_ERROR("[EncryptTable] %zu encrypt descriptor(s) unusable, refusing to decrypt this image\n",
+                          m_rejected);
+        m_blocks.clear();
+        m_funcs.clear();
+    }
+
+    m_by_addr.resize(m_funcs.size());
+    for (uint32_t i = 0; i < m_by_addr.size(); i++) {
+        m_by_addr[i] = i;
+    }
+    std::sort(m_by_addr.begin(), m_by_addr.end(), [this](uint32_t a, uint32_t b) {
+        return m_funcs[a].addr < m_funcs[b].addr;
+    });
+
+    m_state.reset(new std::atomic<uint8_t>[m_funcs.size() ? m_funcs.size() : 1]);
+    bool all_decrypted = !m_blocks.empty();
+    for (size_t i = 0; i < m_funcs.size(); i++) {
+        const bool decrypted = m_blocks[m_funcs[i].block].decrypted;
+        m_state[i].store(decrypted ? FUNC_DECRYPTED : FUNC_ENCRYPTED, std::memory_order_relaxed);
+    }
+    for (const EncryptBlock& b : m_blocks) {
+        all_decrypted = all_decrypted && b.decrypted;
+    }
+    m_all_decrypted.store(all_decrypted, std::memory_order_release);
+    return !m_blocks.empty();
+}
+
+void EncryptTable::addBlock(const uint8_t* desc, size_t desc_size)
+{
+    const EncryptTableHeader* hdr = (const EncryptTableHeader*)desc;
+    if (desc_size < sizeof(EncryptTableHeader) || hdr->magic != ENCRYPT_TABLE_MAGIC) {
+        DECRYPT_LOG_ERROR("[EncryptTable] Bad descriptor magic at %p (%zu bytes)\n", (const void*)desc, desc_size);
+        m_rejected++;
+        return;
+    }
+    if (hdr->version != ENCRYPT_TABLE_VERSION) {
+        DECRYPT_LOG_ERROR("[EncryptTable] Descriptor version %u at %p, this decryptor supports %u; "
+                          "rebuild with a matching encrypt_tool/runtime\n",
+                          (unsigned)hdr->version, (const void*)desc, (unsigned)ENCRYPT_TABLE_VERSION);
+        m_rejected++;
+        return;
+    }
+    if (hdr->block_size != desc_size ||
+        sizeof(EncryptTableHeader) + (size_t)hdr->func_count * sizeof(EncryptFuncEntry)
+            + (size_t)hdr->hole_count * sizeof(EncryptHole) > desc_size) {
+        DECRYPT_LOG_ERROR("[EncryptTable] Corrupted descriptor at %p\n", (const void*)desc);
+        m_rejected++;
+        return;
+    }
+    if (!(hdr->flags & ENCRYPT_TABLE_FLAG_ENCRYPTED) || hdr->section_size == 0) {
+        return;
+    }
+    if (hdr->cipher != ENCRYPT_CIPHER_XOR && hdr->cipher != ENCRYPT_CIPHER_AES128_CTR &&
+        hdr->cipher != ENCRYPT_CIPHER_AES256_CTR) {
+        DECRYPT_LOG_ERROR("[EncryptTable] Unknown cipher %u at %p\n", (unsigned)hdr->cipher, (const void*)desc);
+        m_rejected++;
+        return;
+    }
+
+    EncryptBlock b;
+    b.header = hdr;
+    b.sec_addr = encrypt_rel_target(&hdr->rel_section);
+    b.sec_size = hdr->section_size;
+    b.func_count = hdr->func_count;
+    b.funcs = (const EncryptFuncEntry*)(hdr + 1);
+    b.hole_count = hdr->hole_count;
+    b.holes = (const EncryptHole*)(b.funcs + b.func_count);
+    b.func_first = (uint32_t)m_funcs.size();
+    b.decrypted = (hdr->flags & ENCRYPT_TABLE_FLAG_DECRYPTED) != 0;
+    b.cipher = hdr->cipher;
+    b.nonce = hdr->nonce;
+
+    for (uint32_t i = 0; i < b.func_count; i++) {
+        EncryptFunc f;
+        f.addr = encrypt_rel_target(&b.funcs[i].rel_addr);
+        f.size = b.funcs[i].size;
+        f.block = (uint32_t)m_blocks.size();
+        m_funcs.push_back(f);
+    }
+    m_blocks.push_back(b);
+}
+
+bool EncryptTable::extent(uintptr_t& start, size_t& size) const
+{
+    if (m_blocks.empty()) return false;
+    uintptr_t lo = UINTPTR_MAX, hi = 0;
+    for (const EncryptBlock& b : m_blocks) {
+        lo = std::min(lo, b.sec_addr);
+        hi = std::max(hi, b.sec_addr + b.sec_size);
+    }
+    start = lo;
+    size = hi - lo;
+    return true;
+}
+
+long EncryptTable::findFunction(uintptr_t addr) const
+{
+    // 找最后一个起始地址 <= addr 的函数
+    auto it = std::upper_bound(m_by_addr.begin(), m_by_addr.end(), addr, [this](uintptr_t a, uint32_t idx) {
+        return a < m_funcs[idx].addr;
+    });
+    if (it == m_by_addr.begin()) return -1;
+    const EncryptFunc& f = m_funcs[*(it - 1)];
+    return (addr < f.addr + f.size) ? (long)*(it - 1) : -1;
+}
+
+// 块内偏移 off 处的 len 字节与密钥流异或（两种算法的密钥流都按段内偏移寻址）
+static inline void apply_keystream(const EncryptBlock& b, uint8_t* data, size_t len, size_t off, const CipherKey& key)
+{
+    switch (b.cipher) {
+        case ENCRYPT_CIPHER_XOR:
+            if (key.xor_cipher) key.xor_cipher->apply(data, len, 0, off);
+            break;
+        case ENCRYPT_CIPHER_AES128_CTR:
+            if (key.aes128) key.aes128->apply(data, len, b.nonce, off);
+            break;
+        case ENCRYPT_CIPHER_AES256_CTR:
+            if (key.aes256) key.aes256->apply(data, len, b.nonce, off);
+            break;
+    }
+}
+
+// 明文 CRC 的累加状态（一个块内一段连续区间）
+struct CrcAcc {
+    uint32_t crc;
+    size_t bytes;
+};
+
+// 块内偏移 off 处的一段非空洞字节：apply 时异或；acc 非空时按 ENCRYPT_CRC_TILE 分段，
+// 每段异或后数据仍在 L1 中，紧接着累加 CRC（内存只过一遍）
+static inline void process_run(const EncryptBlock& b, uint8_t* base, size_t off, size_t len, const CipherKey& key,
+                               bool apply, CrcAcc* acc)
+{
+    if (!acc) {
+        if (apply) apply_keystream(b, base + off, len, off, key);
+        return;
+    }
+    for (size_t done = 0; done < len;) {
+        const size_t n = std::min(ENCRYPT_CRC_TILE, len - done);
+        if (apply) apply_keystream(b, base + off + done, n, off + done, key);
+        acc->crc = Crc32c::update(acc->crc, base + off + done, n);
+        done += n;
+    }
+    acc->bytes += len;
+}
+
+// 解密单个块内 [off_start, off_end)，跳过重定位空洞；数据位于运行时地址 + delta 处。
+// apply 为 false 时只累加 CRC（已单独解密的函数），返回 0
+static size_t decrypt_block(const EncryptBlock& b, size_t off_start, size_t off_end, const CipherKey& key,
+                            intptr_t delta, CrcAcc* acc = nullptr, bool apply = true)
+{
+    uint8_t* base = (uint8_t*)(b.sec_addr + delta);
+    size_t total = 0;
+
+    // 第一个结束位置在 off_start 之后的空洞
+    const EncryptHole* h = std::lower_bound(b.holes, b.holes + b.hole_count, off_start,
+        [](const EncryptHole& hole, size_t off) { return hole.offset + hole.size <= off; });
+    const EncryptHole* h_end = b.holes + b.hole_count;
+
+    size_t cursor = off_start;
+    for (; h != h_end && h->offset < off_end; ++h) {
+        if (h->offset > cursor) {
+            process_run(b, base, cursor, h->offset - cursor, key, apply, acc);
+            total += h->offset - cursor;
+        }
+        cursor = std::max(cursor, (size_t)h->offset + h->size);
+    }
+    if (cursor < off_end) {
+        process_run(b, base, cursor, off_end - cursor, key, apply, acc);
+        total += off_end - cursor;
+    }
+    return apply ? total : 0;
+}
+
+size_t EncryptTable::decryptRange(uintptr_t start, size_t len, const CipherKey& key, intptr_t delta) const
+{
+    const uintptr_t end = start + len;
+    size_t total = 0;
+
+    for (const EncryptBlock& b : m_blocks) {
+        const uintptr_t b_end = b.sec_addr + b.sec_size;
+        if (b.decrypted || b_end <= start || b.sec_addr >= end) continue;
+        total += decrypt_block(b, std::max(start, b.sec_addr) - b.sec_addr,
+                               std::min(end, b_end) - b.sec_addr, key, delta);
+    }
+    return total;
+}
+
+// 块内 [off_start, off_end) 中跳过已解密函数的部分；acc 非空时已解密函数也计入 CRC
+static size_t decrypt_block_pending(const EncryptBlock& b, const std::atomic<uint8_t>* state,
+                                    size_t off_start, size_t off_end, const CipherKey& key, intptr_t delta,
+                                    CrcAcc* acc = nullptr)
+{
+    // 函数按偏移有序：第一个结束位置在 off_start 之后的函数
+    const EncryptFuncEntry* f = std::lower_bound(b.funcs, b.funcs + b.func_count, off_start,
+        [](const EncryptFuncEntry& e, size_t off) { return (size_t)e.key_offset + e.size <= off; });
+    const EncryptFuncEntry* f_end = b.funcs + b.func_count;
+
+    size_t total = 0;
+    size_t cursor = off_start;
+    for (; f != f_end && f->key_offset < off_end; ++f) {
+        if (state[b.func_first + (f - b.funcs)].load(std::memory_order_acquire) != FUNC_DECRYPTED) continue;
+        if (f->key_offset > cursor) {
+            total += decrypt_block(b, cursor, f->key_offset, key, delta, acc);
+        }
+        const size_t f_stop = std::min(off_end, (size_t)f->key_offset + f->size);
+        if (acc && f_stop > std::max(cursor, (size_t)f->key_offset)) {
+            decrypt_block(b, std::max(cursor, (size_t)f->key_offset), f_stop, key, delta, acc, false);
+        }
+        cursor = std::max(cursor, f_stop);
+    }
+    if (cursor < off_end) {
+        total += decrypt_block(b, cursor, off_end, key, delta, acc);
+    }
+    return total;
+}
+
+size_t EncryptTable::decryptPending(uintptr_t start, size_t len, const CipherKey& key, intptr_t delta) const
+{
+    const uintptr_t end = start + len;
+    size_t total = 0;
+
+    for (const EncryptBlock& b : m_blocks) {
+        const uintptr_t b_end = b.sec_addr + b.sec_size;
+        if (b.decrypted || b_end <= start || b.sec_addr >= end) continue;
+        total += decrypt_block_pending(b, m_state.get(), std::max(start, b.sec_addr) - b.sec_addr,
+                                       std::min(end, b_end) - b.sec_addr, key, delta);
+    }
+    return total;
+}
+
+size_t EncryptTable::decryptPendingChecked(uintptr_t start, size_t len, const CipherKey& key, PlainChecksum& sums,
+                                           intptr_t delta) const
+{
+    const uintptr_t end = start + len;
+    size_t total = 0;
+
+    for (size_t i = 0; i < m_blocks.size(); i++) {
+        const EncryptBlock& b = m_blocks[i];
+        const uintptr_t b_end = b.sec_addr + b.sec_size;
+        if (b.decrypted || b_end <= start || b.sec_addr >= end) continue;
+        const size_t off_start = std::max(start, b.sec_addr) - b.sec_addr;
+        const size_t off_end = std::min(end, b_end) - b.sec_addr;
+        if (!(b.header->flags & ENCRYPT_TABLE_FLAG_CRC)) {
+            total += decrypt_block_pending(b, m_state.get(), off_start, off_end, key, delta);
+            continue;
+        }
+        CrcAcc acc = {0, 0};
+        total += decrypt_block_pending(b, m_state.get(), off_start, off_end, key, delta, &acc);
+        sums.add((uint32_t)i, off_start, off_end, acc.bytes, acc.crc);
+    }
+    return total;
+}
+
+bool EncryptTable::hasChecksums() const
+{
+    for (const EncryptBlock& b : m_blocks) {
+        if (!b.decrypted && (b.header->flags & ENCRYPT_TABLE_FLAG_CRC)) return true;
+    }
+    return false;
+}
+
+void EncryptTable::markAllDecrypted()
+{
+    for (size_t i = 0; i < m_funcs.size(); i++) {
+        m_state[i].store(FUNC_DECRYPTED, std::memory_order_release);
+    }
+    m_all_decrypted.store(true, std::memory_order_release);
+}
+
+size_t EncryptTable::decryptRemaining(const CipherKey& key)
+{
+    // 函数间隙没有单独的状态，重复执行会把间隙再异或一次
+    if (m_all_decrypted.load(std::memory_order_acquire)) return 0;
+
+    size_t total = 0;
+    for (const EncryptBlock& b : m_blocks) {
+        if (b.decrypted) continue;
+        total += decrypt_block_pending(b, m_state.get(), 0, b.sec_size, key, 0);
+    }
+    markAllDecrypted();
+    return total;
+}
+
+// ===================== 明文校验和 =====================
+void PlainChecksum::add(uint32_t block, size_t offset, size_t end, size_t len, uint32_t crc)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_pieces.empty() && m_pieces.back().block == block && m_pieces.back().end == offset) {
+        Piece& last = m_pieces.back();
+        last.crc = Crc32c::combine(last.crc, crc, len);
+        last.end = (uint32_t)end;
+        last.len += (uint32_t)len;
+        return;
+    }
+    m_pieces.push_back(Piece{block, (uint32_t)offset, (uint32_t)end, (uint32_t)len, crc});
+}
+
+// 块内不属于重定位空洞的字节数（空洞已排序，可能相邻或重叠）
+static size_t plain_bytes(const EncryptBlock& b)
+{
+    size_t covered = 0, cursor = 0;
+    for (uint32_t i = 0; i < b.hole_count; i++) {
+        const size_t lo = std::max(cursor, (size_t)b.holes[i].offset);
+        const size_t hi = std::min(b.sec_size, (size_t)b.holes[i].offset + b.holes[i].size);
+        if (hi > lo) covered += hi - lo;
+        cursor = std::max(cursor, hi);
+    }
+    return b.sec_size - covered;
+}
+
+bool PlainChecksum::verify(const EncryptTable& table, size_t& bad_block) const
+{
+    std::vector<Piece> pieces;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        pieces = m_pieces;
+    }
+    std::sort(pieces.begin(), pieces.end(), [](const Piece& a, const Piece& b) {
+        return a.block != b.block ? a.block < b.block : a.offset < b.offset;
+    });
+
+    auto p = pieces.begin();
+    for (size_t i = 0; i < table.blockCount(); i++) {
+        const EncryptBlock& b = table.block(i);
+        const auto first = p;
+        uint32_t crc = 0;
+        size_t bytes = 0;
+        for (; p != pieces.end() && p->block == i; ++p) {
+            crc = Crc32c::combine(crc, p->crc, p->len);
+            bytes += p->len;
+        }
+        // 本次解密没有经过的块不比较；经过的必须完整覆盖
+        if (first == p || b.decrypted || !(b.header->flags & ENCRYPT_TABLE_FLAG_CRC)) continue;
+        if (bytes != plain_bytes(b) || crc != b.header->plain_crc) {
+            bad_block = i;
+            return false;
+        }
+    }
+    return true;
+}
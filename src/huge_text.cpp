@@ -0,0 +1,54 @@
+#include "huge_text.h"
+#include "decrypt_log.h"
+#include <cerrno>
+#include <cstring>
+#include <sys/mman.h>
+
+#ifndef MADV_COLLAPSE
+#define MADV_COLLAPSE 25    // Linux 6.1+
+#endif
+
+size_t HugeText::promote(uintptr_t start, size_t len)
+{
+    const uintptr_t huge_start = (start + HUGE_PAGE_SIZE - 1) & ~(uintptr_t)(HUGE_PAGE_SIZE - 1);
+    const uintptr_t huge_end = (start + len) & ~(uintptr_t)(HUGE_PAGE_SIZE - 1);
+    if (huge_end <= huge_start) {
+        DECRYPT_LOG_DEBUG("[HugeText] No 2 MB aligned range in 0x%lx..0x%lx\n",
+                          (unsigned long)start, (unsigned long)(start + len));
+        return 0;
+    }
+    const size_t n = huge_end - huge_start;
+
+    // 多申请一个大页再裁掉首尾，得到 2 MB 对齐的匿名区
+    uint8_t* raw = (uint8_t*)mmap(nullptr, n + HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE,
+                                  MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED) {
+        DECRYPT_LOG_ERROR("[HugeText] mmap %zu bytes failed: %s\n", n, strerror(errno));
+        return 0;
+    }
+    uint8_t* tmp = (uint8_t*)(((uintptr_t)raw + HUGE_PAGE_SIZE - 1) & ~(uintptr_t)(HUGE_PAGE_SIZE - 1));
+    if (tmp > raw) munmap(raw, tmp - raw);
+    if (raw + HUGE_PAGE_SIZE > tmp) munmap(tmp + n, raw + HUGE_PAGE_SIZE - tmp);
+
+    if (madvise(tmp, n, MADV_HUGEPAGE) != 0) {
+        DECRYPT_LOG_DEBUG("[HugeText] MADV_HUGEPAGE unavailable: %s\n", strerror(errno));
+        munmap(tmp, n);
+        return 0;
+    }
+    memcpy(tmp, (const void*)huge_start, n);
+    // 缺页时已直接分配大页则无事可做；分配失败退回 4 KB 页时同步合并（失败不影响正确性）
+    if (madvise(tmp, n, MADV_COLLAPSE) != 0) {
+        DECRYPT_LOG_DEBUG("[HugeText] MADV_COLLAPSE: %s\n", strerror(errno));
+    }
+
+    if (mprotect(tmp, n, PROT_READ | PROT_EXEC) != 0 ||
+        mremap(tmp, n, n, MREMAP_MAYMOVE | MREMAP_FIXED, (void*)huge_start) == MAP_FAILED) {
+        DECRYPT_LOG_ERROR("[HugeText] Remap 0x%lx (%zu bytes) failed: %s\n",
+                          (unsigned long)huge_start, n, strerror(errno));
+        munmap(tmp, n);
+        return 0;
+    }
+    DECRYPT_LOG_INFO("[HugeText] Remapped 0x%lx..0x%lx onto huge pages\n",
+                     (unsigned long)huge_start, (unsigned long)huge_end);
+    return n;
+}
@@ -0,0 +1,142 @@
+#include "decryptor_linux.h"
+#include "image_locator.h"
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+// ===================== hugetext_bench 被测镜像 =====================
+// 链接加密的跳转链载荷（hugetext_bench_payload.cpp）。CMake 生成两份：默认布局（.encrypt_text 与
+// 普通 .text 同段）与 .encrypt_text 单独成 2 MB 对齐段。启动后：
+//   1. 统计本镜像范围内的 VMA 数
+//   2. Decryptor::decrypt()（参数 huge 时先 setHugePages(true)）
+//   3. 再统计 VMA 数，以及镜像范围内的私有脏页与匿名大页（/proc/self/smaps）
+//   4. 执行跳转链 iterations 遍，记录耗时与 iTLB 读缺失数（perf_event_open，无硬件 PMU 时为 -1）
+// 结果写成一行到 fd 3（未打开时写 stdout）：
+//   <ok>,<vma_before>,<vma_after>,<private_dirty_kb>,<anon_huge_kb>,<itlb_misses>,<walk_ns>
+// 用法：hugetext_bench_image [plain|huge] [iterations]
+
+#ifndef HUGETEXT_BENCH_STEPS
+#define HUGETEXT_BENCH_STEPS 2048
+#endif
+
+extern "C" uint64_t hugetext_walk(uint64_t iterations);
+
+static inline uint64_t now_ns()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+// 主程序所有 PT_LOAD 覆盖的地址范围
+static bool image_range(uintptr_t& lo, uintptr_t& hi)
+{
+    ImageInfo img;
+    if (!ImageLocator::findMain(img)) return false;
+    lo = UINTPTR_MAX;
+    hi = 0;
+    for (uint16_t i = 0; i < img.phnum; i++) {
+        if (img.phdr[i].p_type != PT_LOAD) continue;
+        const uintptr_t start = img.load_bias + img.phdr[i].p_vaddr;
+        lo = start < lo ? start : lo;
+        hi = start + img.phdr[i].p_memsz > hi ? start + img.phdr[i].p_memsz : hi;
+    }
+    return hi > lo;
+}
+
+struct RangeUsage {
+    size_t vmas = 0;
+    uint64_t private_dirty_kb = 0;
+    uint64_t anon_huge_kb = 0;
+};
+
+// 与 [lo, hi) 相交的 VMA 个数及其私有脏页、匿名大页
+static RangeUsage range_usage(uintptr_t lo, uintptr_t hi)
+{
+    RangeUsage u;
+    FILE* fp = fopen("/proc/self/smaps", "r");
+    if (!fp) return u;
+    char line[512];
+    bool inside = false;
+    while (fgets(line, sizeof(line), fp)) {
+        // VMA 头行以 "start-end " 开头，字段行为 "Name: value"
+        unsigned long start, end, kb;
+        const char* space = strchr(line, ' ');
+        if (space && memchr(line, '-', space - line) && sscanf(line, "%lx-%lx ", &start, &end) == 2) {
+            inside = start < hi && end > lo;
+            u.vmas += inside ? 1 : 0;
+        } else if (inside && sscanf(line, "Private_Dirty: %lu kB", &kb) == 1) {
+            u.private_dirty_kb += kb;
+        } else if (inside && sscanf(line, "AnonHugePages: %lu kB", &kb) == 1) {
+            u.anon_huge_kb += kb;
+        }
+    }
+    fclose(fp);
+    return u;
+}
+
+static int open_itlb_counter()
+{
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HW_CACHE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_CACHE_ITLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                  (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+int main(int argc, char* argv[])
+{
+    const bool huge = argc > 1 && strcmp(argv[1], "huge") == 0;
+    const uint64_t iterations = argc > 2 ? strtoull(argv[2], nullptr, 10) : 200;
+
+    uintptr_t lo = 0, hi = 0;
+    if (!image_range(lo, hi)) return 1;
+    const RangeUsage before = range_usage(lo, hi);
+
+    Decryptor::setTargetInfo(Decryptor::TYPE_STATIC_A, nullptr);
+    Decryptor::setHugePages(huge);
+    bool ok = Decryptor::decrypt();
+    const RangeUsage after = range_usage(lo, hi);
+
+    long long itlb = -1;
+    uint64_t walk_ns = 0;
+    if (ok) {
+        hugetext_walk(1);   // 预热
+        const int fd = open_itlb_counter();
+        if (fd >= 0) {
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+        const uint64_t t0 = now_ns();
+        const uint64_t steps = hugetext_walk(iterations);
+        walk_ns = now_ns() - t0;
+        if (fd >= 0) {
+            ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+            uint64_t count = 0;
+            if (read(fd, &count, sizeof(count)) == sizeof(count)) itlb = (long long)count;
+            close(fd);
+        }
+        ok = steps == iterations * HUGETEXT_BENCH_STEPS;
+    }
+
+    char line[256];
+    const int len = snprintf(line, sizeof(line), "%d,%zu,%zu,%llu,%llu,%lld,%llu\n", ok ? 1 : 0,
+                             before.vmas, after.vmas, (unsigned long long)after.private_dirty_kb,
+                             (unsigned long long)after.anon_huge_kb, itlb, (unsigned long long)walk_ns);
+    const int out = fcntl(3, F_GETFD) != -1 ? 3 : STDOUT_FILENO;
+    fflush(stdout);
+    if (write(out, line, len) != len) return 2;
+    return ok ? 0 : 1;
+}
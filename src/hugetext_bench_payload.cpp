@@ -0,0 +1,34 @@
+// ========== hugetext_bench 加密载荷（构建时由 encrypt_tool 加密） ==========
+// hugetext_walk(n)：把 HUGETEXT_BENCH_STEPS 个跳转依次串起来执行 n 遍，相邻两步相隔
+// HUGETEXT_BENCH_STRIDE 字节（略大于一页，使每步落在不同的 4 KB 页和不同的缓存组），
+// 返回执行的步数（n * HUGETEXT_BENCH_STEPS），用于校验代码已正确解密。
+// 全部写成汇编，保证跳转链的布局不受编译器影响
+
+#ifndef HUGETEXT_BENCH_STEPS
+#define HUGETEXT_BENCH_STEPS 2048
+#endif
+#ifndef HUGETEXT_BENCH_STRIDE
+#define HUGETEXT_BENCH_STRIDE 4160
+#endif
+
+#define HUGETEXT_BENCH_STR_(x) #x
+#define HUGETEXT_BENCH_STR(x) HUGETEXT_BENCH_STR_(x)
+
+__asm__(".pushsection .encrypt_text,\"ax\",@progbits\n"
+        ".p2align 12\n"
+        ".globl hugetext_walk\n"
+        ".type hugetext_walk,@function\n"
+        "hugetext_walk:\n"
+        "xorl %eax, %eax\n"
+        ".Lhugetext_walk_loop:\n"
+        ".rept " HUGETEXT_BENCH_STR(HUGETEXT_BENCH_STEPS) "\n"
+        "incq %rax\n"
+        "jmp 1f\n"
+        ".fill " HUGETEXT_BENCH_STR(HUGETEXT_BENCH_STRIDE) " - 8,1,0xcc\n"
+        "1:\n"
+        ".endr\n"
+        "decq %rdi\n"
+        "jnz .Lhugetext_walk_loop\n"
+        "ret\n"
+        ".size hugetext_walk,.-hugetext_walk\n"
+        ".popsection\n");
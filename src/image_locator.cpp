@@ -0,0 +1,121 @@
+#include "image_locator.h"
+#include <cstring>
+#include <dlfcn.h>
+#include <sys/auxv.h>
+
+// ===================== 内部实现 =====================
+namespace {
+
+enum MatchKind {
+    MATCH_ADDRESS,
+    MATCH_NAME,
+    MATCH_MAIN
+};
+
+struct MatchRequest {
+    MatchKind kind;
+    uintptr_t addr;
+    const char* name;
+    ImageInfo* out;
+    bool first;
+    bool found;
+};
+
+static const char* main_program_path()
+{
+    const char* path = (const char*)getauxval(AT_EXECFN);
+    return path ? path : "";
+}
+
+static bool contains_address(const struct dl_phdr_info* info, uintptr_t addr)
+{
+    for (int i = 0; i < info->dlpi_phnum; i++) {
+        const ElfW(Phdr)& ph = info->dlpi_phdr[i];
+        if (ph.p_type != PT_LOAD) continue;
+        const uintptr_t start = info->dlpi_addr + ph.p_vaddr;
+        if (addr >= start && addr < start + ph.p_memsz) return true;
+    }
+    return false;
+}
+
+static int match_callback(struct dl_phdr_info* info, size_t, void* data)
+{
+    MatchRequest* req = (MatchRequest*)data;
+    const bool is_main = req->first;
+    req->first = false;
+
+    // 主程序在 link_map 中名字为空，用 AT_EXECFN 代替
+    const char* path = (info->dlpi_name && info->dlpi_name[0]) ? info->dlpi_name
+                     : (is_main ? main_program_path() : "");
+
+    bool match = false;
+    switch (req->kind) {
+        case MATCH_ADDRESS: match = contains_address(info, req->addr); break;
+        case MATCH_NAME:    match = path[0] && strstr(path, req->name) != nullptr; break;
+        case MATCH_MAIN:    match = is_main; break;
+    }
+    if (!match) return 0;
+
+    req->out->load_bias = (uintptr_t)info->dlpi_addr;
+    req->out->path = path;
+    req->out->phdr = info->dlpi_phdr;
+    req->out->phnum = info->dlpi_phnum;
+    req->out->is_main = is_main;
+    req->found = true;
+    return 1;
+}
+
+static bool locate(MatchKind kind, uintptr_t addr, const char* name, ImageInfo& out)
+{
+    MatchRequest req = {kind, addr, name, &out, true, false};
+    dl_iterate_phdr(match_callback, &req);
+    return req.found;
+}
+
+} // namespace
+
+// ===================== ImageLocator 实现 =====================
+bool ImageLocator::findByAddress(const void* addr, ImageInfo& out)
+{
+    return addr && locate(MATCH_ADDRESS, (uintptr_t)addr, nullptr, out);
+}
+
+bool ImageLocator::findByName(const char* name, ImageInfo& out)
+{
+    return name && name[0] && locate(MATCH_NAME, 0, name, out);
+}
+
+bool ImageLocator::findMain(ImageInfo& out)
+{
+    return locate(MATCH_MAIN, 0, nullptr, out);
+}
+
+bool ImageLocator::fromLinkMap(const struct link_map* lm, ImageInfo& out)
+{
+    if (!lm) return false;
+
+    // 基础命名空间的第一个对象（名字为空）是主程序：程序头由内核给出
+    if ((!lm->l_name || !lm->l_name[0]) && !lm->l_prev) {
+        out.load_bias = lm->l_addr;
+        out.path = main_program_path();
+        out.phdr = (const ElfW(Phdr)*)getauxval(AT_PHDR);
+        out.phnum = (uint16_t)getauxval(AT_PHNUM);
+        out.is_main = true;
+        return out.phdr != nullptr;
+    }
+
+    // dladdr 会查所有命名空间，dli_fbase 即首个 PT_LOAD 的映射起点（ELF 头）
+    Dl_info info;
+    const ElfW(Ehdr)* ehdr = nullptr;
+    if (lm->l_ld && dladdr((const void*)lm->l_ld, &info) && info.dli_fbase) {
+        ehdr = (const ElfW(Ehdr)*)info.dli_fbase;
+    }
+    if (!ehdr || memcmp(ehdr->e_ident, ELFMAG, SELFMAG) != 0 || ehdr->e_phoff == 0) return false;
+
+    out.load_bias = lm->l_addr;
+    out.path = lm->l_name ? lm->l_name : "";
+    out.phdr = (const ElfW(Phdr)*)((const uint8_t*)ehdr + ehdr->e_phoff);
+    out.phnum = ehdr->e_phnum;
+    out.is_main = false;
+    return true;
+}
@@ -0,0 +1,207 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+
+// ===================== encrypt_tool 目标文件 I/O 方式基准 =====================
+// 把带 4 MB 调试段的模板目标文件复制 files 份，分别在冷/热页缓存下运行
+// encrypt_tool -m mmap（整文件映射 + 逐文件 MS_SYNC）与 -m pread（只读写加密区间，-s 选择落盘方式），
+// 报告耗时、MB/s 与工具统计的读写字节数，并校验各方式输出逐字节相同。
+// 冷缓存：建树后 sync，再对每个文件 POSIX_FADV_DONTNEED；热缓存：运行前完整读一遍。
+// 需在真实磁盘文件系统上运行（tmpfs 无冷缓存）。
+// 用法：io_bench [files] [dir] [jobs]
+
+#ifndef IO_BENCH_TOOL
+#define IO_BENCH_TOOL "encrypt_tool"
+#endif
+#ifndef IO_BENCH_TEMPLATE
+#define IO_BENCH_TEMPLATE "template.o"
+#endif
+
+struct IoConfig {
+    const char* name;
+    const char* io;
+    const char* sync;
+};
+
+static const IoConfig kConfigs[] = {
+    {"mmap+msync",   "mmap",  "fsync"},
+    {"pread+fsync",  "pread", "fsync"},
+    {"pread+syncfs", "pread", "syncfs"},
+    {"pread+none",   "pread", "none"},
+};
+
+static inline uint64_t now_ns()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static bool read_file(const std::string& path, std::vector<char>& data)
+{
+    FILE* fp = fopen(path.c_str(), "rb");
+    if (!fp) return false;
+    data.clear();
+    char buf[65536];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), fp)) > 0) {
+        data.insert(data.end(), buf, buf + n);
+    }
+    fclose(fp);
+    return true;
+}
+
+static bool write_file(const std::string& path, const std::vector<char>& data)
+{
+    const int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return false;
+    const bool ok = write(fd, data.data(), data.size()) == (ssize_t)data.size();
+    close(fd);
+    return ok;
+}
+
+static std::string file_path(const std::string& root, size_t i)
+{
+    char rel[32];
+    snprintf(rel, sizeof(rel), "/obj_%05zu.o", i);
+    return root + rel;
+}
+
+static bool make_tree(const std::string& root, size_t files, const std::vector<char>& image)
+{
+    mkdir(root.c_str(), 0755);
+    for (size_t i = 0; i < files; i++) {
+        if (!write_file(file_path(root, i), image)) return false;
+    }
+    return true;
+}
+
+// 回写后丢弃页缓存（冷），或完整读入页缓存（热）
+static void prepare_cache(const std::string& root, size_t files, bool cold)
+{
+    sync();
+    std::vector<char> data;
+    for (size_t i = 0; i < files; i++) {
+        const std::string path = file_path(root, i);
+        if (!cold) {
+            read_file(path, data);
+            continue;
+        }
+        const int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) continue;
+        posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        close(fd);
+    }
+}
+
+// 运行 encrypt_tool，日志写入 log_path，返回耗时（纳秒），失败返回 0
+static uint64_t run_tool(const std::string& root, const IoConfig& cfg, size_t jobs, const std::string& log_path)
+{
+    const std::string jobs_arg = std::to_string(jobs);
+    const uint64_t t0 = now_ns();
+    const pid_t pid = fork();
+    if (pid == 0) {
+        const int fd = open(log_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) _exit(127);
+        dup2(fd, STDOUT_FILENO);
+        dup2(fd, STDERR_FILENO);
+        execl(IO_BENCH_TOOL, IO_BENCH_TOOL, "-j", jobs_arg.c_str(), "-m", cfg.io, "-s", cfg.sync,
+              root.c_str(), (char*)nullptr);
+        _exit(127);
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+    const uint64_t elapsed = now_ns() - t0;
+    return (WIFEXITED(status) && WEXITSTATUS(status) == 0) ? elapsed : 0;
+}
+
+// 从工具日志的 "I/O:" 一行取读写量（MB）
+static void parse_io(const std::string& log_path, double& read_mb, double& written_mb)
+{
+    std::vector<char> data;
+    read_file(log_path, data);
+    const std::string text(data.begin(), data.end());
+    read_mb = written_mb = -1;
+    const size_t pos = text.find("read ", text.find("[ObjEncryptor] I/O:"));
+    if (pos != std::string::npos) {
+        sscanf(text.c_str() + pos, "read %lf MB, written %lf MB", &read_mb, &written_mb);
+    }
+}
+
+static bool same_outputs(const std::string& a, const std::string& b, size_t files)
+{
+    std::vector<char> x, y;
+    for (size_t i = 0; i < files; i++) {
+        if (!read_file(file_path(a, i), x) || !read_file(file_path(b, i), y) || x != y) return false;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    const size_t files = argc > 1 ? strtoul(argv[1], nullptr, 10) : 64;
+    const std::string parent = argc > 2 ? argv[2] : "/tmp";
+    size_t jobs = argc > 3 ? strtoul(argv[3], nullptr, 10) : 0;
+    if (jobs == 0) jobs = sysconf(_SC_NPROCESSORS_ONLN) > 1 ? sysconf(_SC_NPROCESSORS_ONLN) : 1;
+    if (files == 0) {
+        fprintf(stderr, "usage: %s [files] [dir] [jobs]\n", argv[0]);
+        return 1;
+    }
+
+    std::vector<char> image;
+    if (!read_file(IO_BENCH_TEMPLATE, image) || image.empty()) {
+        fprintf(stderr, "[io_bench] Cannot read template object %s\n", IO_BENCH_TEMPLATE);
+        return 1;
+    }
+    std::string dir_tmpl = parent + "/io_bench_XXXXXX";
+    if (!mkdtemp(&dir_tmpl[0])) {
+        perror("mkdtemp");
+        return 1;
+    }
+    const std::string base = dir_tmpl;
+    const double total_mb = files * (double)image.size() / (1024.0 * 1024.0);
+    printf("encrypt_tool: %zu objects x %.1f MB (%.1f MB) in %s, %zu jobs\n",
+           files, image.size() / (1024.0 * 1024.0), total_mb, base.c_str(), jobs);
+    printf("%-14s %-6s %10s %10s %10s %12s\n", "mode", "cache", "time(ms)", "MB/s", "read(MB)", "written(MB)");
+
+    const std::string ref = base + "/ref";
+    bool have_ref = false, ok = true;
+    for (int cold = 1; cold >= 0; cold--) {
+        for (const IoConfig& cfg : kConfigs) {
+            const std::string tree = have_ref ? base + "/run" : ref;
+            const std::string log = base + "/run.log";
+            if (!make_tree(tree, files, image)) {
+                fprintf(stderr, "[io_bench] Failed to create object tree\n");
+                return 1;
+            }
+            prepare_cache(tree, files, cold);
+            const uint64_t ns = run_tool(tree, cfg, jobs, log);
+            if (ns == 0) {
+                printf("%-14s %-6s failed (see %s)\n", cfg.name, cold ? "cold" : "warm", log.c_str());
+                ok = false;
+                continue;
+            }
+            double read_mb, written_mb;
+            parse_io(log, read_mb, written_mb);
+            const bool same = !have_ref || same_outputs(ref, tree, files);
+            ok = ok && same;
+            printf("%-14s %-6s %10.1f %10.1f %10.2f %12.2f%s\n", cfg.name, cold ? "cold" : "warm", ns / 1e6,
+                   total_mb / (ns / 1e9), read_mb, written_mb, same ? "" : "  OUTPUT MISMATCH");
+            have_ref = true;
+        }
+    }
+    printf("outputs identical across modes: %s\n", ok ? "yes" : "no");
+
+    if (ok) {
+        const std::string cmd = "rm -rf '" + base + "'";
+        if (system(cmd.c_str()) != 0) fprintf(stderr, "[io_bench] Failed to remove %s\n", base.c_str());
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,24 @@
+#include "decryptor_linux.h"
+
+// ========== io_bench 模板目标文件 ==========
+// 小的 .encrypt_text 加上 4 MB 不可分配段（模拟大量调试信息）：加密只涉及前者，
+// 整文件映射 + MS_SYNC 与按区间 pread/pwrite 的差别主要来自后者
+
+__asm__(".pushsection .debug_io_bench,\"\",@progbits\n"
+        ".fill 4194304,1,0x5a\n"
+        ".popsection\n");
+
+static __attribute__((noinline)) uint64_t payload_mix(uint64_t h)
+{
+    h ^= h >> 29;
+    return h * 0xBF58476D1CE4E5B9ull;
+}
+
+extern "C" CRYPT_FUNC __attribute__((noinline)) uint64_t payload_compute(uint64_t seed)
+{
+    uint64_t h = seed;
+    for (int i = 0; i < 8; i++) {
+        h = payload_mix(h + i);
+    }
+    return h;
+}
@@ -0,0 +1,329 @@
+#include "lazy_decrypt.h"
+#include "xor_kernel.h"
+#include "cache_sync.h"
+#include "decrypt_log.h"
+#include <cstdio>
+#include <cstring>
+#include <atomic>
+#include <new>
+#include <signal.h>
+#include <sched.h>
+#include <unistd.h>
+#include <errno.h>
+#include <sys/mman.h>
+
+// ===================== 内部状态 =====================
+namespace {
+
+struct LazyRange {
+    uintptr_t sec_start;        // 加密段起始（密钥流偏移基准）
+    uintptr_t sec_end;
+    uintptr_t lazy_start;       // 惰性页区间 [lazy_start, lazy_end)，页对齐
+    uintptr_t lazy_end;
+    size_t pages;
+    std::atomic<uint64_t>* claimed;     // 已被某线程认领解密
+    std::atomic<uint64_t>* ready;       // 已解密完成且恢复为 R-X
+    std::atomic<uint64_t>* failed;      // 改权限失败，已恢复为密文 + PROT_NONE，不再重试
+    LazyDecryptFn fn;
+    void* ctx;
+};
+
+// 整段异或（无加密表时）的密钥，每个区间一份
+struct LazyXorKey {
+    const uint8_t* key;
+    size_t key_len;
+};
+
+static LazyRange g_ranges[LAZY_MAX_RANGES];
+static LazyXorKey g_xor_keys[LAZY_MAX_RANGES];
+static std::atomic<size_t> g_range_count(0);
+static std::atomic<size_t> g_pages_decrypted(0);
+static std::atomic<size_t> g_bytes_decrypted(0);
+static std::atomic<size_t> g_faults(0);
+static struct sigaction g_prev_action;
+static bool g_handler_installed = false;
+static size_t g_page_size = 0;
+
+static void xor_range(uintptr_t start, size_t len, uintptr_t sec_start, void* ctx)
+{
+    const LazyXorKey* k = (const LazyXorKey*)ctx;
+    XorKernel::apply((uint8_t*)start, len, k->key, k->key_len, start - sec_start);
+}
+
+static inline bool page_ready(const LazyRange& r, size_t idx)
+{
+    return (r.ready[idx / 64].load(std::memory_order_acquire) >> (idx % 64)) & 1;
+}
+
+// 认领者失败：恢复密文与 PROT_NONE，置失败位后释放认领，等待者看到失败位后返回
+static void fail_page(LazyRange& r, size_t idx, uint8_t* page, bool written)
+{
+    const uint64_t bit = (uint64_t)1 << (idx % 64);
+    if (written) {
+        // 密钥流异或可逆：再解密一次即恢复密文，避免以后有人把明文再异或一遍
+        r.fn((uintptr_t)page, g_page_size, r.sec_start, r.ctx);
+    }
+    mprotect(page, g_page_size, PROT_NONE);
+    r.failed[idx / 64].fetch_or(bit, std::memory_order_release);
+    r.claimed[idx / 64].fetch_and(~bit, std::memory_order_release);
+}
+
+// 解密单页：返回true表示该页已可执行（本线程解密或等待其他线程完成）；
+// 返回false时该页保持密文 + PROT_NONE，之后访问该页的线程都会得到 false
+static bool decrypt_page(LazyRange& r, size_t idx)
+{
+    const uint64_t bit = (uint64_t)1 << (idx % 64);
+    if (r.ready[idx / 64].load(std::memory_order_acquire) & bit) {
+        return true;
+    }
+    if (r.failed[idx / 64].load(std::memory_order_acquire) & bit) {
+        return false;
+    }
+
+    const uint64_t prev = r.claimed[idx / 64].fetch_or(bit, std::memory_order_acq_rel);
+    if (prev & bit) {
+        // 其他线程正在解密该页：等待其发布完成或失败
+        for (;;) {
+            if (r.ready[idx / 64].load(std::memory_order_acquire) & bit) return true;
+            if (r.failed[idx / 64].load(std::memory_order_acquire) & bit) return false;
+            sched_yield();
+        }
+    }
+
+    uint8_t* page = (uint8_t*)(r.lazy_start + idx * g_page_size);
+    if (mprotect(page, g_page_size, PROT_READ | PROT_WRITE) != 0) {
+        fail_page(r, idx, page, false);
+        return false;
+    }
+    r.fn((uintptr_t)page, g_page_size, r.sec_start, r.ctx);
+    if (mprotect(page, g_page_size, PROT_READ | PROT_EXEC) != 0) {
+        fail_page(r, idx, page, true);
+        return false;
+    }
+    CacheSync::sync(page, g_page_size);
+
+    g_pages_decrypted.fetch_add(1, std::memory_order_relaxed);
+    g_bytes_decrypted.fetch_add(g_page_size, std::memory_order_relaxed);
+    r.ready[idx / 64].fetch_or(bit, std::memory_order_release);
+    return true;
+}
+
+// 非本模块负责的地址：交还给之前的处理函数
+static void chain_previous(int sig, siginfo_t* info, void* uctx)
+{
+    if (g_prev_action.sa_flags & SA_SIGINFO) {
+        if (g_prev_action.sa_sigaction) {
+            g_prev_action.sa_sigaction(sig, info, uctx);
+            return;
+        }
+    } else if (g_prev_action.sa_handler != SIG_DFL && g_prev_action.sa_handler != SIG_IGN) {
+        g_prev_action.sa_handler(sig);
+        return;
+    }
+    // 默认行为：恢复默认处理并返回，重新执行时按默认方式终止（保留正确的core）
+    signal(sig, SIG_DFL);
+}
+
+static void on_segv(int sig, siginfo_t* info, void* uctx)
+{
+    const int saved_errno = errno;
+    const uintptr_t addr = (uintptr_t)info->si_addr;
+    const size_t count = g_range_count.load(std::memory_order_acquire);
+
+    for (size_t i = 0; i < count; i++) {
+        LazyRange& r = g_ranges[i];
+        if (addr >= r.lazy_start && addr < r.lazy_end) {
+            g_faults.fetch_add(1, std::memory_order_relaxed);
+            if (decrypt_page(r, (addr - r.lazy_start) / g_page_size)) {
+                errno = saved_errno;
+                return;
+            }
+            break;
+        }
+    }
+
+    errno = saved_errno;
+    chain_previous(sig, info, uctx);
+}
+
+// 立即解密 [start, end)，按所在页临时设为RWX（这些页与普通代码共享，必须保持可执行）
+static bool decrypt_eager(const LazyRange& r, uintptr_t start, uintptr_t end)
+{
+    if (end <= start) return true;
+    const uintptr_t page_start = start & ~((uintptr_t)g_page_size - 1);
+    const uintptr_t page_end = (end + g_page_size - 1) & ~((uintptr_t)g_page_size - 1);
+
+    if (mprotect((void*)page_start, page_end - page_start, PROT_READ | PROT_WRITE | PROT_EXEC) != 0) {
+        DECRYPT_LOG_ERROR("[LazyDecryptor] Failed to set RWX at 0x%lx: %s\n", (unsigned long)page_start, strerror(errno));
+        return false;
+    }
+    r.fn(start, end - start, r.sec_start, r.ctx);
+    CacheSync::sync((uint8_t*)start, end - start);
+    if (mprotect((void*)page_start, page_end - page_start, PROT_READ | PROT_EXEC) != 0) {
+        DECRYPT_LOG_ERROR("[LazyDecryptor] Failed to restore RX at 0x%lx: %s\n", (unsigned long)page_start, strerror(errno));
+        return false;
+    }
+    g_bytes_decrypted.fetch_add(end - start, std::memory_order_relaxed);
+    return true;
+}
+
+static bool install_handler()
+{
+    if (g_handler_installed) return true;
+
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_sigaction = on_segv;
+    sa.sa_flags = SA_SIGINFO | SA_RESTART;
+    sigemptyset(&sa.sa_mask);
+    if (sigaction(SIGSEGV, &sa, &g_prev_action) != 0) {
+        DECRYPT_LOG_ERROR("[LazyDecryptor] sigaction failed: %s\n", strerror(errno));
+        return false;
+    }
+    g_handler_installed = true;
+    return true;
+}
+
+} // namespace
+
+// ===================== LazyDecryptor 实现 =====================
+bool LazyDecryptor::arm(uintptr_t sec_addr, size_t sec_size, const uint8_t* key, size_t key_len)
+{
+    if (!key || key_len == 0) return false;
+    const size_t slot = g_range_count.load(std::memory_order_relaxed);
+    if (slot >= LAZY_MAX_RANGES) {
+        DECRYPT_LOG_ERROR("[LazyDecryptor] Too many lazy ranges (max %d)\n", LAZY_MAX_RANGES);
+        return false;
+    }
+    g_xor_keys[slot].key = key;
+    g_xor_keys[slot].key_len = key_len;
+
+    // 预热异或内核的分发状态，避免在信号上下文里首次初始化
+    uint8_t warm[128] = {0};
+    XorKernel::apply(warm, sizeof(warm), key, key_len);
+    return arm(sec_addr, sec_size, xor_range, &g_xor_keys[slot]);
+}
+
+bool LazyDecryptor::arm(uintptr_t sec_addr, size_t sec_size, LazyDecryptFn fn, void* ctx)
+{
+    if (sec_addr == 0 || sec_size == 0 || !fn) return false;
+
+    if (g_page_size == 0) {
+        g_page_size = (size_t)sysconf(_SC_PAGESIZE);
+    }
+    if (g_range_count.load(std::memory_order_relaxed) >= LAZY_MAX_RANGES) {
+        DECRYPT_LOG_ERROR("[LazyDecryptor] Too many lazy ranges (max %d)\n", LAZY_MAX_RANGES);
+        return false;
+    }
+
+    const uintptr_t sec_end = sec_addr + sec_size;
+    const uintptr_t lazy_start = (sec_addr + g_page_size - 1) & ~((uintptr_t)g_page_size - 1);
+    const uintptr_t lazy_end = sec_end & ~((uintptr_t)g_page_size - 1);
+
+    LazyRange& r = g_ranges[g_range_count.load(std::memory_order_relaxed)];
+    r.sec_start = sec_addr;
+    r.sec_end = sec_end;
+    r.lazy_start = lazy_start;
+    r.lazy_end = lazy_end;
+    r.pages = lazy_end > lazy_start ? (lazy_end - lazy_start) / g_page_size : 0;
+    r.fn = fn;
+    r.ctx = ctx;
+
+    // 段内没有完整页：退化为立即解密，区间照样发布（没有惰性页，缺页处理不会匹配），供 armed() 查询
+    if (lazy_end <= lazy_start) {
+        if (!decrypt_eager(r, sec_addr, sec_end)) return false;
+        g_range_count.fetch_add(1, std::memory_order_release);
+        return true;
+    }
+
+    // 首尾不满一页的部分立即解密
+    if (!decrypt_eager(r, sec_addr, lazy_start) ||
+        !decrypt_eager(r, lazy_end, sec_end)) {
+        return false;
+    }
+
+    // 预热信号处理函数里用到的函数级静态变量，避免在信号上下文里首次初始化
+    CacheSync::current();
+
+    const size_t words = (r.pages + 63) / 64;
+    void* bitmap = mmap(nullptr, words * 3 * sizeof(uint64_t), PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (bitmap == MAP_FAILED) {
+        DECRYPT_LOG_ERROR("[LazyDecryptor] Bitmap alloc failed: %s\n", strerror(errno));
+        return false;
+    }
+    r.claimed = new (bitmap) std::atomic<uint64_t>[words];
+    r.ready = new ((std::atomic<uint64_t>*)bitmap + words) std::atomic<uint64_t>[words];
+    r.failed = new ((std::atomic<uint64_t>*)bitmap + 2 * words) std::atomic<uint64_t>[words];
+    for (size_t i = 0; i < words; i++) {
+        r.claimed[i].store(0, std::memory_order_relaxed);
+        r.ready[i].store(0, std::memory_order_relaxed);
+        r.failed[i].store(0, std::memory_order_relaxed);
+    }
+
+    if (!install_handler()) {
+        munmap(bitmap, words * 3 * sizeof(uint64_t));
+        return false;
+    }
+
+    // 先发布区间再撤销访问权限，保证任何缺页都能找到对应区间
+    g_range_count.fetch_add(1, std::memory_order_release);
+    if (mprotect((void*)lazy_start, lazy_end - lazy_start, PROT_NONE) != 0) {
+        DECRYPT_LOG_ERROR("[LazyDecryptor] Failed to set PROT_NONE at 0x%lx: %s\n",
+                          (unsigned long)lazy_start, strerror(errno));
+        return false;
+    }
+
+    DECRYPT_LOG_INFO("[LazyDecryptor] Armed 0x%lx-0x%lx (%zu lazy pages)\n",
+                     (unsigned long)lazy_start, (unsigned long)lazy_end, r.pages);
+    return true;
+}
+
+bool LazyDecryptor::decryptAll()
+{
+    bool ok = true;
+    const size_t count = g_range_count.load(std::memory_order_acquire);
+    for (size_t i = 0; i < count; i++) {
+        LazyRange& r = g_ranges[i];
+        for (size_t idx = 0; idx < r.pages; idx++) {
+            if (!page_ready(r, idx) && !decrypt_page(r, idx)) {
+                ok = false;
+            }
+        }
+    }
+    return ok;
+}
+
+bool LazyDecryptor::armed(uintptr_t addr)
+{
+    const size_t count = g_range_count.load(std::memory_order_acquire);
+    for (size_t i = 0; i < count; i++) {
+        if (addr >= g_ranges[i].sec_start && addr < g_ranges[i].sec_end) return true;
+    }
+    return false;
+}
+
+size_t LazyDecryptor::pagesTotal()
+{
+    size_t total = 0;
+    const size_t count = g_range_count.load(std::memory_order_acquire);
+    for (size_t i = 0; i < count; i++) {
+        total += g_ranges[i].pages;
+    }
+    return total;
+}
+
+size_t LazyDecryptor::pagesDecrypted()
+{
+    return g_pages_decrypted.load(std::memory_order_relaxed);
+}
+
+size_t LazyDecryptor::bytesDecrypted()
+{
+    return g_bytes_decrypted.load(std::memory_order_relaxed);
+}
+
+size_t LazyDecryptor::faultsHandled()
+{
+    return g_faults.load(std::memory_order_relaxed);
+}
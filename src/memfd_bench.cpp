@@ -0,0 +1,156 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+// ===================== 整段解密引擎对比：mprotect RWX 原地解密 vs memfd 封印换入 =====================
+// 复用 decrypt_bench 的被测镜像（.encrypt_text 4 KB ~ 256 MB），每次运行 fork + exec 一个新进程，
+// 参数 mprotect / memfd 选择引擎；镜像文件先读入页缓存（热缓存）。
+// 报告中位数：decrypt() 耗时、decrypt() 期间的缺页、解密后逐页读载荷时的缺页，
+// 以及整个进程的缺页（wait4）与从 fork 到退出的耗时。
+// 用法：memfd_bench [runs] [max_mb]
+
+#ifndef DECRYPT_BENCH_IMAGE_DIR
+#define DECRYPT_BENCH_IMAGE_DIR "."
+#endif
+#ifndef DECRYPT_BENCH_SIZES
+#define DECRYPT_BENCH_SIZES "4096"
+#endif
+
+struct Sample {
+    uint64_t decrypt_ns;
+    uint64_t decrypt_faults;
+    uint64_t touch_faults;
+    uint64_t process_faults;
+    uint64_t process_ns;
+};
+
+static inline uint64_t now_ns()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static void warm_cache(const std::string& path)
+{
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) return;
+    static char buf[1 << 16];
+    while (read(fd, buf, sizeof(buf)) > 0) {
+    }
+    close(fd);
+}
+
+// 运行一次被测镜像：结果行经管道（子进程 fd 3）读回，镜像的 stdout 日志丢弃
+static bool run_image(const std::string& path, const char* engine, Sample& s)
+{
+    int fds[2];
+    if (pipe(fds) != 0) return false;
+    fflush(stdout);
+    const uint64_t t0 = now_ns();
+    const pid_t pid = fork();
+    if (pid == 0) {
+        close(fds[0]);
+        if (dup2(fds[1], 3) < 0) _exit(127);
+        const int devnull = open("/dev/null", O_WRONLY);
+        if (devnull >= 0) dup2(devnull, STDOUT_FILENO);
+        execl(path.c_str(), path.c_str(), engine, (char*)nullptr);
+        _exit(127);
+    }
+    close(fds[1]);
+    char line[512];
+    size_t len = 0;
+    ssize_t n;
+    while (len < sizeof(line) - 1 && (n = read(fds[0], line + len, sizeof(line) - 1 - len)) > 0) {
+        len += (size_t)n;
+    }
+    line[len] = '\0';
+    close(fds[0]);
+    int status = 0;
+    struct rusage ru;
+    memset(&ru, 0, sizeof(ru));
+    wait4(pid, &status, 0, &ru);
+    s.process_ns = now_ns() - t0;
+    s.process_faults = (uint64_t)ru.ru_minflt;
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) return false;
+
+    // <ok>,<total>,<8 个阶段>,<decrypt_faults>,<touch_faults>
+    char* p = line;
+    if (strtol(p, &p, 10) != 1 || *p != ',') return false;
+    s.decrypt_ns = strtoull(p + 1, &p, 10);
+    for (int i = 0; i < 8; i++) {
+        if (*p != ',') return false;
+        strtoull(p + 1, &p, 10);
+    }
+    if (*p != ',') return false;
+    s.decrypt_faults = strtoull(p + 1, &p, 10);
+    if (*p != ',') return false;
+    s.touch_faults = strtoull(p + 1, &p, 10);
+    return true;
+}
+
+static uint64_t median(std::vector<uint64_t> v)
+{
+    std::sort(v.begin(), v.end());
+    return v[(v.size() - 1) / 2];
+}
+
+int main(int argc, char* argv[])
+{
+    const size_t runs = argc > 1 ? strtoul(argv[1], nullptr, 10) : 11;
+    const size_t max_bytes = argc > 2 ? (size_t)strtoull(argv[2], nullptr, 10) << 20 : (size_t)-1;
+    if (runs == 0) {
+        fprintf(stderr, "usage: %s [runs] [max_mb]\n", argv[0]);
+        return 1;
+    }
+
+    std::vector<size_t> sizes;
+    for (const char* p = DECRYPT_BENCH_SIZES; *p;) {
+        char* end = nullptr;
+        const size_t size = strtoull(p, &end, 10);
+        if (size && size <= max_bytes) sizes.push_back(size);
+        p = (*end == ',') ? end + 1 : end;
+    }
+
+    printf("%-12s %-9s %12s %14s %12s %14s %12s\n", "size_bytes", "engine", "decrypt(ms)", "decrypt_faults",
+           "touch_faults", "process_faults", "process(ms)");
+    for (size_t size : sizes) {
+        const std::string path = std::string(DECRYPT_BENCH_IMAGE_DIR) + "/decrypt_bench_image_" + std::to_string(size);
+        if (access(path.c_str(), X_OK) != 0) {
+            fprintf(stderr, "[memfd_bench] Missing image %s\n", path.c_str());
+            return 1;
+        }
+        warm_cache(path);
+        for (const char* engine : {"mprotect", "memfd"}) {
+            Sample s;
+            if (!run_image(path, engine, s)) {    // 预热
+                fprintf(stderr, "[memfd_bench] %s with %s failed (decrypt or payload check)\n", path.c_str(), engine);
+                return 1;
+            }
+            std::vector<uint64_t> decrypt_ns, decrypt_faults, touch_faults, process_faults, process_ns;
+            for (size_t i = 0; i < runs; i++) {
+                if (!run_image(path, engine, s)) {
+                    fprintf(stderr, "[memfd_bench] Run %zu of %s with %s failed\n", i, path.c_str(), engine);
+                    return 1;
+                }
+                decrypt_ns.push_back(s.decrypt_ns);
+                decrypt_faults.push_back(s.decrypt_faults);
+                touch_faults.push_back(s.touch_faults);
+                process_faults.push_back(s.process_faults);
+                process_ns.push_back(s.process_ns);
+            }
+            printf("%-12zu %-9s %12.3f %14llu %12llu %14llu %12.3f\n", size, engine, median(decrypt_ns) / 1e6,
+                   (unsigned long long)median(decrypt_faults), (unsigned long long)median(touch_faults),
+                   (unsigned long long)median(process_faults), median(process_ns) / 1e6);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,53 @@
+#include "memfd_text.h"
+#include "decrypt_log.h"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#ifndef MFD_EXEC
+#define MFD_EXEC 0x0010U    // Linux 6.3+：vm.memfd_noexec=1 时须显式声明可执行
+#endif
+
+MemfdText::~MemfdText()
+{
+    if (m_fd >= 0) close(m_fd);
+}
+
+bool MemfdText::create(size_t len)
+{
+    m_fd = memfd_create("encrypt_text", MFD_CLOEXEC | MFD_ALLOW_SEALING | MFD_EXEC);
+    if (m_fd < 0 && errno == EINVAL) {
+        // 旧内核不认识 MFD_EXEC
+        m_fd = memfd_create("encrypt_text", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    }
+    if (m_fd < 0) {
+        DECRYPT_LOG_ERROR("[MemfdText] memfd_create failed: %s\n", strerror(errno));
+        return false;
+    }
+    if (ftruncate(m_fd, (off_t)len) != 0) {
+        DECRYPT_LOG_ERROR("[MemfdText] ftruncate %zu bytes failed: %s\n", len, strerror(errno));
+        return false;
+    }
+    m_len = len;
+    return true;
+}
+
+bool MemfdText::commit(uintptr_t addr)
+{
+    if (m_fd < 0) return false;
+    if (fcntl(m_fd, F_ADD_SEALS, F_SEAL_WRITE | F_SEAL_GROW | F_SEAL_SHRINK | F_SEAL_SEAL) != 0) {
+        DECRYPT_LOG_ERROR("[MemfdText] Sealing failed: %s\n", strerror(errno));
+        return false;
+    }
+    // 一次系统调用原子替换原加密页；预先建立页表，执行时不再缺页
+    void* p = mmap((void*)addr, m_len, PROT_READ | PROT_EXEC, MAP_SHARED | MAP_FIXED | MAP_POPULATE, m_fd, 0);
+    if (p == MAP_FAILED) {
+        DECRYPT_LOG_ERROR("[MemfdText] MAP_FIXED at 0x%lx failed: %s\n", (unsigned long)addr, strerror(errno));
+        return false;
+    }
+    close(m_fd);
+    m_fd = -1;
+    return true;
+}
@@ -0,0 +1,126 @@
+#include "parallel_decrypt.h"
+#include "xor_kernel.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <sys/mman.h>
+#include <unistd.h>
+
+// ===================== 多核分块解密扩展性基准 =====================
+// 1) 校验：奇数地址、非整页大小、多目标时分块解密结果与整段单线程异或一致
+// 2) 1..N 线程下解密单个大段 / 同时解密4个目标的吞吐量
+// 用法：parallel_bench [size_MB] [max_threads]
+
+static const uint8_t BENCH_KEY[] = {0x12, 0x34, 0x56, 0x78, 0x90, 0xAB, 0xCD, 0xEF};
+
+static inline uint64_t now_ns()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+static uint64_t median(std::vector<uint64_t>& v)
+{
+    std::sort(v.begin(), v.end());
+    return v[v.size() / 2];
+}
+
+static void xor_chunk(uintptr_t start, size_t len, uintptr_t sec_start, void*)
+{
+    XorKernel::apply((uint8_t*)start, len, BENCH_KEY, sizeof(BENCH_KEY), start - sec_start);
+}
+
+static bool verify(size_t max_threads)
+{
+    const size_t len = ((size_t)9 << 20) + 4093;
+    std::vector<uint8_t> src(len + 64), out(len + 64), ref(len + 64);
+    for (size_t i = 0; i < src.size(); i++) {
+        src[i] = (uint8_t)(i * 167 + 13);
+    }
+
+    ParallelDecryptor::setThreshold(0);
+    ParallelDecryptor::setChunkSize(64 << 10);
+    for (size_t threads = 1; threads <= max_threads; threads++) {
+        ParallelDecryptor::setThreads(threads);
+        for (size_t split = 1; split <= 3; split++) {
+            // 从奇数地址开始，切成 split 个相邻目标，每个目标的密钥流从自身起点算起
+            out = src;
+            ref = src;
+            std::vector<DecryptTarget> targets;
+            size_t off = 3;
+            for (size_t s = 0; s < split; s++) {
+                const size_t part = (s + 1 == split) ? len - (off - 3) : len / split;
+                targets.push_back(DecryptTarget{(uintptr_t)&out[off], part, xor_chunk, nullptr});
+                XorKernel::scalarReference(&ref[off], part, BENCH_KEY, sizeof(BENCH_KEY));
+                off += part;
+            }
+            if (!ParallelDecryptor::run(targets.data(), targets.size()) || out != ref) {
+                printf("[parallel_bench] verify FAILED: threads=%zu targets=%zu\n", threads, split);
+                return false;
+            }
+        }
+    }
+    printf("[parallel_bench] verify OK (1..%zu threads, 1..3 targets)\n", max_threads);
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    size_t size = (size_t)64 << 20;
+    if (argc >= 2) {
+        size = std::max<size_t>(1, strtoull(argv[1], nullptr, 10)) << 20;  // 单位MB
+    }
+    const long online = sysconf(_SC_NPROCESSORS_ONLN);
+    size_t max_threads = (size_t)std::max<long>(online, 1);
+    if (argc >= 3) {
+        max_threads = std::min<size_t>(std::max(1, atoi(argv[2])), PARALLEL_MAX_THREADS);
+    }
+
+    printf("[parallel_bench] online CPUs: %ld, xor kernel: %s\n", online, XorKernel::isaName(XorKernel::activeIsa()));
+    if (!verify(max_threads)) {
+        return 1;
+    }
+
+    uint8_t* region = (uint8_t*)mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (region == MAP_FAILED) {
+        perror("[parallel_bench] mmap");
+        return 1;
+    }
+    memset(region, 0x5A, size);
+
+    ParallelDecryptor::setThreshold(0);
+    ParallelDecryptor::setChunkSize(PARALLEL_DEFAULT_CHUNK);
+
+    printf("\n%-8s %-8s %12s %10s %10s %8s\n", "threads", "targets", "time(us)", "GB/s", "speedup", "steals");
+    for (size_t targets_n : {(size_t)1, (size_t)4}) {
+        std::vector<DecryptTarget> targets;
+        for (size_t t = 0; t < targets_n; t++) {
+            targets.push_back(DecryptTarget{(uintptr_t)region + size / targets_n * t, size / targets_n, xor_chunk, nullptr});
+        }
+
+        double base_us = 0;
+        for (size_t threads = 1; threads <= max_threads; threads++) {
+            ParallelDecryptor::setThreads(threads);
+            std::vector<uint64_t> samples;
+            size_t steals = 0;
+            for (int r = 0; r < 7; r++) {
+                const uint64_t t0 = now_ns();
+                ParallelDecryptor::run(targets.data(), targets.size());
+                samples.push_back(now_ns() - t0);
+                steals += ParallelDecryptor::lastSteals();
+            }
+            const double us = median(samples) / 1000.0;
+            if (threads == 1) base_us = us;
+            printf("%-8zu %-8zu %12.1f %10.2f %9.2fx %8zu\n", threads, targets_n, us,
+                   (double)size / (us * 1000.0), base_us / us, steals / 7);
+        }
+    }
+
+    munmap(region, size);
+    return 0;
+}
@@ -0,0 +1,226 @@
+#include "parallel_decrypt.h"
+#include "decrypt_log.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <system_error>
+#include <thread>
+#include <vector>
+#include <sched.h>
+#include <unistd.h>
+
+// ===================== 内部状态 =====================
+namespace {
+
+struct Chunk {
+    uintptr_t start;
+    size_t len;
+    uint32_t target;
+};
+
+// 打包的待处理区间：高32位 lo，低32位 hi，块下标 [lo, hi)
+static inline uint64_t pack_range(uint32_t lo, uint32_t hi) { return ((uint64_t)lo << 32) | hi; }
+static inline uint32_t range_lo(uint64_t r) { return (uint32_t)(r >> 32); }
+static inline uint32_t range_hi(uint64_t r) { return (uint32_t)r; }
+
+struct alignas(64) WorkerQueue {
+    std::atomic<uint64_t> range;
+};
+
+struct RunState {
+    const DecryptTarget* targets;
+    const Chunk* chunks;
+    WorkerQueue* queues;
+    size_t workers;
+    std::atomic<size_t> steals;
+};
+
+static size_t g_threads = 0;
+static size_t g_threshold = PARALLEL_DEFAULT_THRESHOLD;
+static size_t g_chunk_size = PARALLEL_DEFAULT_CHUNK;
+static size_t g_last_threads = 0;
+static size_t g_last_steals = 0;
+
+// 本线程从 lo 端取一块
+static bool pop_local(WorkerQueue& q, uint32_t& idx)
+{
+    uint64_t r = q.range.load(std::memory_order_acquire);
+    while (range_lo(r) < range_hi(r)) {
+        if (q.range.compare_exchange_weak(r, pack_range(range_lo(r) + 1, range_hi(r)),
+                                          std::memory_order_acq_rel)) {
+            idx = range_lo(r);
+            return true;
+        }
+    }
+    return false;
+}
+
+// 从剩余最多的线程的 hi 端偷走一半放入自己的队列
+static bool steal(RunState& st, size_t self)
+{
+    for (;;) {
+        size_t victim = st.workers;
+        uint32_t best = 0;
+        for (size_t i = 0; i < st.workers; i++) {
+            if (i == self) continue;
+            const uint64_t r = st.queues[i].range.load(std::memory_order_acquire);
+            const uint32_t left = range_hi(r) - range_lo(r);
+            if (range_hi(r) > range_lo(r) && left > best) {
+                best = left;
+                victim = i;
+            }
+        }
+        if (victim == st.workers) return false;
+
+        uint64_t r = st.queues[victim].range.load(std::memory_order_acquire);
+        const uint32_t lo = range_lo(r), hi = range_hi(r);
+        if (hi <= lo) continue;
+        const uint32_t take = (hi - lo + 1) / 2;
+        if (st.queues[victim].range.compare_exchange_strong(r, pack_range(lo, hi - take),
+                                                            std::memory_order_acq_rel)) {
+            // 自己的队列此时为空，其他线程不会成功修改它
+            st.queues[self].range.store(pack_range(hi - take, hi), std::memory_order_release);
+            st.steals.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+}
+
+static void worker_loop(RunState& st, size_t self)
+{
+    for (;;) {
+        uint32_t idx = 0;
+        while (pop_local(st.queues[self], idx)) {
+            const Chunk& c = st.chunks[idx];
+            const DecryptTarget& t = st.targets[c.target];
+            t.fn(c.start, c.len, t.sec_addr, t.ctx);
+        }
+        if (!steal(st, self)) return;
+    }
+}
+
+} // namespace
+
+// ===================== ParallelDecryptor 实现 =====================
+bool ParallelDecryptor::run(const DecryptTarget* targets, size_t count)
+{
+    if (!targets || count == 0) return false;
+
+    size_t total = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (!targets[i].fn || (targets[i].sec_addr == 0 && targets[i].sec_size != 0)) return false;
+        total += targets[i].sec_size;
+    }
+
+    // 低于阈值时不必查询 CPU 数
+    size_t workers = total < g_threshold ? 1 : threads();
+    g_last_steals = 0;
+    if (workers <= 1) {
+        for (size_t i = 0; i < count; i++) {
+            if (targets[i].sec_size) {
+                targets[i].fn(targets[i].sec_addr, targets[i].sec_size, targets[i].sec_addr, targets[i].ctx);
+            }
+        }
+        g_last_threads = 1;
+        return true;
+    }
+
+    // 按块大小（页的整数倍）对齐的地址边界切块，首尾块可能不满；块之间不共享页
+    const size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+    const size_t chunk = std::max(page_size, g_chunk_size & ~(page_size - 1));
+    std::vector<Chunk> chunks;
+    chunks.reserve(total / chunk + 2 * count);
+    for (size_t i = 0; i < count; i++) {
+        uintptr_t p = targets[i].sec_addr;
+        const uintptr_t end = p + targets[i].sec_size;
+        while (p < end) {
+            const uintptr_t next = std::min<uintptr_t>(end, (p / chunk + 1) * chunk);
+            chunks.push_back(Chunk{p, (size_t)(next - p), (uint32_t)i});
+            p = next;
+        }
+    }
+
+    workers = std::min(workers, chunks.size());
+    std::vector<WorkerQueue> queues(workers);
+    for (size_t w = 0; w < workers; w++) {
+        const uint32_t lo = (uint32_t)(chunks.size() * w / workers);
+        const uint32_t hi = (uint32_t)(chunks.size() * (w + 1) / workers);
+        queues[w].range.store(pack_range(lo, hi), std::memory_order_relaxed);
+    }
+
+    RunState st;
+    st.targets = targets;
+    st.chunks = chunks.data();
+    st.queues = queues.data();
+    st.workers = workers;
+    st.steals.store(0, std::memory_order_relaxed);
+
+    std::vector<std::thread> pool;
+    pool.reserve(workers - 1);
+    for (size_t w = 1; w < workers; w++) {
+        try {
+            pool.emplace_back(worker_loop, std::ref(st), w);
+        } catch (const std::system_error& e) {
+            // 建线程失败：剩余工作由已有线程偷取完成
+            DECRYPT_LOG_ERROR("[ParallelDecryptor] Thread create failed: %s\n", e.what());
+            break;
+        }
+    }
+    worker_loop(st, 0);
+    for (std::thread& t : pool) {
+        t.join();
+    }
+
+    g_last_threads = pool.size() + 1;
+    g_last_steals = st.steals.load(std::memory_order_relaxed);
+    return true;
+}
+
+void ParallelDecryptor::setThreads(size_t threads)
+{
+    g_threads = std::min<size_t>(threads, PARALLEL_MAX_THREADS);
+}
+
+size_t ParallelDecryptor::threads()
+{
+    if (g_threads) return g_threads;
+    // 按本进程可用的 CPU（亲和性掩码）计，一次 sched_getaffinity；
+    // sysconf(_SC_NPROCESSORS_ONLN) 每次都要 open/read/close /sys/devices/system/cpu/online
+    static const long online = [] {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        return sched_getaffinity(0, sizeof(set), &set) == 0 ? (long)CPU_COUNT(&set) : sysconf(_SC_NPROCESSORS_ONLN);
+    }();
+    return (size_t)std::min<long>(std::max<long>(online, 1), PARALLEL_MAX_THREADS);
+}
+
+void ParallelDecryptor::setThreshold(size_t bytes)
+{
+    g_threshold = bytes;
+}
+
+size_t ParallelDecryptor::threshold()
+{
+    return g_threshold;
+}
+
+void ParallelDecryptor::setChunkSize(size_t bytes)
+{
+    g_chunk_size = bytes;
+}
+
+size_t ParallelDecryptor::chunkSize()
+{
+    return g_chunk_size;
+}
+
+size_t ParallelDecryptor::lastThreads()
+{
+    return g_last_threads;
+}
+
+size_t ParallelDecryptor::lastSteals()
+{
+    return g_last_steals;
+}
@@ -0,0 +1,211 @@
+#include "decrypt_registry.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+
+// ===================== 多目标注册表基准 =====================
+// 把加密插件 SO 复制成 N 份并全部 dlopen，其中 M 份注册为解密目标：
+//   legacy   ：旧单目标方式，每个目标一次 dl_iterate_phdr + strstr(路径, 名字)
+//   registry ：DecryptRegistry 一次遍历按 link_map 身份解析全部目标
+// 之后 decryptAll() 一次解密全部目标并校验；最后用 dlmopen 在新命名空间加载同一路径，
+// 验证两份副本是不同的目标（strstr 无法区分）。
+// 用法：registry_bench [libs] [targets] [plugin.so]
+
+#ifndef REGISTRY_BENCH_PLUGIN
+#define REGISTRY_BENCH_PLUGIN "libregistry_bench_plugin.so"
+#endif
+
+typedef uint64_t (*PluginComputeFn)(uint64_t);
+
+static inline uint64_t now_ns()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+// 与插件中加密函数相同的明文实现
+static uint64_t reference_compute(uint64_t seed)
+{
+    uint64_t h = seed ^ 0x9E3779B97F4A7C15ull;
+    for (int i = 0; i < 16; i++) {
+        h ^= h >> 33;
+        h *= 0xFF51AFD7ED558CCDull;
+    }
+    return h;
+}
+
+static bool read_file(const char* path, std::vector<char>& data)
+{
+    FILE* fp = fopen(path, "rb");
+    if (!fp) return false;
+    fseek(fp, 0, SEEK_END);
+    data.resize(ftell(fp));
+    fseek(fp, 0, SEEK_SET);
+    const bool ok = fread(data.data(), 1, data.size(), fp) == data.size();
+    fclose(fp);
+    return ok;
+}
+
+static bool write_file(const std::string& path, const std::vector<char>& data)
+{
+    const int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0755);
+    if (fd < 0) return false;
+    const bool ok = write(fd, data.data(), data.size()) == (ssize_t)data.size();
+    close(fd);
+    return ok;
+}
+
+// ========== 旧方式：按名字子串查找单个目标 ==========
+struct LegacyLookup {
+    const char* name;
+    uintptr_t base;
+    bool found;
+};
+
+static int legacy_callback(struct dl_phdr_info* info, size_t, void* data)
+{
+    LegacyLookup* lookup = (LegacyLookup*)data;
+    if (info->dlpi_name && strstr(info->dlpi_name, lookup->name)) {
+        lookup->base = info->dlpi_addr;
+        lookup->found = true;
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[])
+{
+    const size_t lib_count = argc > 1 ? strtoul(argv[1], nullptr, 10) : 1000;
+    const size_t target_count = std::min(lib_count, argc > 2 ? (size_t)strtoul(argv[2], nullptr, 10) : (size_t)100);
+    const char* plugin = argc > 3 ? argv[3] : REGISTRY_BENCH_PLUGIN;
+    if (lib_count == 0 || target_count == 0) {
+        fprintf(stderr, "usage: %s [libs] [targets] [plugin.so]\n", argv[0]);
+        return 1;
+    }
+
+    std::vector<char> image;
+    if (!read_file(plugin, image)) {
+        fprintf(stderr, "[registry_bench] Cannot read plugin %s\n", plugin);
+        return 1;
+    }
+    char dir_tmpl[] = "/tmp/registry_bench_XXXXXX";
+    if (!mkdtemp(dir_tmpl)) {
+        perror("mkdtemp");
+        return 1;
+    }
+    const std::string dir = dir_tmpl;
+
+    // 1. 复制并加载 N 个插件
+    std::vector<std::string> paths(lib_count);
+    std::vector<void*> handles(lib_count);
+    uint64_t t0 = now_ns();
+    for (size_t i = 0; i < lib_count; i++) {
+        paths[i] = dir + "/libplugin_" + std::to_string(i) + ".so";
+        if (!write_file(paths[i], image) || !(handles[i] = dlopen(paths[i].c_str(), RTLD_NOW | RTLD_LOCAL))) {
+            fprintf(stderr, "[registry_bench] Failed to load %s: %s\n", paths[i].c_str(), dlerror());
+            return 1;
+        }
+    }
+    printf("loaded %zu plugin copies in %.1f ms\n", lib_count, (now_ns() - t0) / 1e6);
+
+    // 目标均匀分布在加载顺序中
+    std::vector<size_t> target_lib(target_count);
+    std::vector<std::string> target_names(target_count);
+    for (size_t i = 0; i < target_count; i++) {
+        target_lib[i] = i * lib_count / target_count;
+        target_names[i] = "/libplugin_" + std::to_string(target_lib[i]) + ".so";
+    }
+
+    // 2. 旧方式：每个目标遍历一次
+    t0 = now_ns();
+    size_t legacy_found = 0;
+    for (size_t i = 0; i < target_count; i++) {
+        LegacyLookup lookup = {target_names[i].c_str(), 0, false};
+        dl_iterate_phdr(legacy_callback, &lookup);
+        legacy_found += lookup.found;
+    }
+    const uint64_t legacy_ns = now_ns() - t0;
+
+    // 3. 注册表：一次遍历
+    DecryptRegistry& registry = DecryptRegistry::instance();
+    std::vector<int> ids(target_count);
+    t0 = now_ns();
+    for (size_t i = 0; i < target_count; i++) {
+        ids[i] = registry.addHandle(handles[target_lib[i]]);
+    }
+    const uint64_t add_ns = now_ns() - t0;
+    t0 = now_ns();
+    const size_t resolved = registry.resolve();
+    const uint64_t resolve_ns = now_ns() - t0;
+
+    printf("\nresolve %zu targets among %zu loaded libraries\n", target_count, lib_count);
+    printf("  %-10s %10.1f us  found %zu\n", "legacy", legacy_ns / 1e3, legacy_found);
+    printf("  %-10s %10.1f us  found %zu  (+%.1f us register)\n", "registry", resolve_ns / 1e3, resolved, add_ns / 1e3);
+
+    // 4. 一次解密全部目标并校验
+    t0 = now_ns();
+    const bool decrypt_ok = registry.decryptAll();
+    const uint64_t decrypt_ns = now_ns() - t0;
+
+    bool ok = decrypt_ok && resolved == target_count;
+    for (size_t i = 0; i < target_count; i++) {
+        const TargetImage* t = registry.target(ids[i]);
+        PluginComputeFn fn = (PluginComputeFn)dlsym(handles[target_lib[i]], "plugin_compute");
+        if (!t || t->state != TARGET_DECRYPTED || !fn || fn(i) != reference_compute(i)) {
+            fprintf(stderr, "[registry_bench] target %zu (%s): %s\n", i, paths[target_lib[i]].c_str(),
+                    t ? DecryptRegistry::stateName(t->state) : "missing");
+            ok = false;
+        }
+    }
+    // 未注册的副本应保持加密：与已解密副本的函数字节不同
+    if (target_count < lib_count) {
+        const size_t other = target_lib[0] + 1;
+        const void* plain = dlsym(handles[target_lib[0]], "plugin_compute");
+        const void* cipher = dlsym(handles[other], "plugin_compute");
+        if (!plain || !cipher || memcmp(plain, cipher, 16) == 0) {
+            fprintf(stderr, "[registry_bench] unregistered copy %zu was modified\n", other);
+            ok = false;
+        }
+    }
+    printf("decryptAll %zu targets: %.2f ms, verify %s\n", target_count, decrypt_ns / 1e6, ok ? "OK" : "FAILED");
+
+    // 5. dlmopen：同一路径在新命名空间中的副本是独立目标
+    void* ns_handle = dlmopen(LM_ID_NEWLM, paths[target_lib[0]].c_str(), RTLD_NOW);
+    if (ns_handle) {
+        const int ns_id = registry.addHandle(ns_handle);
+        const bool ns_ok = registry.decryptAll();
+        PluginComputeFn fn = (PluginComputeFn)dlsym(ns_handle, "plugin_compute");
+        const TargetImage* t = registry.target(ns_id);
+        const bool distinct = ns_id != ids[0] && t && t->image.load_bias != registry.target(ids[0])->image.load_bias;
+        const bool ns_verified = ns_ok && distinct && fn && fn(7) == reference_compute(7);
+
+        LegacyLookup lookup = {target_names[0].c_str(), 0, false};
+        dl_iterate_phdr(legacy_callback, &lookup);
+        printf("dlmopen copy: target %d (%s), verify %s; legacy strstr picks %s copy\n",
+               ns_id, t ? DecryptRegistry::stateName(t->state) : "missing", ns_verified ? "OK" : "FAILED",
+               lookup.base == t->image.load_bias ? "the namespace" : "the base-namespace");
+        ok = ok && ns_verified;
+        registry.remove(ns_id);
+        dlclose(ns_handle);
+    } else {
+        printf("dlmopen unavailable: %s\n", dlerror());
+    }
+
+    // 注册表对目标持有引用：先 remove() 释放，dlclose 后镜像才会卸载
+    for (size_t i = 0; i < target_count; i++) {
+        registry.remove(ids[i]);
+    }
+    for (size_t i = 0; i < lib_count; i++) {
+        dlclose(handles[i]);
+        unlink(paths[i].c_str());
+    }
+    rmdir(dir.c_str());
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,29 @@
+#include "decryptor_linux.h"
+
+// ========== registry_bench 插件载荷（构建时由 encrypt_tool 加密后链接为SO） ==========
+// registry_bench 把它复制成上千份再 dlopen，其中一部分注册为解密目标
+
+__asm__(".pushsection .encrypt_text,\"ax\",@progbits\n"
+        ".p2align 4\n"
+        ".type plugin_cold,@function\n"
+        "plugin_cold:\n"
+        ".fill 32768,1,0x90\n"
+        "ret\n"
+        ".size plugin_cold,.-plugin_cold\n"
+        ".popsection\n");
+
+// 未加密的辅助函数：加密函数对它的调用会留下重定位空洞
+static __attribute__((noinline)) uint64_t plugin_mix(uint64_t h)
+{
+    h ^= h >> 33;
+    return h * 0xFF51AFD7ED558CCDull;
+}
+
+extern "C" CRYPT_FUNC __attribute__((noinline)) uint64_t plugin_compute(uint64_t seed)
+{
+    uint64_t h = seed ^ 0x9E3779B97F4A7C15ull;
+    for (int i = 0; i < 16; i++) {
+        h = plugin_mix(h);
+    }
+    return h;
+}
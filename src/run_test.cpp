@@ -4,6 +4,7 @@
 #include <chrono>
 #include <csignal>
 #include <atomic>
+#include <string>
 
 static std::atomic<bool> g_running(true);
 
@@ -11,11 +12,24 @@ void sigint_handler(int) {
     g_running.store(false);
 }
 
-int main() {
+int main(int argc, char** argv) {
     std::signal(SIGINT, sigint_handler);
 
     std::cout << "run_test starting. Press Ctrl+C to stop.\n";
 
+    // --lazy：加密段按页惰性解密，退出时打印实际解密页数
+    // --memfd：整段解密到 memfd 后以只读可执行换入（不使用 mprotect RWX）
+    // --shared-cache：经 /dev/shm 中的共享明文缓存映射（多个 run_test 进程共用同一份页）
+    const std::string mode = argc >= 2 ? argv[1] : "";
+    const bool lazy = (mode == "--lazy");
+    if (lazy) {
+        Decryptor::setDecryptMode(Decryptor::MODE_LAZY);
+    } else if (mode == "--memfd") {
+        Decryptor::setDecryptEngine(Decryptor::ENGINE_MEMFD);
+    } else if (mode == "--shared-cache") {
+        Decryptor::setSharedCache("/dev/shm");
+    }
+
     SimpleTestClass tester;
     tester.init();
 
@@ -43,6 +57,10 @@ int main() {
 
     }
 
+    if (lazy) {
+        std::cout << "Lazy pages decrypted: " << Decryptor::lazyPagesDecrypted()
+                  << " / " << Decryptor::lazyPagesTotal() << "\n";
+    }
     std::cout << "run_test exiting.\n";
     return 0;
 }
\ No newline at end of file
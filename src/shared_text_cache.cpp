@@ -0,0 +1,213 @@
+#include "shared_text_cache.h"
+#include "image_locator.h"
+#include "crc32c.h"
+#include "decrypt_log.h"
+#include <cerrno>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <elf.h>
+#include <fcntl.h>
+#include <link.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace {
+
+const char CACHE_MAGIC[8] = {'E', 'N', 'C', 'T', 'X', 'T', 'C', 'H'};
+const uint32_t CACHE_VERSION = 1;
+
+// 条目头部（占文件第一页，其余为零）
+struct CacheHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t crc;               // 明文 CRC32C
+    char image_key[136];        // build-id 十六进制，以 0 结尾
+    uint64_t fingerprint;
+    uint64_t vaddr;             // page_start - load_bias
+    uint64_t page_len;
+};
+
+bool header_matches(const CacheHeader& h, const CacheHeader& expect)
+{
+    return memcmp(h.magic, expect.magic, sizeof(h.magic)) == 0 && h.version == expect.version &&
+           strncmp(h.image_key, expect.image_key, sizeof(h.image_key)) == 0 &&
+           h.fingerprint == expect.fingerprint && h.vaddr == expect.vaddr && h.page_len == expect.page_len;
+}
+
+// /dev/shm 人人可写：只信任自己创建、别人改不了的普通文件
+bool owned_by_us(const struct stat& st)
+{
+    return S_ISREG(st.st_mode) && st.st_uid == geteuid() && (st.st_mode & (S_IWGRP | S_IWOTH)) == 0;
+}
+
+// 打开并校验条目，通过后以 MAP_FIXED 只读可执行映射到 page_start；
+// check_payload 为 false 时只校验头部（本进程刚发布的条目）。目录不允许映射可执行时置 exec_denied
+bool map_entry(const char* path, const CacheHeader& expect, size_t header_size, uintptr_t page_start,
+               bool check_payload, SharedTextCache::VerifyFn verify, void* ctx, bool& exec_denied)
+{
+    const int fd = open(path, O_RDONLY | O_NOFOLLOW | O_CLOEXEC);
+    if (fd < 0) return false;
+
+    const size_t page_len = (size_t)expect.page_len;
+    struct stat st;
+    CacheHeader h;
+    bool ok = fstat(fd, &st) == 0 && owned_by_us(st) && (size_t)st.st_size == header_size + page_len &&
+              pread(fd, &h, sizeof(h), 0) == (ssize_t)sizeof(h) && header_matches(h, expect);
+    if (!ok) {
+        DECRYPT_LOG_ERROR("[SharedTextCache] Ignoring %s: owner, mode, size or header mismatch\n", path);
+        close(fd);
+        return false;
+    }
+
+    if (check_payload) {
+        void* view = mmap(nullptr, page_len, PROT_READ, MAP_SHARED, fd, (off_t)header_size);
+        ok = view != MAP_FAILED && Crc32c::update(0, view, page_len) == h.crc && verify((const uint8_t*)view, ctx);
+        if (view != MAP_FAILED) munmap(view, page_len);
+        if (!ok) {
+            DECRYPT_LOG_ERROR("[SharedTextCache] Ignoring %s: integrity check failed\n", path);
+            close(fd);
+            return false;
+        }
+    }
+
+    // 一次系统调用换入共享明文页，预先建立页表
+    void* p = mmap((void*)page_start, page_len, PROT_READ | PROT_EXEC, MAP_SHARED | MAP_FIXED | MAP_POPULATE, fd,
+                   (off_t)header_size);
+    const int err = errno;
+    close(fd);
+    if (p == MAP_FAILED) {
+        exec_denied = true;
+        DECRYPT_LOG_ERROR("[SharedTextCache] Cannot map %s executable (noexec mount?): %s\n", path, strerror(err));
+        return false;
+    }
+    return true;
+}
+
+// 写临时文件（0600）-> 计算 CRC 写头部 -> 改为 0400 -> rename 发布
+bool publish(const char* path, CacheHeader h, size_t header_size, SharedTextCache::FillFn fill, void* ctx)
+{
+    char tmp[PATH_MAX];
+    if (snprintf(tmp, sizeof(tmp), "%s.XXXXXX", path) >= (int)sizeof(tmp)) return false;
+    const int fd = mkostemp(tmp, O_CLOEXEC);
+    if (fd < 0) {
+        DECRYPT_LOG_ERROR("[SharedTextCache] Cannot create %s: %s\n", tmp, strerror(errno));
+        return false;
+    }
+
+    const size_t page_len = (size_t)h.page_len;
+    bool ok = ftruncate(fd, (off_t)(header_size + page_len)) == 0 && fill(fd, (off_t)header_size, ctx);
+    if (ok) {
+        void* view = mmap(nullptr, page_len, PROT_READ, MAP_SHARED, fd, (off_t)header_size);
+        ok = view != MAP_FAILED;
+        if (ok) {
+            h.crc = Crc32c::update(0, view, page_len);
+            munmap(view, page_len);
+        }
+    }
+    ok = ok && pwrite(fd, &h, sizeof(h), 0) == (ssize_t)sizeof(h) && fchmod(fd, 0400) == 0;
+    const int err = errno;
+    close(fd);
+    if (!ok || rename(tmp, path) != 0) {
+        DECRYPT_LOG_ERROR("[SharedTextCache] Cannot publish %s: %s\n", path, strerror(ok ? errno : err));
+        unlink(tmp);
+        return false;
+    }
+    DECRYPT_LOG_INFO("[SharedTextCache] Published %s (%zu bytes)\n", path, page_len);
+    return true;
+}
+
+} // namespace
+
+bool SharedTextCache::imageKey(const ImageInfo& image, char* out, size_t out_size)
+{
+    static const char gnu[] = "GNU";
+    const uint8_t* id = nullptr;
+    size_t id_len = 0;
+
+    for (uint16_t i = 0; image.phdr && i < image.phnum; i++) {
+        const ElfW(Phdr)& ph = image.phdr[i];
+        if (ph.p_type == PT_DYNAMIC) {
+            // 文本重定位会把装载地址写进代码页，各进程的明文不同，不能共享
+            for (const ElfW(Dyn)* d = (const ElfW(Dyn)*)(image.load_bias + ph.p_vaddr); d->d_tag != DT_NULL; d++) {
+                if (d->d_tag == DT_TEXTREL || (d->d_tag == DT_FLAGS && (d->d_un.d_val & DF_TEXTREL))) {
+                    DECRYPT_LOG_DEBUG("[SharedTextCache] Image has text relocations\n");
+                    return false;
+                }
+            }
+        } else if (ph.p_type == PT_NOTE && !id) {
+            const size_t align = ph.p_align >= 8 ? 8 : 4;
+            const uint8_t* p = (const uint8_t*)(image.load_bias + ph.p_vaddr);
+            const uint8_t* end = p + ph.p_memsz;
+            while (p + sizeof(ElfW(Nhdr)) <= end) {
+                const ElfW(Nhdr)* nhdr = (const ElfW(Nhdr)*)p;
+                const size_t desc_off = (sizeof(ElfW(Nhdr)) + nhdr->n_namesz + align - 1) & ~(align - 1);
+                const size_t note_size = (desc_off + nhdr->n_descsz + align - 1) & ~(align - 1);
+                if (p + desc_off + nhdr->n_descsz > end) break;
+                if (nhdr->n_type == NT_GNU_BUILD_ID && nhdr->n_namesz == sizeof(gnu) &&
+                    memcmp(p + sizeof(ElfW(Nhdr)), gnu, sizeof(gnu)) == 0) {
+                    id = p + desc_off;
+                    id_len = nhdr->n_descsz;
+                    break;
+                }
+                p += note_size;
+            }
+        }
+    }
+
+    if (!id || id_len == 0 || id_len * 2 + 1 > out_size) return false;
+    for (size_t i = 0; i < id_len; i++) {
+        snprintf(out + 2 * i, 3, "%02x", id[i]);
+    }
+    return true;
+}
+
+SharedTextCache::Result SharedTextCache::attach(const char* dir, const char* image_key, uint64_t fingerprint,
+                                                const ImageInfo& image, uintptr_t page_start, size_t page_len,
+                                                FillFn fill, VerifyFn verify, void* ctx)
+{
+    const size_t header_size = (size_t)sysconf(_SC_PAGESIZE);
+    CacheHeader expect;
+    memset(&expect, 0, sizeof(expect));
+    memcpy(expect.magic, CACHE_MAGIC, sizeof(expect.magic));
+    expect.version = CACHE_VERSION;
+    if (strlen(image_key) >= sizeof(expect.image_key)) return CACHE_UNAVAILABLE;
+    strcpy(expect.image_key, image_key);
+    expect.fingerprint = fingerprint;
+    expect.vaddr = page_start - image.load_bias;
+    expect.page_len = page_len;
+
+    char path[PATH_MAX];
+    char lock_path[PATH_MAX];
+    if (snprintf(path, sizeof(path), "%s/encrypt_text-%u-%s-%016llx", dir, (unsigned)geteuid(), image_key,
+                 (unsigned long long)fingerprint) >= (int)sizeof(path) ||
+        snprintf(lock_path, sizeof(lock_path), "%s.lock", path) >= (int)sizeof(lock_path)) {
+        return CACHE_UNAVAILABLE;
+    }
+
+    bool exec_denied = false;
+    if (map_entry(path, expect, header_size, page_start, true, verify, ctx, exec_denied)) return CACHE_HIT;
+    if (exec_denied) return CACHE_UNAVAILABLE;
+
+    // 未命中：持锁生成；锁文件不删除（删除会让等锁者与新来者锁到不同的文件上）
+    const int lock_fd = open(lock_path, O_RDWR | O_CREAT | O_NOFOLLOW | O_CLOEXEC, 0600);
+    struct stat st;
+    if (lock_fd < 0 || fstat(lock_fd, &st) != 0 || !owned_by_us(st) || flock(lock_fd, LOCK_EX) != 0) {
+        DECRYPT_LOG_ERROR("[SharedTextCache] Cannot lock %s: %s\n", lock_path, strerror(errno));
+        if (lock_fd >= 0) close(lock_fd);
+        return CACHE_UNAVAILABLE;
+    }
+
+    Result result = CACHE_UNAVAILABLE;
+    if (map_entry(path, expect, header_size, page_start, true, verify, ctx, exec_denied)) {
+        result = CACHE_HIT;     // 等锁期间已由其他进程发布
+    } else if (!exec_denied && publish(path, expect, header_size, fill, ctx) &&
+               map_entry(path, expect, header_size, page_start, false, verify, ctx, exec_denied)) {
+        result = CACHE_PUBLISHED;
+    }
+    close(lock_fd);
+    return result;
+}
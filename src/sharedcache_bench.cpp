@@ -0,0 +1,223 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+// ===================== 跨进程共享明文缓存基准 =====================
+// 同时启动 N 个被测镜像进程（sharedcache_bench_image，16 MB 加密载荷），三种场景：
+//   private  不用缓存，每个进程各自原地解密（原行为）
+//   cold     空缓存目录，N 个进程并发首次启动：一个生成并发布，其余等锁后命中
+//   warm     同一目录再启动 N 个进程（模拟重启）：全部命中
+// 所有进程解密并逐页读完载荷后保持存活，由本程序读取各自 /proc/<pid>/smaps 中 .encrypt_text 区间的
+// Rss / Pss / Private_Dirty 以及 smaps_rollup 的整个进程 Pss，全部读完后再让它们退出。
+// 报告每进程平均值、decrypt() 耗时中位数/最大值，以及命中/发布/不可用的进程数。
+// 用法：sharedcache_bench [procs] [cache_dir]（默认 8 个进程，在 /dev/shm 下建临时目录并在结束时删除）
+
+#ifndef SHAREDCACHE_BENCH_IMAGE
+#define SHAREDCACHE_BENCH_IMAGE "sharedcache_bench_image"
+#endif
+
+struct Child {
+    pid_t pid;
+    int result_fd;
+    int hold_fd;        // 关闭后子进程退出
+};
+
+struct Sample {
+    unsigned long long decrypt_ns;
+    unsigned cache_result;
+    unsigned long long text_rss_kb;
+    unsigned long long text_pss_kb;
+    unsigned long long text_dirty_kb;
+    unsigned long long process_pss_kb;
+};
+
+static bool spawn(const char* image, const char* arg, Child& c)
+{
+    // O_CLOEXEC：后启动的兄弟进程不能继承前面进程的 hold 写端，否则关闭后对方读不到 EOF
+    int result[2], hold[2];
+    if (pipe2(result, O_CLOEXEC) != 0) return false;
+    if (pipe2(hold, O_CLOEXEC) != 0) {
+        close(result[0]);
+        close(result[1]);
+        return false;
+    }
+    fflush(stdout);
+    c.pid = fork();
+    if (c.pid == 0) {
+        close(result[0]);
+        close(hold[1]);
+        if (dup2(hold[0], STDIN_FILENO) < 0 || dup2(result[1], 3) < 0) _exit(127);
+        const int devnull = open("/dev/null", O_WRONLY);
+        if (devnull >= 0) dup2(devnull, STDOUT_FILENO);
+        execl(image, image, arg, (char*)nullptr);
+        _exit(127);
+    }
+    close(result[1]);
+    close(hold[0]);
+    c.result_fd = result[0];
+    c.hold_fd = hold[1];
+    return c.pid > 0;
+}
+
+// 累加 smaps 中与 [start, end) 相交的 VMA 的字段（kB）
+static bool text_usage(pid_t pid, unsigned long start, unsigned long end, Sample& s)
+{
+    char path[64];
+    snprintf(path, sizeof(path), "/proc/%d/smaps", (int)pid);
+    FILE* f = fopen(path, "r");
+    if (!f) return false;
+    char line[512];
+    bool in_range = false;
+    s.text_rss_kb = s.text_pss_kb = s.text_dirty_kb = 0;
+    while (fgets(line, sizeof(line), f)) {
+        // VMA 头部行的第一个字段是 "起始-结束"（属性行是 "Name:"）
+        const char* space = strchr(line, ' ');
+        const char* dash = strchr(line, '-');
+        if (dash && space && dash < space) {
+            const unsigned long lo = strtoul(line, nullptr, 16);
+            const unsigned long hi = strtoul(dash + 1, nullptr, 16);
+            in_range = lo < end && hi > start;
+            continue;
+        }
+        if (!in_range) continue;
+        unsigned long long kb = 0;
+        if (sscanf(line, "Rss: %llu kB", &kb) == 1) s.text_rss_kb += kb;
+        else if (sscanf(line, "Pss: %llu kB", &kb) == 1) s.text_pss_kb += kb;
+        else if (sscanf(line, "Private_Dirty: %llu kB", &kb) == 1) s.text_dirty_kb += kb;
+    }
+    fclose(f);
+    return true;
+}
+
+static bool process_pss(pid_t pid, unsigned long long& kb)
+{
+    char path[64];
+    snprintf(path, sizeof(path), "/proc/%d/smaps_rollup", (int)pid);
+    FILE* f = fopen(path, "r");
+    if (!f) return false;
+    char line[256];
+    bool found = false;
+    while (!found && fgets(line, sizeof(line), f)) {
+        found = sscanf(line, "Pss: %llu kB", &kb) == 1;
+    }
+    fclose(f);
+    return found;
+}
+
+// 并发启动 procs 个进程，全部就绪后测量，再让它们退出
+static bool run_scenario(const char* name, const char* arg, size_t procs)
+{
+    std::vector<Child> children(procs);
+    for (size_t i = 0; i < procs; i++) {
+        if (!spawn(SHAREDCACHE_BENCH_IMAGE, arg, children[i])) {
+            fprintf(stderr, "[sharedcache_bench] fork failed\n");
+            return false;
+        }
+    }
+
+    std::vector<Sample> samples(procs);
+    std::vector<unsigned long> starts(procs), sizes(procs);
+    bool ok = true;
+    for (size_t i = 0; i < procs; i++) {
+        char line[256];
+        size_t len = 0;
+        ssize_t n;
+        while (len < sizeof(line) - 1 && (n = read(children[i].result_fd, line + len, sizeof(line) - 1 - len)) > 0) {
+            len += (size_t)n;
+        }
+        line[len] = '\0';
+        close(children[i].result_fd);
+        int child_ok = 0;
+        Sample& s = samples[i];
+        if (sscanf(line, "%d,%llu,%u,%lu,%lu", &child_ok, &s.decrypt_ns, &s.cache_result, &starts[i], &sizes[i]) != 5 ||
+            child_ok != 1) {
+            fprintf(stderr, "[sharedcache_bench] %s: process %zu failed (decrypt or payload check)\n", name, i);
+            ok = false;
+        }
+    }
+    // 全部进程都映射完才测量：先测的进程不会因为其余进程尚未映射而把共享页算成私有
+    for (size_t i = 0; ok && i < procs; i++) {
+        if (!text_usage(children[i].pid, starts[i], starts[i] + sizes[i], samples[i]) ||
+            !process_pss(children[i].pid, samples[i].process_pss_kb)) {
+            fprintf(stderr, "[sharedcache_bench] %s: cannot read smaps of process %zu\n", name, i);
+            ok = false;
+        }
+    }
+    // 全部测完后才放行
+    for (Child& c : children) {
+        close(c.hold_fd);
+        int status = 0;
+        waitpid(c.pid, &status, 0);
+        ok = ok && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+    }
+    if (!ok) return false;
+
+    size_t results[3] = {0, 0, 0};
+    std::vector<unsigned long long> decrypt_ns;
+    unsigned long long rss = 0, pss = 0, dirty = 0, process = 0;
+    for (const Sample& s : samples) {
+        results[s.cache_result < 3 ? s.cache_result : 0]++;
+        decrypt_ns.push_back(s.decrypt_ns);
+        rss += s.text_rss_kb;
+        pss += s.text_pss_kb;
+        dirty += s.text_dirty_kb;
+        process += s.process_pss_kb;
+    }
+    std::sort(decrypt_ns.begin(), decrypt_ns.end());
+    printf("%-8s %4zu/%-4zu/%-4zu %11.3f %11.3f %10llu %10llu %12llu %14llu %12llu\n", name, results[1], results[2],
+           results[0], decrypt_ns[(procs - 1) / 2] / 1e6, decrypt_ns.back() / 1e6, rss / procs, pss / procs,
+           dirty / procs, process / procs, pss);
+    return true;
+}
+
+// 删除本程序建的临时缓存目录（只含缓存条目与锁文件）
+static void remove_dir(const std::string& dir)
+{
+    DIR* d = opendir(dir.c_str());
+    if (!d) return;
+    while (struct dirent* e = readdir(d)) {
+        if (strcmp(e->d_name, ".") != 0 && strcmp(e->d_name, "..") != 0) {
+            unlink((dir + "/" + e->d_name).c_str());
+        }
+    }
+    closedir(d);
+    rmdir(dir.c_str());
+}
+
+int main(int argc, char* argv[])
+{
+    const size_t procs = argc > 1 ? strtoul(argv[1], nullptr, 10) : 8;
+    if (procs == 0) {
+        fprintf(stderr, "usage: %s [procs] [cache_dir]\n", argv[0]);
+        return 1;
+    }
+    std::string dir;
+    bool temp_dir = false;
+    if (argc > 2) {
+        dir = argv[2];
+    } else {
+        char tmpl[] = "/dev/shm/sharedcache_bench.XXXXXX";
+        if (!mkdtemp(tmpl)) {
+            perror("[sharedcache_bench] mkdtemp");
+            return 1;
+        }
+        dir = tmpl;
+        temp_dir = true;
+    }
+
+    printf("%zu concurrent processes, cache dir %s\n", procs, dir.c_str());
+    printf("%-8s %-14s %11s %11s %10s %10s %12s %14s %12s\n", "scenario", "hit/pub/none", "decrypt(ms)",
+           "max(ms)", "text_rss", "text_pss", "text_dirty", "process_pss", "sum_text_pss");
+    const bool ok = run_scenario("private", "-", procs) && run_scenario("cold", dir.c_str(), procs) &&
+                    run_scenario("warm", dir.c_str(), procs);
+    printf("(text_* and process_pss are per-process means in kB)\n");
+    if (temp_dir) remove_dir(dir);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,228 @@
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ptrace.h>
+#include <sys/syscall.h>
+#include <sys/user.h>
+#include <sys/wait.h>
+
+// ===================== Decryptor::decrypt() 系统调用计数 =====================
+// 在 ptrace 下运行 decrypt_bench 的被测镜像（.encrypt_text 4 KB ~ 256 MB，mprotect / memfd 两种引擎），
+// 只统计镜像在 decrypt() 前后发出的两个标记调用（getpid，第一个参数为魔数）之间、所有线程进入的系统调用，
+// 打印每个镜像的调用直方图。预算是与 .encrypt_text 大小无关的常数（多线程解密时每个工作线程另加固定额度），
+// 任一镜像超出预算即以非零状态退出，用于防止解密路径的系统调用数回退。
+// 用法：syscall_bench [max_mb]（默认全部大小）
+
+#ifndef DECRYPT_BENCH_IMAGE_DIR
+#define DECRYPT_BENCH_IMAGE_DIR "."
+#endif
+#ifndef DECRYPT_BENCH_SIZES
+#define DECRYPT_BENCH_SIZES "4096"
+#endif
+
+// 与 decrypt_bench_image.cpp 中的标记一致
+static const unsigned long long SYSCALL_MARK_BEGIN = 0x444543525950540aULL;
+static const unsigned long long SYSCALL_MARK_END = 0x444543525950540bULL;
+
+struct EngineBudget {
+    const char* engine;
+    size_t budget;              // 单线程解密时的总数
+    size_t per_worker;          // 每个额外工作线程（clone3、栈、信号掩码、rseq、退出与 join，实测约 15）
+};
+
+// 按当前实现的实测值设定：mprotect 引擎为 getrusage x2、madvise x2（预读 + 写时复制）、mprotect x2，
+// 超过并行阈值时首次查询可用 CPU 数再加一次 sched_getaffinity；memfd 引擎把两次 mprotect 换成
+// memfd_create、ftruncate、pwrite（复制密文）、mmap/munmap（就地解密）、fcntl（封印）、mmap（换入）、close，只预读一次
+static const EngineBudget BUDGETS[] = {
+    {"mprotect", 7, 16},
+    {"memfd", 12, 16},
+};
+
+struct Trace {
+    bool ok = false;
+    size_t total = 0;
+    size_t workers = 0;             // 计数区间内 clone 出的线程数
+    std::map<std::string, size_t> calls;
+};
+
+static const char* syscall_name(long nr)
+{
+    switch (nr) {
+    case SYS_read: return "read";
+    case SYS_write: return "write";
+    case SYS_openat: return "openat";
+    case SYS_close: return "close";
+    case SYS_fstat: return "fstat";
+    case SYS_newfstatat: return "newfstatat";
+    case SYS_statx: return "statx";
+    case SYS_lseek: return "lseek";
+    case SYS_pread64: return "pread64";
+    case SYS_pwrite64: return "pwrite64";
+    case SYS_mmap: return "mmap";
+    case SYS_munmap: return "munmap";
+    case SYS_mprotect: return "mprotect";
+    case SYS_madvise: return "madvise";
+    case SYS_brk: return "brk";
+    case SYS_getrusage: return "getrusage";
+    case SYS_clock_gettime: return "clock_gettime";
+    case SYS_futex: return "futex";
+    case SYS_clone: return "clone";
+    case SYS_clone3: return "clone3";
+    case SYS_exit: return "exit";
+    case SYS_set_robust_list: return "set_robust_list";
+    case SYS_rseq: return "rseq";
+    case SYS_rt_sigprocmask: return "rt_sigprocmask";
+    case SYS_rt_sigaction: return "rt_sigaction";
+    case SYS_sched_getaffinity: return "sched_getaffinity";
+    case SYS_memfd_create: return "memfd_create";
+    case SYS_ftruncate: return "ftruncate";
+    case SYS_fcntl: return "fcntl";
+    case SYS_membarrier: return "membarrier";
+    case SYS_getpid: return "getpid";
+    case SYS_gettid: return "gettid";
+    case SYS_ptrace: return "ptrace";
+    default: return nullptr;
+    }
+}
+
+// fork + PTRACE_TRACEME 运行镜像，统计标记之间的系统调用
+static Trace trace_image(const std::string& path, const char* engine)
+{
+    Trace tr;
+    fflush(stdout);
+    const pid_t pid = fork();
+    if (pid == 0) {
+        const int devnull = open("/dev/null", O_WRONLY);
+        if (devnull >= 0) {
+            dup2(devnull, STDOUT_FILENO);
+            dup2(devnull, 3);
+        }
+        if (ptrace(PTRACE_TRACEME, 0, nullptr, nullptr) != 0) _exit(126);
+        raise(SIGSTOP);
+        execl(path.c_str(), path.c_str(), engine, (char*)nullptr);
+        _exit(127);
+    }
+    if (pid < 0) return tr;
+
+    int status = 0;
+    if (waitpid(pid, &status, 0) != pid || !WIFSTOPPED(status)) return tr;
+    ptrace(PTRACE_SETOPTIONS, pid, nullptr,
+           (void*)(long)(PTRACE_O_TRACESYSGOOD | PTRACE_O_TRACECLONE | PTRACE_O_TRACEEXEC | PTRACE_O_EXITKILL));
+    ptrace(PTRACE_SYSCALL, pid, nullptr, nullptr);
+
+    std::set<pid_t> in_syscall;     // 处于系统调用入口与出口之间的线程
+    bool counting = false;
+    bool seen_begin = false, seen_end = false;
+    int exit_code = -1;
+    for (;;) {
+        const pid_t tid = waitpid(-1, &status, __WALL);
+        if (tid < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        if (WIFEXITED(status) || WIFSIGNALED(status)) {
+            in_syscall.erase(tid);
+            if (tid == pid) {
+                exit_code = WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+                break;
+            }
+            continue;
+        }
+        if (!WIFSTOPPED(status)) continue;
+
+        int deliver = 0;
+        const int sig = WSTOPSIG(status);
+        const int event = status >> 16;
+        if (sig == (SIGTRAP | 0x80)) {
+            if (in_syscall.erase(tid) == 0) {
+                in_syscall.insert(tid);
+                struct user_regs_struct regs;
+                if (ptrace(PTRACE_GETREGS, tid, nullptr, &regs) == 0) {
+                    const long nr = (long)regs.orig_rax;
+                    if (nr == SYS_getpid && regs.rdi == SYSCALL_MARK_BEGIN) {
+                        counting = seen_begin = true;
+                    } else if (nr == SYS_getpid && regs.rdi == SYSCALL_MARK_END) {
+                        counting = false;
+                        seen_end = true;
+                    } else if (counting) {
+                        const char* name = syscall_name(nr);
+                        tr.calls[name ? name : "syscall_" + std::to_string(nr)]++;
+                        tr.total++;
+                    }
+                }
+            }
+        } else if (event == PTRACE_EVENT_CLONE) {
+            if (counting) tr.workers++;
+        } else if (event != 0) {
+            // exec 等其他事件停止
+        } else if (sig == SIGSTOP) {
+            // 新线程的初始停止
+        } else {
+            deliver = sig;
+        }
+        ptrace(PTRACE_SYSCALL, tid, nullptr, (void*)(long)deliver);
+    }
+    tr.ok = exit_code == 0 && seen_begin && seen_end;
+    return tr;
+}
+
+static std::string format_calls(const Trace& tr)
+{
+    std::vector<std::pair<size_t, std::string>> sorted;
+    for (const auto& c : tr.calls) sorted.push_back(std::make_pair(c.second, c.first));
+    std::sort(sorted.begin(), sorted.end(), [](const std::pair<size_t, std::string>& a,
+                                               const std::pair<size_t, std::string>& b) {
+        return a.first != b.first ? a.first > b.first : a.second < b.second;
+    });
+    std::string out;
+    for (const auto& c : sorted) {
+        if (!out.empty()) out += ' ';
+        out += c.second + "=" + std::to_string(c.first);
+    }
+    return out.empty() ? "-" : out;
+}
+
+int main(int argc, char* argv[])
+{
+    const unsigned long long max_mb = argc > 1 ? strtoull(argv[1], nullptr, 10) : 0;
+
+    std::vector<size_t> sizes;
+    const char* p = DECRYPT_BENCH_SIZES;
+    while (*p) {
+        char* end = nullptr;
+        const size_t size = strtoull(p, &end, 10);
+        if (end == p) break;
+        if (max_mb == 0 || size <= (size_t)(max_mb << 20)) sizes.push_back(size);
+        p = *end ? end + 1 : end;
+    }
+
+    printf("%-9s %10s %6s %8s %7s  %s\n", "engine", "size", "calls", "workers", "budget", "syscalls");
+    bool ok = true;
+    for (const EngineBudget& b : BUDGETS) {
+        for (size_t size : sizes) {
+            const std::string path = std::string(DECRYPT_BENCH_IMAGE_DIR) + "/decrypt_bench_image_" +
+                                     std::to_string(size);
+            const Trace tr = trace_image(path, b.engine);
+            if (!tr.ok) {
+                fprintf(stderr, "[syscall_bench] %s %zu: image failed or markers not seen\n", b.engine, size);
+                ok = false;
+                continue;
+            }
+            const size_t budget = b.budget + b.per_worker * tr.workers;
+            const bool within = tr.total <= budget;
+            printf("%-9s %10zu %6zu %8zu %7zu  %s%s\n", b.engine, size, tr.total, tr.workers, budget,
+                   format_calls(tr).c_str(), within ? "" : "  <-- over budget");
+            ok = ok && within;
+        }
+    }
+    return ok ? 0 : 1;
+}
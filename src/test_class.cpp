@@ -20,6 +20,12 @@ void SimpleTestClass::init() {
     
     std::cout << "[SimpleTestClass] Decryptor initialization result: " << (result ? "SUCCESS" : "FAILED") << std::endl;
     std::cout << "[SimpleTestClass] Is decrypted: " << (Decryptor::isDecrypted() ? "YES" : "NO") << std::endl;
+
+    // 解密统计（Release 下 Decryptor 不输出日志，由调用方决定如何导出）
+    const Decryptor::Stats stats = Decryptor::stats();
+    std::cout << "[SimpleTestClass] Decrypt stats: " << stats.total_ns << " ns, "
+              << stats.bytes_decrypted << " bytes, " << stats.pages_touched << " pages, "
+              << stats.mprotect_calls << " mprotect, " << stats.minor_faults << " minor faults" << std::endl;
 }
 
 // ===================== 普通方法实现 =====================
@@ -0,0 +1,119 @@
+#include "xor_kernel.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <chrono>
+#include <string>
+#include <vector>
+
+// ===================== 交叉校验：所有指令集 × 对齐 × 长度 × 密钥长度 × 相位 =====================
+static bool cross_check()
+{
+    static const size_t key_lens[] = {1, 2, 3, 4, 5, 7, 8, 16, 17, 32, 64, 100, 256, 300};
+    static const size_t key_offsets[] = {0, 1, 5, 63};
+    const size_t max_len = 320;
+    const size_t max_align = 64;
+
+    uint8_t key[512];
+    for (size_t i = 0; i < sizeof(key); i++) {
+        key[i] = (uint8_t)(i * 131 + 7);
+    }
+
+    std::vector<uint8_t> src(max_len + max_align);
+    for (size_t i = 0; i < src.size(); i++) {
+        src[i] = (uint8_t)(i * 29 + 3);
+    }
+
+    alignas(64) uint8_t ref[max_len + max_align + 64];
+    alignas(64) uint8_t out[max_len + max_align + 64];
+    size_t cases = 0;
+
+    for (int isa = XOR_ISA_SCALAR; isa < XOR_ISA_COUNT; isa++) {
+        if (!XorKernel::isaSupported((XorIsa)isa)) continue;
+        for (size_t key_len : key_lens) {
+            for (size_t key_off : key_offsets) {
+                for (size_t align = 0; align < max_align; align++) {
+                    for (size_t len = 0; len <= max_len; len++) {
+                        memcpy(ref, src.data(), max_len + max_align);
+                        memcpy(out, src.data(), max_len + max_align);
+                        XorKernel::scalarReference(ref + align, len, key, key_len, key_off);
+                        XorKernel::applyWith((XorIsa)isa, out + align, len, key, key_len, key_off);
+                        if (memcmp(ref, out, max_len + max_align) != 0) {
+                            fprintf(stderr, "[xor_bench] MISMATCH isa=%s key_len=%zu key_off=%zu align=%zu len=%zu\n",
+                                    XorKernel::isaName((XorIsa)isa), key_len, key_off, align, len);
+                            return false;
+                        }
+                        cases++;
+                    }
+                }
+            }
+        }
+    }
+
+    printf("[xor_bench] Cross-check passed: %zu cases\n", cases);
+    return true;
+}
+
+// ===================== 吞吐量测试：4KB ~ max_size =====================
+static double measure_gbps(XorIsa isa, uint8_t* buf, size_t size, const uint8_t* key, size_t key_len)
+{
+    // 每个尺寸至少处理约1GB数据，保证计时稳定
+    const size_t target_bytes = (size_t)1 << 30;
+    size_t iters = target_bytes / size;
+    if (iters == 0) iters = 1;
+
+    XorKernel::applyWith(isa, buf, size, key, key_len);  // 预热
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iters; i++) {
+        XorKernel::applyWith(isa, buf, size, key, key_len);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+
+    double sec = std::chrono::duration<double>(t1 - t0).count();
+    return sec > 0 ? (double)size * iters / sec / 1e9 : 0.0;
+}
+
+int main(int argc, char** argv)
+{
+    size_t max_size = (size_t)256 << 20;
+    if (argc >= 2) {
+        max_size = (size_t)strtoull(argv[1], nullptr, 10) << 20;  // 单位MB
+        if (max_size < 4096) max_size = 4096;
+    }
+
+    printf("[xor_bench] Detected ISA: %s\n", XorKernel::isaName(XorKernel::activeIsa()));
+    if (!cross_check()) {
+        return 1;
+    }
+
+    static const uint8_t key[] = {0x12, 0x34, 0x56, 0x78, 0x90, 0xAB, 0xCD, 0xEF};
+    uint8_t* buf = (uint8_t*)aligned_alloc(64, max_size);
+    if (!buf) {
+        fprintf(stderr, "[xor_bench] Alloc %zu bytes failed\n", max_size);
+        return 1;
+    }
+    memset(buf, 0x5A, max_size);
+
+    printf("\n%-12s", "size");
+    for (int isa = XOR_ISA_SCALAR; isa < XOR_ISA_COUNT; isa++) {
+        if (XorKernel::isaSupported((XorIsa)isa)) printf("%12s", XorKernel::isaName((XorIsa)isa));
+    }
+    printf("   (GB/s, 8-byte key)\n");
+
+    for (size_t size = 4096; size <= max_size; size *= 4) {
+        if (size >= (1 << 20)) {
+            printf("%-12s", (std::to_string(size >> 20) + "MB").c_str());
+        } else {
+            printf("%-12s", (std::to_string(size >> 10) + "KB").c_str());
+        }
+        for (int isa = XOR_ISA_SCALAR; isa < XOR_ISA_COUNT; isa++) {
+            if (!XorKernel::isaSupported((XorIsa)isa)) continue;
+            printf("%12.2f", measure_gbps((XorIsa)isa, buf, size, key, sizeof(key)));
+        }
+        printf("\n");
+    }
+
+    free(buf);
+    return 0;
+}
@@ -0,0 +1,294 @@
+#include "xor_kernel.h"
+#include <cpuid.h>
+#include <atomic>
+#include <immintrin.h>
+
+// ===================== 内部工具函数 =====================
+namespace {
+
+// 构造扩展密钥流：ext[j] = key[(key_offset + j) % key_len]，长度 key_len + 向量宽度
+// 相位为 ph 的向量密钥 = loadu(ext + ph)，循环内不再需要取模
+// （调用方把 ext 清零：编译器看不出读取范围 ph < key_len 总在已写入的部分内）
+static inline void build_ext_key(uint8_t* ext, size_t ext_len, const uint8_t* key, size_t key_len, size_t key_offset)
+{
+    size_t k = key_offset % key_len;
+    for (size_t j = 0; j < ext_len; j++) {
+        ext[j] = key[k];
+        if (++k == key_len) k = 0;
+    }
+}
+
+// 标量处理头/尾：返回处理后的密钥相位
+static inline size_t scalar_run(uint8_t* data, size_t len, const uint8_t* ext, size_t key_len, size_t ph)
+{
+    for (size_t i = 0; i < len; i++) {
+        data[i] ^= ext[ph];
+        if (++ph == key_len) ph = 0;
+    }
+    return ph;
+}
+
+static inline size_t advance_phase(size_t ph, size_t step, size_t key_len)
+{
+    ph += step;
+    return ph >= key_len ? ph - key_len : ph;
+}
+
+// 标量内核：递增索引代替取模
+static void xor_scalar(uint8_t* data, size_t len, const uint8_t* key, size_t key_len, size_t key_offset)
+{
+    size_t k = key_offset % key_len;
+    for (size_t i = 0; i < len; i++) {
+        data[i] ^= key[k];
+        if (++k == key_len) k = 0;
+    }
+}
+
+// ===================== SSE2 内核（16字节） =====================
+__attribute__((target("sse2")))
+static void xor_sse2(uint8_t* data, size_t len, const uint8_t* key, size_t key_len, size_t key_offset)
+{
+    const size_t W = 16;
+    alignas(64) uint8_t ext[XOR_MAX_SIMD_KEY_LEN + 64] = {};
+    build_ext_key(ext, key_len + W, key, key_len, key_offset);
+
+    // 非对齐头部：标量处理到16字节对齐
+    size_t head = (W - ((uintptr_t)data & (W - 1))) & (W - 1);
+    if (head > len) head = len;
+    size_t ph = scalar_run(data, head, ext, key_len, 0);
+    data += head;
+    len -= head;
+
+    const size_t step = W % key_len;
+    if (step == 0) {
+        // 密钥长度整除向量宽度：密钥只加载一次
+        const __m128i k = _mm_loadu_si128((const __m128i*)(ext + ph));
+        for (; len >= 4 * W; data += 4 * W, len -= 4 * W) {
+            __m128i* p = (__m128i*)data;
+            _mm_store_si128(p + 0, _mm_xor_si128(_mm_load_si128(p + 0), k));
+            _mm_store_si128(p + 1, _mm_xor_si128(_mm_load_si128(p + 1), k));
+            _mm_store_si128(p + 2, _mm_xor_si128(_mm_load_si128(p + 2), k));
+            _mm_store_si128(p + 3, _mm_xor_si128(_mm_load_si128(p + 3), k));
+        }
+        for (; len >= W; data += W, len -= W) {
+            _mm_store_si128((__m128i*)data, _mm_xor_si128(_mm_load_si128((const __m128i*)data), k));
+        }
+    } else {
+        for (; len >= W; data += W, len -= W) {
+            const __m128i k = _mm_loadu_si128((const __m128i*)(ext + ph));
+            _mm_store_si128((__m128i*)data, _mm_xor_si128(_mm_load_si128((const __m128i*)data), k));
+            ph = advance_phase(ph, step, key_len);
+        }
+    }
+
+    scalar_run(data, len, ext, key_len, ph);
+}
+
+// ===================== AVX2 内核（32字节） =====================
+__attribute__((target("avx2")))
+static void xor_avx2(uint8_t* data, size_t len, const uint8_t* key, size_t key_len, size_t key_offset)
+{
+    const size_t W = 32;
+    alignas(64) uint8_t ext[XOR_MAX_SIMD_KEY_LEN + 64] = {};
+    build_ext_key(ext, key_len + W, key, key_len, key_offset);
+
+    size_t head = (W - ((uintptr_t)data & (W - 1))) & (W - 1);
+    if (head > len) head = len;
+    size_t ph = scalar_run(data, head, ext, key_len, 0);
+    data += head;
+    len -= head;
+
+    const size_t step = W % key_len;
+    if (step == 0) {
+        const __m256i k = _mm256_loadu_si256((const __m256i*)(ext + ph));
+        for (; len >= 4 * W; data += 4 * W, len -= 4 * W) {
+            __m256i* p = (__m256i*)data;
+            _mm256_store_si256(p + 0, _mm256_xor_si256(_mm256_load_si256(p + 0), k));
+            _mm256_store_si256(p + 1, _mm256_xor_si256(_mm256_load_si256(p + 1), k));
+            _mm256_store_si256(p + 2, _mm256_xor_si256(_mm256_load_si256(p + 2), k));
+            _mm256_store_si256(p + 3, _mm256_xor_si256(_mm256_load_si256(p + 3), k));
+        }
+        for (; len >= W; data += W, len -= W) {
+            _mm256_store_si256((__m256i*)data, _mm256_xor_si256(_mm256_load_si256((const __m256i*)data), k));
+        }
+    } else {
+        for (; len >= W; data += W, len -= W) {
+            const __m256i k = _mm256_loadu_si256((const __m256i*)(ext + ph));
+            _mm256_store_si256((__m256i*)data, _mm256_xor_si256(_mm256_load_si256((const __m256i*)data), k));
+            ph = advance_phase(ph, step, key_len);
+        }
+    }
+
+    scalar_run(data, len, ext, key_len, ph);
+    _mm256_zeroupper();
+}
+
+// ===================== AVX-512 内核（64字节，头尾用掩码） =====================
+__attribute__((target("avx512f,avx512bw")))
+static void xor_avx512(uint8_t* data, size_t len, const uint8_t* key, size_t key_len, size_t key_offset)
+{
+    const size_t W = 64;
+    alignas(64) uint8_t ext[XOR_MAX_SIMD_KEY_LEN + 64] = {};
+    build_ext_key(ext, key_len + W, key, key_len, key_offset);
+
+    // 非对齐头部：一次掩码读写
+    size_t ph = 0;
+    size_t head = (W - ((uintptr_t)data & (W - 1))) & (W - 1);
+    if (head > len) head = len;
+    if (head) {
+        const __mmask64 m = (__mmask64)((1ULL << head) - 1);
+        const __m512i k = _mm512_loadu_si512((const void*)ext);
+        __m512i v = _mm512_maskz_loadu_epi8(m, data);
+        _mm512_mask_storeu_epi8(data, m, _mm512_xor_si512(v, k));
+        ph = head % key_len;
+        data += head;
+        len -= head;
+    }
+
+    const size_t step = W % key_len;
+    if (step == 0) {
+        const __m512i k = _mm512_loadu_si512((const void*)(ext + ph));
+        for (; len >= 4 * W; data += 4 * W, len -= 4 * W) {
+            __m512i* p = (__m512i*)data;
+            _mm512_store_si512(p + 0, _mm512_xor_si512(_mm512_load_si512(p + 0), k));
+            _mm512_store_si512(p + 1, _mm512_xor_si512(_mm512_load_si512(p + 1), k));
+            _mm512_store_si512(p + 2, _mm512_xor_si512(_mm512_load_si512(p + 2), k));
+            _mm512_store_si512(p + 3, _mm512_xor_si512(_mm512_load_si512(p + 3), k));
+        }
+        for (; len >= W; data += W, len -= W) {
+            _mm512_store_si512((void*)data, _mm512_xor_si512(_mm512_load_si512((const void*)data), k));
+        }
+    } else {
+        for (; len >= W; data += W, len -= W) {
+            const __m512i k = _mm512_loadu_si512((const void*)(ext + ph));
+            _mm512_store_si512((void*)data, _mm512_xor_si512(_mm512_load_si512((const void*)data), k));
+            ph = advance_phase(ph, step, key_len);
+        }
+    }
+
+    // 尾部：一次掩码读写
+    if (len) {
+        const __mmask64 m = (__mmask64)((1ULL << len) - 1);
+        const __m512i k = _mm512_loadu_si512((const void*)(ext + ph));
+        __m512i v = _mm512_maskz_loadu_epi8(m, data);
+        _mm512_mask_storeu_epi8(data, m, _mm512_xor_si512(v, k));
+    }
+    _mm256_zeroupper();
+}
+
+static inline uint64_t read_xcr0()
+{
+    uint32_t lo = 0, hi = 0;
+    __asm__ __volatile__("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+    return ((uint64_t)hi << 32) | lo;
+}
+
+} // namespace
+
+// 运行时分发的内核，首次 apply() 时设置
+static std::atomic<XorKernel::KernelFn> g_kernel(nullptr);
+
+// ===================== XorKernel 实现 =====================
+XorIsa XorKernel::detectIsa()
+{
+    unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+        return XOR_ISA_SCALAR;
+    }
+
+    XorIsa best = (edx & bit_SSE2) ? XOR_ISA_SSE2 : XOR_ISA_SCALAR;
+
+    // AVX及以上需要操作系统保存YMM/ZMM状态（OSXSAVE + XCR0）
+    if (!(ecx & bit_OSXSAVE) || !(ecx & bit_AVX)) {
+        return best;
+    }
+    const uint64_t xcr0 = read_xcr0();
+    if ((xcr0 & 0x6) != 0x6) {
+        return best;
+    }
+    if (__get_cpuid_max(0, nullptr) < 7) {
+        return best;
+    }
+
+    __cpuid_count(7, 0, eax, ebx, ecx, edx);
+    if (ebx & bit_AVX2) {
+        best = XOR_ISA_AVX2;
+    }
+    // opmask + ZMM高低半部分都需要OS支持
+    if ((ebx & bit_AVX512F) && (ebx & bit_AVX512BW) && (xcr0 & 0xE6) == 0xE6) {
+        best = XOR_ISA_AVX512;
+    }
+    return best;
+}
+
+XorIsa XorKernel::activeIsa()
+{
+    static const XorIsa isa = detectIsa();
+    return isa;
+}
+
+bool XorKernel::isaSupported(XorIsa isa)
+{
+    return isa >= XOR_ISA_SCALAR && isa <= activeIsa();
+}
+
+const char* XorKernel::isaName(XorIsa isa)
+{
+    switch (isa) {
+        case XOR_ISA_SCALAR: return "scalar";
+        case XOR_ISA_SSE2:   return "sse2";
+        case XOR_ISA_AVX2:   return "avx2";
+        case XOR_ISA_AVX512: return "avx512";
+        default:             return "unknown";
+    }
+}
+
+XorKernel::KernelFn XorKernel::kernelFor(XorIsa isa)
+{
+    switch (isa) {
+        case XOR_ISA_SSE2:   return xor_sse2;
+        case XOR_ISA_AVX2:   return xor_avx2;
+        case XOR_ISA_AVX512: return xor_avx512;
+        default:             return xor_scalar;
+    }
+}
+
+void XorKernel::apply(uint8_t* data, size_t len, const uint8_t* key, size_t key_len, size_t key_offset)
+{
+    if (!data || len == 0 || !key || key_len == 0) return;
+
+    if (len < SMALL_LEN || key_len > XOR_MAX_SIMD_KEY_LEN) {
+        xor_scalar(data, len, key, key_len, key_offset);
+        return;
+    }
+
+    // 不用函数级静态变量：惰性解密在 SIGSEGV 处理函数里调用本函数，__cxa_guard 可能与被打断的线程死锁。
+    // cpuid 无副作用，并发首次调用各自探测、写入相同的值即可
+    KernelFn kernel = g_kernel.load(std::memory_order_relaxed);
+    if (!kernel) {
+        kernel = kernelFor(detectIsa());
+        g_kernel.store(kernel, std::memory_order_relaxed);
+    }
+    kernel(data, len, key, key_len, key_offset);
+}
+
+bool XorKernel::applyWith(XorIsa isa, uint8_t* data, size_t len, const uint8_t* key, size_t key_len, size_t key_offset)
+{
+    if (!isaSupported(isa)) return false;
+    if (!data || len == 0 || !key || key_len == 0) return true;
+
+    if (key_len > XOR_MAX_SIMD_KEY_LEN) {
+        xor_scalar(data, len, key, key_len, key_offset);
+        return true;
+    }
+    kernelFor(isa)(data, len, key, key_len, key_offset);
+    return true;
+}
+
+void XorKernel::scalarReference(uint8_t* data, size_t len, const uint8_t* key, size_t key_len, size_t key_offset)
+{
+    if (!data || len == 0 || !key || key_len == 0) return;
+    for (size_t i = 0; i < len; i++) {
+        data[i] ^= key[(key_offset + i) % key_len];
+    }
+}